@@ -131,6 +131,13 @@ set(FLECSI_ID_FBITS "4" CACHE STRING
 set(FLECSI_COUNTER_TYPE "int32_t" CACHE STRING
   "Select the type that will be used for loop and iterator values")
 
+#------------------------------------------------------------------------------#
+# Add option for kernel threads
+#------------------------------------------------------------------------------#
+
+set(FLECSI_KERNEL_THREADS "1" CACHE STRING
+  "Select the number of threads, including the calling thread, that execute the entities of forall and reduce kernels")
+
 #------------------------------------------------------------------------------#
 # Add option for FleCSIT command-line tool.
 #------------------------------------------------------------------------------#
@@ -260,6 +267,19 @@ elseif(FLECSI_RUNTIME_MODEL STREQUAL "mpi")
 
   set(FLECSI_RUNTIME_LIBRARIES ${DL_LIBS} ${MPI_LIBRARIES})
 
+  #
+  # Ghost exchange engine
+  #
+  option(ENABLE_MPI_NEIGHBORHOOD_COLLECTIVES
+    "Use neighborhood collectives on a distributed graph communicator for ghost updates"
+    OFF)
+
+  #
+  # Task worker threads
+  #
+  set(FLECSI_MPI_TASK_THREADS "0" CACHE STRING
+    "Select the number of worker threads that execute tasks on each MPI rank. Tasks are executed inline if this is zero")
+
 elseif(FLECSI_RUNTIME_MODEL STREQUAL "hpx")
 
   if(NOT HPX_FOUND)
@@ -364,6 +384,8 @@ set(FLECSI_ENABLE_MPI ${ENABLE_MPI})
 set(FLECSI_ENABLE_LEGION ${ENABLE_LEGION})
 set(FLECSI_ENABLE_METIS ENABLE_METIS)
 set(FLECSI_ENABLE_PARMETIS ENABLE_PARMETIS)
+set(FLECSI_ENABLE_MPI_NEIGHBORHOOD_COLLECTIVES
+  ${ENABLE_MPI_NEIGHBORHOOD_COLLECTIVES})
 
 configure_file(${PROJECT_SOURCE_DIR}/config/flecsi-config.h.in
   ${CMAKE_BINARY_DIR}/flecsi-config.h @ONLY)
@@ -0,0 +1,279 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <flecsi/coloring/adjacency_types.h>
+#include <flecsi/coloring/coloring_types.h>
+#include <flecsi/coloring/index_coloring.h>
+
+namespace flecsi {
+namespace coloring {
+
+/*!
+ The version of the format of the coloring cache files. It must be
+ incremented whenever the cached types change, so that the files of
+ previous versions are recomputed instead of being misread.
+
+ @ingroup coloring
+ */
+
+constexpr size_t coloring_cache_version = 2;
+
+/*!
+ Return the name of the coloring cache file of a color.
+
+ @param directory The directory of the cache files.
+ @param key       Identifies the input of the colorings, e.g., the
+                  checksum of the mesh definition.
+ @param colors    The number of colors.
+ @param color     The color.
+
+ @ingroup coloring
+ */
+
+inline std::string
+coloring_cache_file(
+    const std::string & directory,
+    size_t key,
+    size_t colors,
+    size_t color) {
+  std::stringstream name;
+  name << directory << "/coloring-" << std::hex << std::setw(16)
+       << std::setfill('0') << key << std::dec << "-" << colors << "."
+       << color;
+  return name.str();
+} // coloring_cache_file
+
+/*!
+ The binary serialization of the colorings in the cache files. The
+ values are written in the native representation, since the files are
+ only read back on the same machine. Containers are written as their
+ size followed by their elements.
+ */
+
+namespace cache {
+
+inline void write(std::ostream & stream, size_t value);
+inline void write(std::ostream & stream, const entity_info_t & entity);
+inline void write(std::ostream & stream, const index_coloring_t & coloring);
+inline void write(std::ostream & stream, const coloring_info_t & info);
+inline void write(std::ostream & stream, const adjacency_info_t & info);
+template<typename T>
+void write(std::ostream & stream, const std::vector<T> & values);
+template<typename T>
+void write(std::ostream & stream, const std::set<T> & values);
+template<typename K, typename V>
+void write(std::ostream & stream, const std::map<K, V> & values);
+template<typename K, typename V>
+void write(std::ostream & stream, const std::unordered_map<K, V> & values);
+
+inline void read(std::istream & stream, size_t & value);
+inline void read(std::istream & stream, entity_info_t & entity);
+inline void read(std::istream & stream, index_coloring_t & coloring);
+inline void read(std::istream & stream, coloring_info_t & info);
+inline void read(std::istream & stream, adjacency_info_t & info);
+template<typename T>
+void read(std::istream & stream, std::vector<T> & values);
+template<typename T>
+void read(std::istream & stream, std::set<T> & values);
+template<typename K, typename V>
+void read(std::istream & stream, std::map<K, V> & values);
+template<typename K, typename V>
+void read(std::istream & stream, std::unordered_map<K, V> & values);
+
+inline void
+write(std::ostream & stream, size_t value) {
+  stream.write(reinterpret_cast<const char *>(&value), sizeof(value));
+} // write
+
+inline void
+read(std::istream & stream, size_t & value) {
+  stream.read(reinterpret_cast<char *>(&value), sizeof(value));
+} // read
+
+template<typename T>
+void
+write(std::ostream & stream, const std::vector<T> & values) {
+  write(stream, values.size());
+
+  for (auto & v : values) {
+    write(stream, v);
+  } // for
+} // write
+
+// The elements are read one at a time, and the reading stops at the
+// first error, so that a corrupt size does not allocate the memory.
+template<typename T>
+void
+read(std::istream & stream, std::vector<T> & values) {
+  size_t size(0);
+  read(stream, size);
+  values.clear();
+
+  for (size_t i(0); i < size && stream; ++i) {
+    T value;
+    read(stream, value);
+    values.push_back(std::move(value));
+  } // for
+} // read
+
+template<typename T>
+void
+write(std::ostream & stream, const std::set<T> & values) {
+  write(stream, values.size());
+
+  for (auto & v : values) {
+    write(stream, v);
+  } // for
+} // write
+
+template<typename T>
+void
+read(std::istream & stream, std::set<T> & values) {
+  size_t size(0);
+  read(stream, size);
+  values.clear();
+
+  for (size_t i(0); i < size && stream; ++i) {
+    T value;
+    read(stream, value);
+    values.insert(values.end(), std::move(value));
+  } // for
+} // read
+
+template<typename K, typename V>
+void
+write(std::ostream & stream, const std::map<K, V> & values) {
+  write(stream, values.size());
+
+  for (auto & v : values) {
+    write(stream, v.first);
+    write(stream, v.second);
+  } // for
+} // write
+
+template<typename K, typename V>
+void
+read(std::istream & stream, std::map<K, V> & values) {
+  size_t size(0);
+  read(stream, size);
+  values.clear();
+
+  for (size_t i(0); i < size && stream; ++i) {
+    K key;
+    read(stream, key);
+    read(stream, values[key]);
+  } // for
+} // read
+
+template<typename K, typename V>
+void
+write(std::ostream & stream, const std::unordered_map<K, V> & values) {
+  write(stream, std::map<K, V>(values.begin(), values.end()));
+} // write
+
+template<typename K, typename V>
+void
+read(std::istream & stream, std::unordered_map<K, V> & values) {
+  std::map<K, V> ordered;
+  read(stream, ordered);
+  values = std::unordered_map<K, V>(ordered.begin(), ordered.end());
+} // read
+
+inline void
+write(std::ostream & stream, const entity_info_t & entity) {
+  write(stream, entity.id);
+  write(stream, entity.rank);
+  write(stream, entity.offset);
+  write(stream, entity.shared);
+} // write
+
+inline void
+read(std::istream & stream, entity_info_t & entity) {
+  read(stream, entity.id);
+  read(stream, entity.rank);
+  read(stream, entity.offset);
+  read(stream, entity.shared);
+} // read
+
+inline void
+write(std::ostream & stream, const index_coloring_t & coloring) {
+  write(stream, coloring.primary);
+  write(stream, coloring.exclusive);
+  write(stream, coloring.shared);
+  write(stream, coloring.ghost);
+  write(stream, coloring.entities_per_rank);
+} // write
+
+inline void
+read(std::istream & stream, index_coloring_t & coloring) {
+  read(stream, coloring.primary);
+  read(stream, coloring.exclusive);
+  read(stream, coloring.shared);
+  read(stream, coloring.ghost);
+  read(stream, coloring.entities_per_rank);
+} // read
+
+inline void
+write(std::ostream & stream, const coloring_info_t & info) {
+  write(stream, info.exclusive);
+  write(stream, info.shared);
+  write(stream, info.ghost);
+  write(stream, info.shared_users);
+  write(stream, info.ghost_owners);
+} // write
+
+inline void
+read(std::istream & stream, coloring_info_t & info) {
+  read(stream, info.exclusive);
+  read(stream, info.shared);
+  read(stream, info.ghost);
+  read(stream, info.shared_users);
+  read(stream, info.ghost_owners);
+} // read
+
+inline void
+write(std::ostream & stream, const adjacency_info_t & info) {
+  write(stream, info.index_space);
+  write(stream, info.from_index_space);
+  write(stream, info.to_index_space);
+  write(stream, info.color_sizes);
+} // write
+
+inline void
+read(std::istream & stream, adjacency_info_t & info) {
+  read(stream, info.index_space);
+  read(stream, info.from_index_space);
+  read(stream, info.to_index_space);
+  read(stream, info.color_sizes);
+} // read
+
+} // namespace cache
+
+} // namespace coloring
+} // namespace flecsi
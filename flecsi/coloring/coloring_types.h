@@ -42,6 +42,12 @@ struct coloring_info_t {
   //! The aggregate set of colors that we depend on for ghosts.
   std::set<size_t> ghost_owners;
 
+  //! The shared users that are on the same node as the color.
+  std::set<size_t> shared_users_on_node;
+
+  //! The ghost owners that are on the same node as the color.
+  std::set<size_t> ghost_owners_on_node;
+
 }; // struct coloring_info_t
 
 inline std::ostream &
@@ -60,6 +66,18 @@ operator<<(std::ostream & stream, const coloring_info_t & ci) {
   for (auto i : ci.ghost_owners) {
     stream << i << " ";
   } // for
+  stream << "]";
+
+  stream << " on node users [ ";
+  for (auto i : ci.shared_users_on_node) {
+    stream << i << " ";
+  } // for
+  stream << "]";
+
+  stream << " on node owners [ ";
+  for (auto i : ci.ghost_owners_on_node) {
+    stream << i << " ";
+  } // for
   stream << "]" << std::endl;
 
   return stream;
@@ -23,11 +23,17 @@
 
 #include <mpi.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <map>
+#include <set>
+#include <vector>
 
 #include <flecsi/coloring/crs.h>
+#include <flecsi/coloring/mpi_utils.h>
 #include <flecsi/topology/closure_utils.h>
 #include <flecsi/topology/mesh_definition.h>
+#include <flecsi/utils/hash.h>
 
 namespace flecsi {
 namespace coloring {
@@ -86,12 +92,118 @@ naive_coloring(topology::mesh_definition__<MESH_DIMENSION> & md) {
   return indices;
 } // naive_coloring
 
+/*!
+ Return a checksum of the topology of a mesh definition, e.g., to
+ identify the input of cached colorings, see
+ \ref execution::context__::use_coloring_cache. Every rank hashes the
+ definitions of a block of the cells, so that the mesh definition is
+ read only once in total, and the hashes of the cells are summed, so
+ that the checksum does not depend on the number of ranks. The vertex
+ coordinates are not part of the mesh definition interface, so that a
+ geometric colorer should combine their checksum with this one.
+
+ This must be called by every rank.
+
+ @param md The mesh definition.
+
+ @ingroup coloring
+ */
+
+template<size_t DIMENSION>
+inline size_t
+mesh_checksum(const topology::mesh_definition__<DIMENSION> & md) {
+  int size;
+  int rank;
+
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // The bits of the hashes are spread before they are summed.
+  using utils::hash::mix;
+
+  const size_t cells = md.num_entities(DIMENSION);
+  uint64_t sum(0);
+
+  for (size_t c(cells * rank / size); c < cells * (rank + 1) / size; ++c) {
+    // FNV-1a over the cell id and its vertices.
+    uint64_t h = 0xcbf29ce484222325ull;
+
+    h = (h ^ c) * 0x100000001b3ull;
+
+    for (auto v : md.entities(DIMENSION, 0, c)) {
+      h = (h ^ v) * 0x100000001b3ull;
+    } // for
+
+    sum += mix(h);
+  } // for
+
+  MPI_Allreduce(MPI_IN_PLACE, &sum, 1, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+
+  return mix(sum + mix(DIMENSION) + mix(cells) + mix(md.num_entities(0)));
+} // mesh_checksum
+
+/*!
+ Exchange variable-length buffers of indices between all ranks. Only the
+ message counts are exchanged with every rank; the payloads are sent
+ with MPI_Alltoallv, so that the communication volume is proportional
+ to the number of indices that are actually sent.
+
+ @param send The indices to send to each rank.
+
+ @return The indices received from each rank, concatenated in rank order.
+ */
+
+inline std::vector<size_t>
+alltoallv(const std::vector<std::vector<size_t>> & send) {
+  int size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  std::vector<int> send_counts(size);
+  std::vector<int> send_offsets(size + 1, 0);
+
+  for (int r(0); r < size; ++r) {
+    send_counts[r] = send[r].size();
+    send_offsets[r + 1] = send_offsets[r] + send_counts[r];
+  } // for
+
+  std::vector<int> recv_counts(size);
+  MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1,
+    MPI_INT, MPI_COMM_WORLD);
+
+  std::vector<int> recv_offsets(size + 1, 0);
+
+  for (int r(0); r < size; ++r) {
+    recv_offsets[r + 1] = recv_offsets[r] + recv_counts[r];
+  } // for
+
+  std::vector<size_t> send_buffer;
+  send_buffer.reserve(send_offsets[size]);
+
+  for (auto & s : send) {
+    send_buffer.insert(send_buffer.end(), s.begin(), s.end());
+  } // for
+
+  std::vector<size_t> recv_buffer(recv_offsets[size]);
+
+  MPI_Alltoallv(send_buffer.data(), send_counts.data(), send_offsets.data(),
+    mpi_typetraits__<size_t>::type(), recv_buffer.data(), recv_counts.data(),
+    recv_offsets.data(), mpi_typetraits__<size_t>::type(), MPI_COMM_WORLD);
+
+  return recv_buffer;
+} // alltoallv
+
 /*!
  Create distributed CRS representation of the graph defined by entities
  of FROM_DIMENSION to TO_DIMENSION through THRU_DIMENSION. The return
  object will be populated with a naive partitioning suitable for use
  with coloring tools, e.g., ParMETIS.
 
+ Each rank only queries the mesh definition for the entities of its
+ naive block. The entity-to-vertex adjacency is distributed by hashing
+ the vertices to owner ranks, which find the entities that share each
+ of their vertices and return the pairs to the owners of the entities.
+ No rank stores more than its share of the global graph.
+
  @tparam FROM_DIMENSION The topological dimension of the entity for which
                         the partitioning is requested.
  @tparam TO_DIMENSION   The topological dimension to search for neighbors.
@@ -124,72 +236,122 @@ make_dcrs(const typename topology::mesh_definition__<DIMENSION> & md) {
 
   // Each rank gets the average number of indices, with higher ranks
   // getting an additional index for non-zero remainders.
-  size_t init_indices = quot + ((rank >= (size - rem)) ? 1 : 0);
+  size_t init_indices = quot + ((size_t(rank) >= (size - rem)) ? 1 : 0);
 
   // Start to initialize the return object.
   dcrs_t dcrs;
   dcrs.distribution.push_back(0);
 
   // Set the distributions for each rank. This happens on all ranks.
-  for (size_t r(0); r < size; ++r) {
+  for (size_t r(0); r < size_t(size); ++r) {
     const size_t indices = quot + ((r >= (size - rem)) ? 1 : 0);
     dcrs.distribution.push_back(dcrs.distribution[r] + indices);
   } // for
 
+  const size_t first = dcrs.distribution[rank];
+
   //--------------------------------------------------------------------------//
-  // Create the cell-to-cell graph.
+  // Send the cell-to-vertex connectivity to the vertex owners.
   //--------------------------------------------------------------------------//
 
-  // Set the first offset (always zero).
-  dcrs.offsets.push_back(0);
-
-  // Add the graph adjacencies by getting the neighbors of each
-  // cell index
   using cellid = size_t;
   using vertexid = size_t;
 
-  // essentially vertex to cell and cell to cell through vertices
-  // connectivity.
-  std::map<vertexid, std::vector<cellid>> vertex2cells;
-  std::map<cellid, std::vector<cellid>> cell2cells;
-
-  // build global cell to cell through # of shared vertices connectivity
-  for (size_t cell(0); cell < md.num_entities(FROM_DIMENSION); ++cell) {
-    std::map<cellid, size_t> cell_counts;
-
-    for (auto vertex : md.entities(FROM_DIMENSION, 0, cell)) {
-      // build vertex to cell connectivity, O(n_cells * n_polygon_sides)
-      // of insert().
-      vertex2cells[vertex].push_back(cell);
-
-      // Count the number of times this cell shares a common vertex with
-      // some other cell. O(n_cells * n_polygon_sides * vertex to cells degrees)
-      for (auto other : vertex2cells[vertex]) {
-        if (other != cell)
-          cell_counts[other] += 1;
-      }
-    }
-
-    for (auto count : cell_counts) {
-      if (count.second > THRU_DIMENSION) {
-        // append cell to cell through "dimension" connectivity, we need to
-        // add both directions
-        cell2cells[cell].push_back(count.first);
-        cell2cells[count.first].push_back(cell);
-      }
-    }
-  }
-
-  // turn subset of cell 2 cell connectivity to dcrs
+  // Vertices are owned by the rank of their id modulo the number of ranks.
+  // The messages are vertex/cell pairs.
+  std::vector<std::vector<size_t>> send(size);
+
   for (size_t i(0); i < init_indices; ++i) {
-    auto cell = dcrs.distribution[rank] + i;
+    const cellid cell = first + i;
 
-    for (auto n : cell2cells[cell]) {
-      dcrs.indices.push_back(n);
+    for (vertexid vertex : md.entities(FROM_DIMENSION, 0, cell)) {
+      auto & s = send[vertex % size];
+      s.push_back(vertex);
+      s.push_back(cell);
     } // for
+  } // for
+
+  std::vector<size_t> received = alltoallv(send);
 
-    dcrs.offsets.push_back(dcrs.offsets[i] + cell2cells[cell].size());
-  }
+  //--------------------------------------------------------------------------//
+  // Find the cells that share each owned vertex, and send the cell pairs
+  // to the owners of the cells.
+  //--------------------------------------------------------------------------//
+
+  std::vector<std::pair<vertexid, cellid>> vertex2cells;
+  vertex2cells.reserve(received.size() / 2);
+
+  for (size_t i(0); i < received.size(); i += 2) {
+    vertex2cells.emplace_back(received[i], received[i + 1]);
+  } // for
+
+  std::sort(vertex2cells.begin(), vertex2cells.end());
+
+  for (auto & s : send) {
+    s.clear();
+  } // for
+
+  for (auto begin = vertex2cells.begin(); begin != vertex2cells.end();) {
+    auto end = begin;
+
+    while (end != vertex2cells.end() && end->first == begin->first) {
+      ++end;
+    } // while
+
+    for (auto cell = begin; cell != end; ++cell) {
+      // The owner of the cell in the naive distribution.
+      const size_t owner = std::upper_bound(dcrs.distribution.begin(),
+                             dcrs.distribution.end(), cell->second) -
+                           dcrs.distribution.begin() - 1;
+
+      for (auto other = begin; other != end; ++other) {
+        if (other->second != cell->second) {
+          send[owner].push_back(cell->second);
+          send[owner].push_back(other->second);
+        } // if
+      } // for
+    } // for
+
+    begin = end;
+  } // for
+
+  received = alltoallv(send);
+
+  //--------------------------------------------------------------------------//
+  // Create the cell-to-cell graph of the local cells. Every pair was
+  // received once for each vertex that the two cells share.
+  //--------------------------------------------------------------------------//
+
+  std::vector<std::pair<cellid, cellid>> cell2cells;
+  cell2cells.reserve(received.size() / 2);
+
+  for (size_t i(0); i < received.size(); i += 2) {
+    cell2cells.emplace_back(received[i], received[i + 1]);
+  } // for
+
+  std::sort(cell2cells.begin(), cell2cells.end());
+
+  // Set the first offset (always zero).
+  dcrs.offsets.resize(init_indices + 1, 0);
+
+  for (auto begin = cell2cells.begin(); begin != cell2cells.end();) {
+    auto end = begin;
+
+    while (end != cell2cells.end() && *end == *begin) {
+      ++end;
+    } // while
+
+    if (size_t(end - begin) > THRU_DIMENSION) {
+      dcrs.indices.push_back(begin->second);
+      ++dcrs.offsets[begin->first - first + 1];
+    } // if
+
+    begin = end;
+  } // for
+
+  for (size_t i(0); i < init_indices; ++i) {
+    dcrs.offsets[i + 1] += dcrs.offsets[i];
+  } // for
 
   return dcrs;
 } // make_dcrs
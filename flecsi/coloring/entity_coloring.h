@@ -0,0 +1,323 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include <cinchlog.h>
+
+#include <flecsi-config.h>
+
+#if !defined(FLECSI_ENABLE_MPI)
+#error FLECSI_ENABLE_MPI not defined! This file depends on MPI!
+#endif
+
+#include <flecsi/coloring/coloring_types.h>
+#include <flecsi/coloring/index_coloring.h>
+#include <flecsi/coloring/mpi_communicator.h>
+#include <flecsi/topology/closure_utils.h>
+#include <flecsi/topology/mesh_definition.h>
+#include <flecsi/utils/set_utils.h>
+
+clog_register_tag(entity_coloring);
+
+namespace flecsi {
+namespace coloring {
+
+/*!
+  The coloring of the entities of one dimension on the calling color.
+
+  @ingroup coloring
+ */
+
+struct entity_coloring_t {
+  index_coloring_t coloring;
+  coloring_info_t info;
+}; // struct entity_coloring_t
+
+/*!
+ Color the cells of a mesh and the entities of lower dimensions from a
+ primary coloring of the cells, e.g., from \ref parmetis_colorer_t or
+ \ref sfc_colorer__.
+
+ The ghost cells are the given number of layers of neighbors of the
+ primary cells, where two cells are neighbors if they share more than
+ thru_dimension vertices. The entities of the lower dimensions are those
+ of the primary and ghost cells. Each of them is owned by the lowest
+ rank that owns a cell referencing it.
+
+ The cell connectivity is built once and the layers are added locally, so that
+ the number of communication rounds does not depend on the ghost depth
+ or on the number of dimensions: two rounds find the owners of the
+ cells, and one round assigns the entities of all dimensions.
+
+ @param md             The mesh definition.
+ @param communicator   The communicator.
+ @param primary        The primary cells of the calling color.
+ @param dimensions     The dimensions of the entities to color, besides
+                       the cells, e.g., {0} for the vertices.
+ @param ghost_depth    The number of layers of ghost cells.
+ @param thru_dimension The dimension of the entities through which the
+                       cells are neighbors, e.g., 0 for vertices or
+                       DIMENSION - 1 for faces.
+
+ @return The coloring of each dimension, including DIMENSION for the
+         cells. The coloring information is local to the calling color;
+         see \ref mpi_communicator_t::gather_coloring_info.
+
+ @ingroup coloring
+ */
+
+template<size_t DIMENSION>
+std::map<size_t, entity_coloring_t>
+color_entities(
+    const topology::mesh_definition__<DIMENSION> & md,
+    mpi_communicator_t & communicator,
+    const std::set<size_t> & primary,
+    const std::set<size_t> & dimensions,
+    size_t ghost_depth = 1,
+    size_t thru_dimension = 0) {
+  const size_t rank = communicator.rank();
+  const size_t none = std::numeric_limits<size_t>::max();
+
+  std::map<size_t, entity_coloring_t> result;
+
+  //--------------------------------------------------------------------------//
+  // Find the ghost cells.
+  //--------------------------------------------------------------------------//
+
+  // The vertices of each cell and the cells that reference each vertex.
+  const auto cell_vertices = topology::entity_definitions(md, DIMENSION, 0);
+  const auto vertex_cells =
+      topology::transpose(cell_vertices, md.num_entities(0));
+
+  std::set<size_t> closure(primary);
+  std::vector<size_t> frontier(primary.begin(), primary.end());
+
+  for (size_t layer(0); layer < ghost_depth && !frontier.empty(); ++layer) {
+    auto adjacent = topology::entity_neighbors(
+        cell_vertices, vertex_cells, frontier, thru_dimension);
+
+    frontier.clear();
+
+    for (auto n : adjacent) {
+      if (closure.insert(n).second) {
+        frontier.push_back(n);
+      } // if
+    } // for
+  } // for
+
+  const auto ghost = utils::set_difference(closure, primary);
+
+  {
+    clog_tag_guard(entity_coloring);
+    clog_container_one(info, "ghost cells", ghost, clog::space);
+  } // guard
+
+  //--------------------------------------------------------------------------//
+  // Color the cells.
+  //--------------------------------------------------------------------------//
+
+  auto & cells = result[DIMENSION];
+  cells.coloring.primary = primary;
+
+  auto cell_info = communicator.get_primary_info(primary, ghost);
+
+  {
+    size_t offset(0);
+    for (auto c : primary) {
+      const auto & users = cell_info.first[offset];
+
+      if (users.size()) {
+        cells.coloring.shared.insert(entity_info_t(c, rank, offset, users));
+        cells.info.shared_users =
+            utils::set_union(cells.info.shared_users, users);
+      } else {
+        cells.coloring.exclusive.insert(entity_info_t(c, rank, offset, users));
+      } // if
+
+      ++offset;
+    } // for
+  } // scope
+
+  for (auto & g : cell_info.second) {
+    cells.coloring.ghost.insert(g);
+    cells.info.ghost_owners.insert(g.rank);
+  } // for
+
+  cells.info.exclusive = cells.coloring.exclusive.size();
+  cells.info.shared = cells.coloring.shared.size();
+  cells.info.ghost = cells.coloring.ghost.size();
+
+  if (dimensions.empty()) {
+    return result;
+  } // if
+
+  //--------------------------------------------------------------------------//
+  // Find the owners of the cells that share a vertex with the primary
+  // or ghost cells. These are all of the cells that reference one of the
+  // entities of the primary or ghost cells.
+  //--------------------------------------------------------------------------//
+
+  std::set<size_t> halo;
+
+  for (auto n : topology::entity_neighbors(cell_vertices, vertex_cells,
+           std::vector<size_t>(closure.begin(), closure.end()), 0)) {
+    if (closure.count(n) == 0) {
+      halo.insert(n);
+    } // if
+  } // for
+
+  std::unordered_map<size_t, size_t> cell_owner;
+
+  for (auto c : primary) {
+    cell_owner[c] = rank;
+  } // for
+
+  for (auto & g : cell_info.second) {
+    cell_owner[g.id] = g.rank;
+  } // for
+
+  for (auto & h : communicator.get_primary_info(primary, halo).second) {
+    cell_owner[h.id] = h.rank;
+  } // for
+
+  //--------------------------------------------------------------------------//
+  // Assign the owners of the entities, and request the offsets of the
+  // entities that belong to other ranks. The requests of all dimensions
+  // are sent together as (dimension, id) pairs.
+  //--------------------------------------------------------------------------//
+
+  // The offsets of the owned entities of each dimension.
+  std::map<size_t, std::unordered_map<size_t, size_t>> owned;
+
+  // The ranks that request each owned entity.
+  std::map<size_t, std::map<size_t, std::set<size_t>>> users;
+
+  std::map<size_t, std::vector<size_t>> requests;
+
+  for (auto d : dimensions) {
+    clog_assert(d < DIMENSION, "invalid entity dimension " << d);
+
+    std::map<size_t, size_t> owner;
+
+    for (auto c : closure) {
+      for (auto e : md.entities(DIMENSION, d, c)) {
+        owner.emplace(e, none);
+      } // for
+    } // for
+
+    for (auto set : {&closure, &halo}) {
+      for (auto c : *set) {
+        const size_t r = cell_owner.at(c);
+
+        for (auto e : md.entities(DIMENSION, d, c)) {
+          auto it = owner.find(e);
+
+          if (it != owner.end()) {
+            it->second = std::min(it->second, r);
+          } // if
+        } // for
+      } // for
+    } // for
+
+    auto & entities = result[d];
+    auto & offsets = owned[d];
+
+    for (auto & e : owner) {
+      if (e.second == rank) {
+        const size_t offset = offsets.size();
+        offsets[e.first] = offset;
+        entities.coloring.primary.insert(e.first);
+      } else {
+        requests[e.second].push_back(d);
+        requests[e.second].push_back(e.first);
+      } // if
+    } // for
+  } // for
+
+  auto received = communicator.sparse_exchange(requests);
+
+  std::map<size_t, std::vector<size_t>> replies;
+
+  for (auto & r : received) {
+    auto & reply = replies[r.first];
+
+    for (size_t i(0); i < r.second.size(); i += 2) {
+      const size_t d = r.second[i];
+      const size_t e = r.second[i + 1];
+
+      auto it = owned[d].find(e);
+      clog_assert(it != owned[d].end(), "entity " << e << " of dimension "
+        << d << " requested from a rank that does not own it");
+
+      users[d][e].insert(r.first);
+      reply.push_back(it->second);
+    } // for
+  } // for
+
+  auto offsets = communicator.sparse_exchange(replies);
+
+  //--------------------------------------------------------------------------//
+  // Color the entities.
+  //--------------------------------------------------------------------------//
+
+  for (auto d : dimensions) {
+    auto & entities = result[d];
+
+    for (auto & o : owned[d]) {
+      auto it = users[d].find(o.first);
+
+      if (it != users[d].end()) {
+        entities.coloring.shared.insert(
+            entity_info_t(o.first, rank, o.second, it->second));
+        entities.info.shared_users =
+            utils::set_union(entities.info.shared_users, it->second);
+      } else {
+        entities.coloring.exclusive.insert(
+            entity_info_t(o.first, rank, o.second));
+      } // if
+    } // for
+  } // for
+
+  for (auto & r : requests) {
+    const auto & reply = offsets.at(r.first);
+
+    for (size_t i(0); i < r.second.size(); i += 2) {
+      auto & entities = result[r.second[i]];
+      entities.coloring.ghost.insert(
+          entity_info_t(r.second[i + 1], r.first, reply[i / 2]));
+      entities.info.ghost_owners.insert(r.first);
+    } // for
+  } // for
+
+  for (auto d : dimensions) {
+    auto & entities = result[d];
+    entities.info.exclusive = entities.coloring.exclusive.size();
+    entities.info.shared = entities.coloring.shared.size();
+    entities.info.ghost = entities.coloring.ghost.size();
+  } // for
+
+  return result;
+} // color_entities
+
+} // namespace coloring
+} // namespace flecsi
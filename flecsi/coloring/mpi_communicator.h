@@ -23,6 +23,11 @@
 
 #include <mpi.h>
 
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
 #include <flecsi/coloring/communicator.h>
 #include <flecsi/coloring/mpi_utils.h>
 #include <flecsi/utils/set_utils.h>
@@ -73,59 +78,53 @@ public:
   }
 
   /*!
-   Reduces info_indices from all MPI ranks
-
-   @param request_indices  std::set of shared, ghost etc
-   @param max_request_indices Maximum # of indices per rank
-   @param colors Number of MPI ranks
-
-   @return std::vector vith the infirmation for the info_indices from all
-           MPI ranks
+   Return the node of each rank, see \ref mpi_nodes. The layout is
+   detected on the first call, which must be made by every rank.
 
    @ingroup coloring
    */
 
-  std::vector<size_t> get_info_indices(
-      const std::set<size_t> & request_indices,
-      size_t max_request_indices,
-      int colors) {
-    // Pad the request indices with size_t max. We will then set
-    // the indices of the actual request. Each rank that receives
-    // the request will try to provide information about the
-    // non size_t max values in the request. The others will
-    // be ignored.
-    std::vector<size_t> input_indices(
-        colors * max_request_indices, std::numeric_limits<size_t>::max());
-    std::vector<size_t> info_indices(colors * max_request_indices);
+  const std::vector<size_t> & nodes() {
+    if (nodes_.empty()) {
+      nodes_ = mpi_nodes();
+    } // if
 
-    for (size_t c(0); c < colors; ++c) {
-      size_t off(0);
-      const size_t coff = c * max_request_indices;
+    return nodes_;
+  } // nodes
 
-      for (auto s : request_indices) {
-        input_indices[coff + off++] = s;
-      } // for
-    } // for
+  /*!
+   Set the node of each rank, e.g., to group the ranks differently than
+   by shared memory.
 
-    const auto mpi_size_t_type =
-        flecsi::coloring::mpi_typetraits__<size_t>::type();
+   @param nodes The node of each rank.
 
-    // Send the request indices to all other ranks.
-    int result = MPI_Alltoall(
-        &input_indices[0], max_request_indices, mpi_size_t_type,
-        &info_indices[0], max_request_indices, mpi_size_t_type, MPI_COMM_WORLD);
+   @ingroup coloring
+   */
 
-    return info_indices;
-  } // get_info_indices
+  void set_nodes(const std::vector<size_t> & nodes) {
+    clog_assert(nodes.size() == size(), "invalid number of nodes");
+    nodes_ = nodes;
+  } // set_nodes
 
   /*!
    Rerturn a set containing the entity_info_t information for each
    member of the input set request_indices (from other ranks) and
    the information for the local indices in primary.
 
-   @param FIXME
+   The requests are matched with the owners through a distributed
+   directory: the directory entry of each index is held by the rank
+   of the index modulo the number of ranks. The owners and the
+   requesters register their indices with the directory, which returns
+   each match to both of them. Every rank only communicates with the
+   ranks that hold the directory entries of its own indices.
 
-   @return FIXME
+   @param primary The primary indices of the calling color.
+   @param request_indices The indices for which to return the owner
+                          information.
+
+   @return A pair with the ranks that requested each primary index, in
+           the order of the primary indices, and the owner information
+           for the requested indices.
 
    @ingroup coloring
   */
@@ -137,106 +136,92 @@ public:
     auto colors = size();
     auto color = rank();
 
-    // Store the request in a vector for indexed access below.
-    std::vector<size_t> request_indices_vector(
-        request_indices.begin(), request_indices.end());
-
-    const auto mpi_size_t_type =
-        flecsi::coloring::mpi_typetraits__<size_t>::type();
-
-    size_t max_request_indices = get_max_request_size(request_indices.size());
-
-    // Pad the request indices with size_t max. We will then set
-    // the indices of the actual request. Each rank that receives
-    // the request will try to provide information about the
-    // non size_t max values in the request. The others will
-    // be ignored.
-    std::vector<size_t> input_indices(
-        colors * max_request_indices, std::numeric_limits<size_t>::max());
-    std::vector<size_t> info_indices(colors * max_request_indices);
-    info_indices =
-        get_info_indices(request_indices, max_request_indices, colors);
-
-    // For now, we need two arrays for each all-to-all communication:
-    // One for rank ownership of the request indices, and one
-    // for the offsets. We could probably combine these. However,
-    // we would probably have to define a custom MPI type. It
-    // will only be worth the effort if this appraoch is slow.
-    // The input offsets do not need to be initialized because
-    // the information is available in the input_indices array.
-    std::vector<size_t> input_offsets(colors * max_request_indices);
-    std::vector<size_t> info_offsets(colors * max_request_indices);
-
-    // Reset input indices to use to send back information
-    std::fill(
-        input_indices.begin(), input_indices.end(),
-        std::numeric_limits<size_t>::max());
+    // Requests are marked with size_t max in place of the offset.
+    const size_t request = std::numeric_limits<size_t>::max();
 
-    // For the primary coloring, provide rank and entity information
-    // on indices that are shared with other processes.
-    std::vector<std::set<size_t>> local(primary.size());
+    // Register the primary and the requested indices with the directory.
+    exchange_t send;
 
-    // See if we can fill any requests...
-    for (size_t r(0); r < colors; ++r) {
+    {
+      size_t offset(0);
+      for (auto i : primary) {
+        auto & buffer = send[i % colors];
+        buffer.push_back(i);
+        buffer.push_back(offset++);
+      } // for
+    } // scope
 
-      // Ignore our rank
-      if (r == color) {
-        continue;
-      } // if
+    for (auto i : request_indices) {
+      auto & buffer = send[i % colors];
+      buffer.push_back(i);
+      buffer.push_back(request);
+    } // for
 
-      // These array slices are just for convenience.
-      size_t * info = &info_indices[r * max_request_indices];
-      size_t * offset = &input_offsets[r * max_request_indices];
-      size_t * input = &input_indices[r * max_request_indices];
+    auto recv = sparse_exchange(send);
 
-      // See which requests we can fulfill.
-      for (size_t i(0); i < max_request_indices; ++i) {
+    struct directory_entry_t {
+      size_t owner = std::numeric_limits<size_t>::max();
+      size_t offset = 0;
+      std::vector<size_t> requesters;
+    }; // struct directory_entry_t
 
-        auto match = primary.find(info[i]);
+    std::map<size_t, directory_entry_t> directory;
 
-        if (match != primary.end()) {
-          // This is a match, i.e., we own this entity, so we can
-          // set the rank (ownership) and offset.
-          input[i] = color;
-          offset[i] = std::distance(primary.begin(), match);
+    for (auto & r : recv) {
+      for (size_t i(0); i < r.second.size(); i += 2) {
+        auto & entry = directory[r.second[i]];
 
-          // We also need to register that this index is shared
-          // with other ranks
-          local[offset[i]].insert(r);
+        if (r.second[i + 1] == request) {
+          entry.requesters.push_back(r.first);
+        } else {
+          entry.owner = r.first;
+          entry.offset = r.second[i + 1];
         } // if
       } // for
     } // for
 
-    // Send the indices information back to all ranks.
-    int result = MPI_Alltoall(
-        &input_indices[0], max_request_indices, mpi_size_t_type,
-        &info_indices[0], max_request_indices, mpi_size_t_type, MPI_COMM_WORLD);
+    // Send each match to the owner and to the requester as
+    // (index, owner, offset, requester).
+    send.clear();
 
-    // Send the offsets information back to all ranks.
-    result = MPI_Alltoall(
-        &input_offsets[0], max_request_indices, mpi_size_t_type,
-        &info_offsets[0], max_request_indices, mpi_size_t_type, MPI_COMM_WORLD);
+    for (auto & d : directory) {
+      const auto & entry = d.second;
 
-    std::set<entity_info_t> remote;
-
-    // Collect all of the information for the remote entities.
-    for (size_t r(0); r < colors; ++r) {
-      // Skip these (we already know them!)
-      if (r == color) {
+      // Nobody owns this index, so the request cannot be filled.
+      if (entry.owner == std::numeric_limits<size_t>::max()) {
         continue;
       } // if
 
-      // Another slice for convenience.
-      size_t * ranks = &info_indices[r * max_request_indices];
-      size_t * offsets = &info_offsets[r * max_request_indices];
+      for (auto requester : entry.requesters) {
 
-      for (size_t i(0); i < max_request_indices; ++i) {
+        // Ignore requests for our own indices.
+        if (requester == entry.owner) {
+          continue;
+        } // if
 
-        if (ranks[i] != std::numeric_limits<size_t>::max()) {
-          // If this is not size_t max, this rank answered our request
-          // and we can set the information.
-          remote.insert(entity_info_t(
-              request_indices_vector[i], ranks[i], offsets[i], {}));
+        const size_t match[] = {d.first, entry.owner, entry.offset, requester};
+        send[entry.owner].insert(send[entry.owner].end(), match, match + 4);
+        send[requester].insert(send[requester].end(), match, match + 4);
+      } // for
+    } // for
+
+    recv = sparse_exchange(send);
+
+    // For the primary coloring, provide rank and entity information
+    // on indices that are shared with other processes.
+    std::vector<std::set<size_t>> local(primary.size());
+    std::set<entity_info_t> remote;
+
+    for (auto & r : recv) {
+      for (size_t i(0); i < r.second.size(); i += 4) {
+        const size_t * match = &r.second[i];
+
+        if (match[1] == color) {
+          // We own this index, so we need to register that it is
+          // shared with the requesting rank.
+          local[match[2]].insert(match[3]);
+        } else {
+          remote.insert(entity_info_t(match[0], match[1], match[2], {}));
         } // if
       } // for
     } // for
@@ -245,11 +230,15 @@ public:
   } // get_primary_info
 
   /*!
-   Rerturn FIXME
+   Rerturn the intersections of the request indices of the calling
+   color with the request indices of every other color. The
+   intersections are found through the same distributed directory that
+   is used by get_primary_info.
 
-   @param request_indices FIXME...
-                          information.
-   @return A std::unordered_map<size_t, std::set<size_t>> FIXME ...
+   @param request_indices The indices of the calling color.
+
+   @return A std::unordered_map<size_t, std::set<size_t>> with an entry
+           for each color that has a non-empty intersection.
 
    @ingroup coloring
   */
@@ -257,80 +246,57 @@ public:
   std::unordered_map<size_t, std::set<size_t>>
   get_intersection_info(const std::set<size_t> & request_indices) override {
     auto colors = size();
-    auto color = rank();
-
-    // Store the request in a vector for indexed access below.
-    std::vector<size_t> request_indices_vector(
-        request_indices.begin(), request_indices.end());
-
-    const auto mpi_size_t_type =
-        flecsi::coloring::mpi_typetraits__<size_t>::type();
 
-    size_t max_request_indices = get_max_request_size(request_indices.size());
+    // Register the indices with the directory.
+    exchange_t send;
 
-    // Pad the request indices with size_t max. We will then set
-    // the indices of the actual request. Each rank that receives
-    // the request will try to provide information about the
-    // non size_t max values in the request. The others will
-    // be ignored.
-    std::vector<size_t> input_indices(
-        colors * max_request_indices, std::numeric_limits<size_t>::max());
-    std::vector<size_t> info_indices(colors * max_request_indices);
-    info_indices =
-        get_info_indices(request_indices, max_request_indices, colors);
+    for (auto i : request_indices) {
+      send[i % colors].push_back(i);
+    } // for
 
-    // Reset input indices to use to send back information
-    std::fill(
-        input_indices.begin(), input_indices.end(),
-        std::numeric_limits<size_t>::max());
+    auto recv = sparse_exchange(send);
 
-    {
-      clog_tag_guard(mpi_communicator);
-      clog_container_one(info, "input_indices", info_indices, clog::space);
-    }
+    std::map<size_t, std::vector<size_t>> directory;
 
-    //
-    std::unordered_map<size_t, std::set<size_t>> intersection_map;
+    for (auto & r : recv) {
+      for (auto i : r.second) {
+        directory[i].push_back(r.first);
+      } // for
+    } // for
 
-    for (size_t r(0); r < colors; ++r) {
+    // Send every rank that requested an index the other ranks that
+    // requested it as (rank, index).
+    send.clear();
+
+    for (auto & d : directory) {
+      for (auto requester : d.second) {
+        for (auto other : d.second) {
+          if (other != requester) {
+            send[requester].push_back(other);
+            send[requester].push_back(d.first);
+          } // if
+        } // for
+      } // for
+    } // for
 
-      // Ignore our rank
-      if (r == color) {
-        continue;
-      } // if
+    recv = sparse_exchange(send);
 
-      // Array slice for convenience.
-      size_t * info = &info_indices[r * max_request_indices];
+    std::unordered_map<size_t, std::set<size_t>> intersection_map;
 
-      // Create a set of the off-color request indices.
-      std::set<size_t> intersection_set;
-      for (size_t i(0); i < max_request_indices; ++i) {
-        if (info[i] != std::numeric_limits<size_t>::max()) {
-          intersection_set.insert(info[i]);
-        } // if
+    for (auto & r : recv) {
+      for (size_t i(0); i < r.second.size(); i += 2) {
+        intersection_map[r.second[i]].insert(r.second[i + 1]);
       } // for
+    } // for
 
-      {
-        clog_tag_guard(mpi_communicator);
-        clog_container_one(
-            info, "intersection_set", intersection_set, clog::space);
-      }
-
-      // Compute the intersection
-      auto intersection =
-          flecsi::utils::set_intersection(intersection_set, request_indices);
-
-      {
-        clog_tag_guard(mpi_communicator);
+    {
+      clog_tag_guard(mpi_communicator);
+      for (auto & i : intersection_map) {
         clog_container_one(
-            info, "rank " << r << " intersection", intersection, clog::space);
-      }
-
-      // If the intersection is non-empty, add it to the return map
-      if (intersection.size()) {
-        intersection_map[r] = intersection;
-      } // if
-    } // for
+            info, "rank " << i.first << " intersection", i.second,
+            clog::space);
+      } // for
+    }
 
     return intersection_map;
   } // get_intersection_info
@@ -349,29 +315,14 @@ public:
   std::unordered_map<size_t, std::set<size_t>>
   get_entity_reduction(const std::set<size_t> & local_indices) override {
     auto colors = size();
-    auto color = rank();
 
-    size_t max_request_indices = get_max_request_size(local_indices.size());
-
-    auto info_indices =
-        get_info_indices(local_indices, max_request_indices, colors);
+    auto indices = gather_indices(local_indices);
 
     std::unordered_map<size_t, std::set<size_t>> entity_reduction_map;
 
     for (size_t c(0); c < colors; ++c) {
-
-      // Array slice for convenience.
-      size_t * info = &info_indices[c * max_request_indices];
-
-      // Create a set of the off-color request indices.
-      std::set<size_t> reduction_set;
-      for (size_t i(0); i < max_request_indices; ++i) {
-        if (info[i] != std::numeric_limits<size_t>::max()) {
-          reduction_set.insert(info[i]);
-        } // if
-      } // for
-
-      entity_reduction_map[c] = reduction_set;
+      entity_reduction_map[c] =
+          std::set<size_t>(indices[c].begin(), indices[c].end());
     } // for
 
     return entity_reduction_map;
@@ -381,9 +332,10 @@ public:
    Return a set containing the entity_info_t information for each
    member of the input set request_indices (from other ranks).
 
-   @param entity_info FIXME...
+   @param entity_info The information for the entities of the calling
+                      color.
    @param request_indices A set of entity ids for which to return
-                          information.
+                          information for each rank.
    @return A std::vector<std::set<size_t>> containing the offset
            information for the requested indices.
 
@@ -394,46 +346,16 @@ public:
       const std::set<entity_info_t> & entity_info,
       const std::vector<std::set<size_t>> & request_indices) override {
     auto colors = size();
-    auto color = rank();
-
-    // Collect the size of each rank request to send.
-    std::vector<size_t> send_cnts(colors, 0);
-    for (size_t r(0); r < colors; ++r) {
-      send_cnts[r] = request_indices[r].size();
-    } // for
-
-    // Send the request size (in indices) to each rank.
-    std::vector<size_t> recv_cnts(colors);
-    int result = MPI_Alltoall(
-        &send_cnts[0], 1, mpi_typetraits__<size_t>::type(), &recv_cnts[0], 1,
-        mpi_typetraits__<size_t>::type(), MPI_COMM_WORLD);
 
-    // Start receive operations (non-blocking).
-    std::vector<std::vector<size_t>> rbuffers(colors);
-    std::vector<MPI_Request> requests;
+    // Send the requests to the ranks that own the indices.
+    exchange_t send;
     for (size_t r(0); r < colors; ++r) {
-      if (recv_cnts[r]) {
-        rbuffers[r].resize(recv_cnts[r]);
-        requests.push_back({});
-        MPI_Irecv(
-            &rbuffers[r][0], recv_cnts[r], mpi_typetraits__<size_t>::type(), r,
-            0, MPI_COMM_WORLD, &requests[requests.size() - 1]);
+      if (request_indices[r].size()) {
+        send[r].assign(request_indices[r].begin(), request_indices[r].end());
       } // if
     } // for
 
-    // Start send operations (blocking is ok here).
-    std::vector<std::vector<size_t>> sbuffers(colors);
-    for (size_t r(0); r < colors; ++r) {
-      if (send_cnts[r]) {
-        std::copy(
-            request_indices[r].begin(), request_indices[r].end(),
-            std::back_inserter(sbuffers[r]));
-
-        MPI_Send(
-            &sbuffers[r][0], send_cnts[r], mpi_typetraits__<size_t>::type(), r,
-            0, MPI_COMM_WORLD);
-      } // if
-    } // for
+    auto requests = sparse_exchange(send);
 
     // Create a map version of the entity info for lookups below.
     std::unordered_map<size_t, entity_info_t> entity_info_map;
@@ -441,61 +363,115 @@ public:
       entity_info_map[i.id] = i;
     } // for
 
-    // Wait on the receive operations
-    std::vector<MPI_Status> status(requests.size());
-    MPI_Waitall(requests.size(), &requests[0], &status[0]);
+    // Answer with the offsets of the requested indices.
+    send.clear();
+    for (auto & r : requests) {
+      auto & buffer = send[r.first];
 
-    // Set the offsets for each requested index in the send buffer.
-    for (size_t r(0); r < colors; ++r) {
-      sbuffers[r].resize(rbuffers[r].size());
-
-      size_t offset(0);
-      for (auto i : rbuffers[r]) {
-        sbuffers[r][offset++] = entity_info_map[i].offset;
+      for (auto i : r.second) {
+        buffer.push_back(entity_info_map[i].offset);
       } // for
     } // for
 
-    // we are reusing requests in the following code, need to clear the content
-    // first.
-    requests.clear();
+    auto offsets = sparse_exchange(send);
 
-    // Start receive operations (non-blocking) to get back the
-    // offsets we requested.
-    for (size_t r(0); r < colors; ++r) {
-      // If we sent a request, prepare to receive an answer.
-      if (send_cnts[r]) {
-        // We're done with our receive buffers, so we can re-use them.
-        rbuffers[r].resize(send_cnts[r], 0);
-        requests.push_back({});
-        MPI_Irecv(
-            &rbuffers[r][0], send_cnts[r], mpi_typetraits__<size_t>::type(), r,
-            0, MPI_COMM_WORLD, &requests[requests.size() - 1]);
-      } // if
+    std::vector<std::set<size_t>> remote(colors);
+    for (auto & r : offsets) {
+      remote[r.first].insert(r.second.begin(), r.second.end());
     } // for
 
-    // Start send operations (blocking is probably ok here).
-    for (size_t r(0); r < colors; ++r) {
-      // If we received a request, prepare to send an answer.
-      if (recv_cnts[r]) {
-        MPI_Send(
-            &sbuffers[r][0], recv_cnts[r], mpi_typetraits__<size_t>::type(), r,
-            0, MPI_COMM_WORLD);
+    return remote;
+  } // get_entity_info
+
+  /*!
+   Send a buffer of values to each rank in send and receive the buffers
+   that other ranks send to the calling rank. The receivers do not need
+   to know which ranks send to them: the messages are sent with
+   synchronous sends, and a non-blocking barrier is entered once all of
+   them have been matched. When the barrier completes, every message
+   has been received. This costs O(neighbors) instead of O(ranks) memory
+   and messages.
+
+   Must be called collectively.
+
+   @tparam TYPE The P.O.D. type of the values.
+
+   @param send The buffer for each destination rank. Empty buffers are
+               not sent.
+
+   @return The buffer received from each source rank.
+
+   @ingroup coloring
+   */
+
+  template<typename TYPE>
+  std::map<size_t, std::vector<TYPE>>
+  sparse_exchange(const std::map<size_t, std::vector<TYPE>> & send) {
+    const size_t color = rank();
+    const auto mpi_type = flecsi::coloring::mpi_typetraits__<TYPE>::type();
+
+    const int tag = next_exchange_tag();
+
+    std::map<size_t, std::vector<TYPE>> recv;
+    std::vector<MPI_Request> requests;
+    requests.reserve(send.size());
+
+    for (auto & s : send) {
+      if (s.second.empty()) {
+        continue;
       } // if
+
+      if (s.first == color) {
+        recv[color] = s.second;
+        continue;
+      } // if
+
+      requests.push_back({});
+      MPI_Issend(
+          s.second.data(), s.second.size(), mpi_type, s.first, tag,
+          MPI_COMM_WORLD, &requests.back());
     } // for
 
-    // Wait on the receive operations
-    status.resize(requests.size());
-    MPI_Waitall(requests.size(), &requests[0], &status[0]);
+    MPI_Request barrier;
+    bool barrier_started = false;
 
-    std::vector<std::set<size_t>> remote(colors);
-    for (size_t r(0); r < colors; ++r) {
-      for (size_t i(0); i < send_cnts[r]; ++i) {
-        remote[r].insert(rbuffers[r][i]);
-      } // for
+    for (;;) {
+      int flag;
+      MPI_Status status;
+
+      MPI_Iprobe(MPI_ANY_SOURCE, tag, MPI_COMM_WORLD, &flag, &status);
+
+      if (flag) {
+        int count;
+        MPI_Get_count(&status, mpi_type, &count);
+
+        auto & buffer = recv[status.MPI_SOURCE];
+        buffer.resize(count);
+
+        MPI_Recv(
+            buffer.data(), count, mpi_type, status.MPI_SOURCE, tag,
+            MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+      } // if
+
+      if (barrier_started) {
+        MPI_Test(&barrier, &flag, MPI_STATUS_IGNORE);
+
+        if (flag) {
+          break;
+        } // if
+      } else {
+        MPI_Testall(
+            requests.size(), requests.data(), &flag, MPI_STATUSES_IGNORE);
+
+        if (flag) {
+          MPI_Ibarrier(MPI_COMM_WORLD, &barrier);
+          barrier_started = true;
+        } // if
+      } // if
     } // for
 
-    return remote;
-  } // get_entity_info
+    return recv;
+  } // sparse_exchange
 
   /*!
      Rerturn a map containing the coloring index and the number of indices
@@ -540,28 +516,12 @@ public:
       std::set<size_t> & request_indices,
       Lambda && function) {
     auto colors = size();
-    auto color = rank();
 
-    size_t max_request_indices = get_max_request_size(request_indices.size());
-
-    // Pad the request indices with size_t max. We will then set
-    // the indices of the actual request. Each rank that receives
-    // the request will try to provide information about the
-    // non size_t max values in the request. The others will
-    // be ignored.
-    std::vector<size_t> info_indices(colors * max_request_indices);
-    info_indices =
-        get_info_indices(request_indices, max_request_indices, colors);
+    auto indices = gather_indices(request_indices);
 
     for (size_t c(0); c < colors; ++c) {
-
-      size_t * info = &info_indices[c * max_request_indices];
-
-      for (size_t i(0); i < max_request_indices; ++i) {
-        if (info[i] != std::numeric_limits<size_t>::max()) {
-          const size_t value = info[i];
-          function(c, value);
-        } // if
+      for (auto value : indices[c]) {
+        function(c, value);
       } // for
     } // for
 
@@ -570,6 +530,9 @@ public:
   /*!
    gets coloring info between all MPI ranks
 
+   The shared users and the ghost owners of each color that are on the
+   same node, see \ref nodes, are also recorded separately.
+
    @param coloring_info Coloring info for one particular rank
 
    @ingroup coloring
@@ -609,37 +572,92 @@ public:
           coloring_info[c].ghost_owners.insert(value);
         });
 
+    // The users and owners that are on the same node as each color.
+    auto & node = nodes();
+
+    for (auto & ci : coloring_info) {
+      for (auto u : ci.second.shared_users) {
+        if (node[u] == node[ci.first]) {
+          ci.second.shared_users_on_node.insert(u);
+        } // if
+      } // for
+
+      for (auto o : ci.second.ghost_owners) {
+        if (node[o] == node[ci.first]) {
+          ci.second.ghost_owners_on_node.insert(o);
+        } // if
+      } // for
+    } // for
+
     return coloring_info;
   } // gather_coloring_info
 
+private:
+  /// The node of each rank, or empty if it has not been detected yet.
+  std::vector<size_t> nodes_;
+
+  /// Buffers of indices for each rank.
+  using exchange_t = std::map<size_t, std::vector<size_t>>;
+
+  /// Tag of the messages of sparse_exchange.
+  static constexpr int exchange_tag = 1700;
+
   /*!
-   Find maximum size for the "requested_indicies" - MPI reduction
+   Return the tag of the next sparse_exchange. A rank can start the next
+   exchange while others are still receiving, so consecutive exchanges
+   alternate between two tags. The counter is shared by the exchanges of
+   all value types and of all communicators, since they all use
+   MPI_COMM_WORLD.
+   */
 
-   @param request_indices request_indices for local MPI rank
+  static int next_exchange_tag() {
+    static size_t exchanges(0);
+    return exchange_tag + exchanges++ % 2;
+  } // next_exchange_tag
 
-   @return max_request_indices Maximum size for the "requested_indicies"
+  /*!
+   Gather the indices of every rank on all ranks.
+
+   @param indices The indices of the calling rank.
+
+   @return The indices of each rank.
 
    @ingroup coloring
    */
 
-  size_t get_max_request_size(size_t request_indices) {
-    size_t max_request_indices = 0;
+  std::vector<std::vector<size_t>>
+  gather_indices(const std::set<size_t> & indices) {
+    auto colors = size();
+
+    int count = indices.size();
+    std::vector<int> counts(colors);
+
+    MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+    std::vector<int> offsets(colors + 1, 0);
+    for (size_t c(0); c < colors; ++c) {
+      offsets[c + 1] = offsets[c] + counts[c];
+    } // for
 
-    // Get a valid MPI type for size_t.
     const auto mpi_size_t_type =
         flecsi::coloring::mpi_typetraits__<size_t>::type();
 
-    // This may be inefficient, but this call is doing a reduction
-    // to determine the maximum number of indices requested by any rank
-    // so that we can pad out the all-to-all communication below.
-    int result = MPI_Allreduce(
-        &request_indices, &max_request_indices, 1, mpi_size_t_type, MPI_MAX,
-        MPI_COMM_WORLD);
+    std::vector<size_t> input(indices.begin(), indices.end());
+    std::vector<size_t> buffer(offsets[colors]);
 
-    return max_request_indices;
-  } // get_max_request_size
+    MPI_Allgatherv(
+        input.data(), count, mpi_size_t_type, buffer.data(), counts.data(),
+        offsets.data(), mpi_size_t_type, MPI_COMM_WORLD);
+
+    std::vector<std::vector<size_t>> gathered(colors);
+    for (size_t c(0); c < colors; ++c) {
+      gathered[c].assign(
+          buffer.begin() + offsets[c], buffer.begin() + offsets[c + 1]);
+    } // for
+
+    return gathered;
+  } // gather_indices
 
-private:
 }; // class mpi_communicator_t
 
 } // namespace coloring
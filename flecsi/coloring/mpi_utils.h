@@ -23,6 +23,9 @@
 
 #include <mpi.h>
 
+#include <map>
+#include <vector>
+
 namespace flecsi {
 namespace coloring {
 
@@ -73,5 +76,45 @@ struct mpi_typetraits__<double> {
   }
 }; // mpi_typetraits__
 
+/*!
+ Return the node of each rank of MPI_COMM_WORLD. The ranks of a node are
+ those that can share memory, see MPI_Comm_split_type, and the nodes are
+ numbered in the order of their lowest rank.
+
+ This must be called by every rank.
+
+ @ingroup coloring
+ */
+
+inline std::vector<size_t>
+mpi_nodes() {
+  int size;
+  int rank;
+
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(
+      MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+
+  int leader = rank;
+  MPI_Allreduce(MPI_IN_PLACE, &leader, 1, MPI_INT, MPI_MIN, node_comm);
+  MPI_Comm_free(&node_comm);
+
+  std::vector<int> leaders(size);
+  MPI_Allgather(
+      &leader, 1, MPI_INT, leaders.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+  std::map<int, size_t> ids;
+  std::vector<size_t> nodes(size);
+
+  for (int r(0); r < size; ++r) {
+    nodes[r] = ids.emplace(leaders[r], ids.size()).first->second;
+  } // for
+
+  return nodes;
+} // mpi_nodes
+
 } // namespace coloring
 } // namespace flecsi
@@ -0,0 +1,318 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <flecsi/coloring/crs.h>
+#include <flecsi/coloring/sfc_colorer.h>
+#include <flecsi/topology/mesh_definition.h>
+
+namespace flecsi {
+namespace coloring {
+
+/*!
+ Create the graph of the given entities, e.g., of the primary cells of
+ a color. Two entities are adjacent if they share more than THRU_DIMENSION
+ vertices. Only the definitions of the given entities are read, and
+ their neighbors that are not in the list are ignored.
+
+ @tparam DIMENSION      The topological dimension of the entities.
+ @tparam THRU_DIMENSION The topological dimension through which the
+                        entities are adjacent.
+
+ @param md       The mesh definition.
+ @param entities The mesh ids of the entities.
+
+ @return The graph whose vertex i is entities[i].
+
+ @ingroup coloring
+ */
+
+template<size_t DIMENSION, size_t THRU_DIMENSION, size_t MESH_DIMENSION>
+crs_t
+make_crs(
+    const topology::mesh_definition__<MESH_DIMENSION> & md,
+    const std::vector<size_t> & entities) {
+  // The local entities that reference each vertex.
+  std::vector<std::vector<size_t>> definitions(entities.size());
+  std::unordered_map<size_t, std::vector<size_t>> referencers;
+
+  for (size_t i(0); i < entities.size(); ++i) {
+    definitions[i] = md.entities(DIMENSION, 0, entities[i]);
+
+    for (auto v : definitions[i]) {
+      referencers[v].push_back(i);
+    } // for
+  } // for
+
+  crs_t graph;
+  graph.offsets.reserve(entities.size() + 1);
+  graph.offsets.push_back(0);
+
+  std::unordered_map<size_t, size_t> shared;
+
+  for (size_t i(0); i < entities.size(); ++i) {
+    shared.clear();
+
+    for (auto v : definitions[i]) {
+      for (auto j : referencers[v]) {
+        if (j != i) {
+          ++shared[j];
+        } // if
+      } // for
+    } // for
+
+    const size_t begin = graph.indices.size();
+
+    for (auto & s : shared) {
+      if (s.second > THRU_DIMENSION) {
+        graph.indices.push_back(s.first);
+      } // if
+    } // for
+
+    std::sort(graph.indices.begin() + begin, graph.indices.end());
+    graph.offsets.push_back(graph.indices.size());
+  } // for
+
+  return graph;
+} // make_crs
+
+/*!
+ Compute the reverse Cuthill-McKee order of a graph, which reduces its
+ bandwidth. Each connected component is traversed breadth-first from a
+ pseudo-peripheral vertex, visiting the neighbors by increasing degree.
+
+ @param graph The graph, e.g., from \ref make_crs.
+
+ @return The vertices of the graph in the new order.
+
+ @ingroup coloring
+ */
+
+inline std::vector<size_t>
+reverse_cuthill_mckee(const crs_t & graph) {
+  const size_t n = graph.offsets.empty() ? 0 : graph.size();
+  constexpr size_t unvisited = std::numeric_limits<size_t>::max();
+
+  auto degree = [&](size_t v) {
+    return graph.offsets[v + 1] - graph.offsets[v];
+  };
+
+  // The depth of each vertex in the current breadth-first search. The
+  // searches for the start vertices are only used for their depth.
+  std::vector<size_t> depth(n, unvisited);
+  std::vector<size_t> queue;
+  queue.reserve(n);
+
+  // Return the height of the level structure rooted at the given vertex,
+  // and the vertex of minimum degree in its last level.
+  auto levels = [&](size_t root, size_t & last) {
+    queue.assign(1, root);
+    depth[root] = 0;
+
+    for (size_t head(0); head < queue.size(); ++head) {
+      const size_t v = queue[head];
+
+      for (size_t e(graph.offsets[v]); e < graph.offsets[v + 1]; ++e) {
+        const size_t u = graph.indices[e];
+
+        if (depth[u] == unvisited) {
+          depth[u] = depth[v] + 1;
+          queue.push_back(u);
+        } // if
+      } // for
+    } // for
+
+    const size_t height = depth[queue.back()];
+    last = queue.back();
+
+    for (auto v : queue) {
+      if (depth[v] == height && degree(v) < degree(last)) {
+        last = v;
+      } // if
+    } // for
+
+    for (auto v : queue) {
+      depth[v] = unvisited;
+    } // for
+
+    return height;
+  };
+
+  std::vector<size_t> starts(n);
+  std::iota(starts.begin(), starts.end(), 0);
+  std::stable_sort(starts.begin(), starts.end(),
+    [&](size_t a, size_t b) { return degree(a) < degree(b); });
+
+  std::vector<bool> visited(n, false);
+  std::vector<size_t> order;
+  order.reserve(n);
+
+  for (auto start : starts) {
+    if (visited[start]) {
+      continue;
+    } // if
+
+    // Find a pseudo-peripheral vertex of the component, following
+    // George and Liu.
+    size_t root = start;
+    size_t last;
+    size_t height = levels(root, last);
+
+    while (true) {
+      size_t next;
+      const size_t next_height = levels(last, next);
+
+      if (next_height <= height) {
+        break;
+      } // if
+
+      root = last;
+      height = next_height;
+      last = next;
+    } // while
+
+    // Cuthill-McKee traversal of the component.
+    const size_t begin = order.size();
+    order.push_back(root);
+    visited[root] = true;
+
+    for (size_t head(begin); head < order.size(); ++head) {
+      const size_t v = order[head];
+      const size_t tail = order.size();
+
+      for (size_t e(graph.offsets[v]); e < graph.offsets[v + 1]; ++e) {
+        const size_t u = graph.indices[e];
+
+        if (!visited[u]) {
+          visited[u] = true;
+          order.push_back(u);
+        } // if
+      } // for
+
+      std::stable_sort(order.begin() + tail, order.end(),
+        [&](size_t a, size_t b) { return degree(a) < degree(b); });
+    } // for
+  } // for
+
+  std::reverse(order.begin(), order.end());
+
+  return order;
+} // reverse_cuthill_mckee
+
+/*!
+ Compute the order of points along the Hilbert curve through their
+ bounding box.
+
+ @param points The points, e.g., the centroids of the entities.
+
+ @return The indices of the points in the new order.
+
+ @ingroup coloring
+ */
+
+template<size_t DIMENSION>
+std::vector<size_t>
+hilbert_order(const std::vector<point__<double, DIMENSION>> & points) {
+  using sfc_t = sfc_colorer__<DIMENSION>;
+  using key_t = typename sfc_t::key_t;
+
+  std::array<double, DIMENSION> lower;
+  std::array<double, DIMENSION> upper;
+  lower.fill(std::numeric_limits<double>::max());
+  upper.fill(std::numeric_limits<double>::lowest());
+
+  for (auto & p : points) {
+    for (size_t d(0); d < DIMENSION; ++d) {
+      lower[d] = std::min(lower[d], p[d]);
+      upper[d] = std::max(upper[d], p[d]);
+    } // for
+  } // for
+
+  const key_t cells = key_t(1) << sfc_t::bits;
+  std::vector<std::pair<key_t, size_t>> keys(points.size());
+
+  for (size_t i(0); i < points.size(); ++i) {
+    typename sfc_t::coordinates_t x;
+
+    for (size_t d(0); d < DIMENSION; ++d) {
+      const double extent = upper[d] - lower[d];
+      const double scaled =
+          extent > 0.0 ? (points[i][d] - lower[d]) / extent : 0.0;
+      x[d] = std::min(key_t(scaled * cells), cells - 1);
+    } // for
+
+    keys[i] = {sfc_t::encode(x, sfc_curve_t::hilbert), i};
+  } // for
+
+  std::sort(keys.begin(), keys.end());
+
+  std::vector<size_t> order;
+  order.reserve(keys.size());
+
+  for (auto & k : keys) {
+    order.push_back(k.second);
+  } // for
+
+  return order;
+} // hilbert_order
+
+/*!
+ Order the entities of one dimension after those of another, e.g., the
+ vertices after the cells, so that all the index spaces of a mesh are
+ renumbered consistently. The entities are ordered by their first
+ appearance in the definitions of the ordered entities.
+
+ @param md             The mesh definition.
+ @param from_dimension The dimension of the ordered entities.
+ @param to_dimension   The dimension of the entities to order.
+ @param from_order     The mesh ids of the ordered entities.
+
+ @return The mesh ids of the entities of to_dimension in the new order.
+
+ @ingroup coloring
+ */
+
+template<size_t MESH_DIMENSION>
+std::vector<size_t>
+induced_order(
+    const topology::mesh_definition__<MESH_DIMENSION> & md,
+    size_t from_dimension,
+    size_t to_dimension,
+    const std::vector<size_t> & from_order) {
+  std::vector<size_t> order;
+  std::unordered_set<size_t> ordered;
+
+  for (auto id : from_order) {
+    for (auto e : md.entities(from_dimension, to_dimension, id)) {
+      if (ordered.insert(e).second) {
+        order.push_back(e);
+      } // if
+    } // for
+  } // for
+
+  return order;
+} // induced_order
+
+} // namespace coloring
+} // namespace flecsi
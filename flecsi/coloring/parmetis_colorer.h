@@ -15,7 +15,11 @@
 
 /*! @file */
 
+#include <algorithm>
+#include <numeric>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 #include <cinchlog.h>
 
@@ -28,6 +32,7 @@
 #include <parmetis.h>
 
 #include <flecsi/coloring/colorer.h>
+#include <flecsi/coloring/dcrs_utils.h>
 #include <flecsi/coloring/mpi_utils.h>
 
 namespace flecsi {
@@ -40,9 +45,31 @@ namespace coloring {
 
 struct parmetis_colorer_t : public colorer_t {
   /*!
-   Default constructor
+   Constructor.
+
+   @param target_weight The share of the graph weight that the partition
+                        of the calling rank should receive, relative to
+                        the target weights of the other ranks, e.g., 2.0
+                        on a rank that is twice as fast as the others.
+                        Every rank must construct the colorer.
+   */
+  parmetis_colorer_t(double target_weight = 1.0)
+    : target_weight_(target_weight) {}
+
+  /*!
+   Partition the graph in two levels: first across the nodes, and then
+   across the ranks of each node. The edges that are cut by the first
+   level are the only ones between ranks on different nodes, so that
+   the halo traffic through the network is minimized before the halos
+   within the nodes.
+
+   @param nodes The node of each rank, e.g., from \ref mpi_nodes. Empty
+                to partition across the ranks directly, which is the
+                default. Every rank must pass the same nodes.
    */
-  parmetis_colorer_t() {}
+  void set_nodes(const std::vector<size_t> & nodes) {
+    nodes_ = nodes;
+  } // set_nodes
 
   /*!
    Copy constructor (disabled)
@@ -64,73 +91,73 @@ struct parmetis_colorer_t : public colorer_t {
    */
 
   std::set<size_t> color(const dcrs_t & dcrs) override {
+    return color(dcrs, {});
+  } // color
+
+  /*!
+   Color a weighted graph. The partitions balance the vertex weights
+   instead of the number of vertices, and minimize the weight of the cut
+   edges instead of their number.
+
+   @param dcrs           The graph to color.
+   @param vertex_weights The weights of the local vertices. With multiple
+                         constraints, the weights of each vertex are
+                         stored consecutively, and every constraint is
+                         balanced separately, e.g., the cost of the
+                         physics and the number of materials of a cell.
+                         Empty on every rank for uniform weights.
+   @param constraints    The number of weights of each vertex, which
+                         must be the same on every rank.
+   @param edge_weights   The weights of the local edges, in the order of
+                         dcrs.indices. Empty on every rank for uniform
+                         weights.
+   */
+
+  std::set<size_t> color(
+      const dcrs_t & dcrs,
+      const std::vector<size_t> & vertex_weights,
+      size_t constraints = 1,
+      const std::vector<size_t> & edge_weights = {}) {
     int size;
     int rank;
 
     MPI_Comm_size(MPI_COMM_WORLD, &size);
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
+    clog_assert(
+        vertex_weights.empty() ||
+            vertex_weights.size() == dcrs.size() * constraints,
+        "vertex weights do not match the number of vertices and constraints");
+    clog_assert(
+        edge_weights.empty() || edge_weights.size() == dcrs.indices.size(),
+        "edge weights do not match the number of edges");
+
     //------------------------------------------------------------------------//
     // Call ParMETIS partitioner.
     //------------------------------------------------------------------------//
 
-    idx_t wgtflag = 0;
-    idx_t numflag = 0;
-    idx_t ncon = 1;
-    std::vector<real_t> tpwgts(size);
-
-    real_t sum = 0.0;
-    for (size_t i(0); i < tpwgts.size(); ++i) {
-      if (i == (tpwgts.size() - 1)) {
-        tpwgts[i] = 1.0 - sum;
-      } else {
-        tpwgts[i] = 1.0 / size;
-        sum += tpwgts[i];
-      } // if
+    // The weights flag must be the same on all ranks, including the ones
+    // without vertices.
+    int weighted[] = {!vertex_weights.empty(), !edge_weights.empty()};
+    MPI_Allreduce(MPI_IN_PLACE, weighted, 2, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
 
-#if 0
-      if(rank == 0) {
-        std::cout << tpwgts[i] << std::endl;
-      } // if
-#endif
-    } // for
-
-    // We may need to expose some of the ParMETIS configuration options.
-    real_t ubvec = 1.05;
-    idx_t options = 0;
-    idx_t edgecut;
-    MPI_Comm comm = MPI_COMM_WORLD;
-    std::vector<idx_t> part(dcrs.size(), std::numeric_limits<idx_t>::max());
+    idx_t ncon = weighted[0] ? constraints : 1;
 
-#if 0
-    const size_t output_rank(1);
-    if(rank == output_rank) {
-      std::cout << "rank " << rank << " dcrs: " << std::endl;
-      std::cout << "size: " << dcrs.size() << std::endl;
-      std::cout << dcrs << std::endl;
-    } // if
-#endif
+    // Gather the target weights of all ranks.
+    std::vector<double> targets(size);
+    MPI_Allgather(
+        &target_weight_, 1, MPI_DOUBLE, targets.data(), 1, MPI_DOUBLE,
+        MPI_COMM_WORLD);
 
-    //    std::set<size_t> ret;
-    //    return ret;
+    // The rank of each local vertex.
+    std::vector<idx_t> part = nodes_.empty()
+        ? partition(dcrs, vertex_weights, edge_weights, weighted, ncon,
+              targets, MPI_COMM_WORLD)
+        : partition_by_node(
+              dcrs, vertex_weights, edge_weights, weighted, ncon, targets);
 
-    // Get the dCRS information using ParMETIS types.
     std::vector<idx_t> vtxdist = dcrs.distribution_as<idx_t>();
-    std::vector<idx_t> xadj = dcrs.offsets_as<idx_t>();
-    std::vector<idx_t> adjncy = dcrs.indices_as<idx_t>();
-
-    // Actual call to ParMETIS.
-    int result = ParMETIS_V3_PartKway(
-        &vtxdist[0], &xadj[0], &adjncy[0], nullptr, nullptr, &wgtflag, &numflag,
-        &ncon, &size, &tpwgts[0], &ubvec, &options, &edgecut, &part[0], &comm);
-
-#if 0
-    std::cout << "rank " << rank << ": ";
-    for(size_t i(0); i<dcrs.size(); ++i) {
-      std::cout << "[" << part[i] << ", " << vtxdist[rank]+i << "] ";
-    } // for
-    std::cout << std::endl;
-#endif
+    int result;
 
     //------------------------------------------------------------------------//
     // Exchange information with other ranks.
@@ -244,6 +271,289 @@ struct parmetis_colorer_t : public colorer_t {
     return primary;
   } // color
 
+private:
+  /*!
+   Partition a distributed graph with ParMETIS into one part for each of
+   the given target weights.
+
+   @param comm The communicator over which the graph is distributed.
+
+   @return The part of each local vertex.
+   */
+
+  static std::vector<idx_t> partition(
+      const dcrs_t & dcrs,
+      const std::vector<size_t> & vertex_weights,
+      const std::vector<size_t> & edge_weights,
+      const int (&weighted)[2],
+      idx_t ncon,
+      const std::vector<double> & targets,
+      MPI_Comm comm) {
+    idx_t nparts = targets.size();
+    std::vector<idx_t> part(dcrs.size(), 0);
+
+    if (nparts == 1) {
+      return part;
+    } // if
+
+    idx_t wgtflag = 2 * weighted[0] + weighted[1];
+    idx_t numflag = 0;
+
+    // Normalize the target weights, so that the targets of each
+    // constraint sum to one.
+    const double total = std::accumulate(targets.begin(), targets.end(), 0.0);
+    std::vector<real_t> tpwgts(nparts * ncon);
+
+    for (size_t i(0); i < nparts; ++i) {
+      for (size_t c(0); c < ncon; ++c) {
+        tpwgts[i * ncon + c] = targets[i] / total;
+      } // for
+    } // for
+
+    // We may need to expose some of the ParMETIS configuration options.
+    std::vector<real_t> ubvec(ncon, 1.05);
+    idx_t options = 0;
+    idx_t edgecut;
+
+#if 0
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    const size_t output_rank(1);
+    if(rank == output_rank) {
+      std::cout << "rank " << rank << " dcrs: " << std::endl;
+      std::cout << "size: " << dcrs.size() << std::endl;
+      std::cout << dcrs << std::endl;
+    } // if
+#endif
+
+    // Get the dCRS information using ParMETIS types.
+    std::vector<idx_t> vtxdist = dcrs.distribution_as<idx_t>();
+    std::vector<idx_t> xadj = dcrs.offsets_as<idx_t>();
+    std::vector<idx_t> adjncy = dcrs.indices_as<idx_t>();
+
+    // Ranks without vertices or edges still need valid arrays.
+    std::vector<idx_t> vwgt(vertex_weights.begin(), vertex_weights.end());
+    std::vector<idx_t> adjwgt(edge_weights.begin(), edge_weights.end());
+    vwgt.reserve(1);
+    adjwgt.reserve(1);
+    adjncy.reserve(1);
+    part.reserve(1);
+
+    // Actual call to ParMETIS.
+    ParMETIS_V3_PartKway(
+        &vtxdist[0], &xadj[0], adjncy.data(),
+        weighted[0] ? vwgt.data() : nullptr,
+        weighted[1] ? adjwgt.data() : nullptr, &wgtflag, &numflag, &ncon,
+        &nparts, &tpwgts[0], &ubvec[0], &options, &edgecut, part.data(),
+        &comm);
+
+#if 0
+    std::cout << "rank " << rank << ": ";
+    for(size_t i(0); i<dcrs.size(); ++i) {
+      std::cout << "[" << part[i] << ", " << vtxdist[rank]+i << "] ";
+    } // for
+    std::cout << std::endl;
+#endif
+
+    return part;
+  } // partition
+
+  /*!
+   Partition a distributed graph across the nodes, and then across the
+   ranks of each node, see \ref set_nodes.
+
+   @return The rank of each local vertex.
+   */
+
+  std::vector<idx_t> partition_by_node(
+      const dcrs_t & dcrs,
+      const std::vector<size_t> & vertex_weights,
+      const std::vector<size_t> & edge_weights,
+      const int (&weighted)[2],
+      idx_t ncon,
+      const std::vector<double> & targets) {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    const size_t size = targets.size();
+
+    clog_assert(nodes_.size() == size, "invalid number of nodes");
+
+    const size_t num_nodes =
+        *std::max_element(nodes_.begin(), nodes_.end()) + 1;
+    const size_t node = nodes_[rank];
+
+    // The ranks of each node, in increasing order.
+    std::vector<std::vector<size_t>> members(num_nodes);
+
+    for (size_t r(0); r < size; ++r) {
+      members[nodes_[r]].push_back(r);
+    } // for
+
+    //------------------------------------------------------------------------//
+    // Partition the graph across the nodes. The target weight of a node
+    // is the sum of the targets of its ranks.
+    //------------------------------------------------------------------------//
+
+    std::vector<double> node_targets(num_nodes, 0.0);
+
+    for (size_t r(0); r < size; ++r) {
+      node_targets[nodes_[r]] += targets[r];
+    } // for
+
+    auto node_part = partition(dcrs, vertex_weights, edge_weights, weighted,
+        ncon, node_targets, MPI_COMM_WORLD);
+
+    //------------------------------------------------------------------------//
+    // Send each vertex to a rank of its node with its weights and edges,
+    // packed as: id, weights, degree, and the edges with their weights.
+    //------------------------------------------------------------------------//
+
+    const size_t num_weights = weighted[0] ? ncon : 0;
+    std::vector<std::vector<size_t>> send(size);
+
+    for (size_t i(0); i < dcrs.size(); ++i) {
+      const size_t id = dcrs.distribution[rank] + i;
+      const auto & ranks = members[node_part[i]];
+      auto & buffer = send[ranks[id % ranks.size()]];
+
+      buffer.push_back(id);
+
+      for (size_t c(0); c < num_weights; ++c) {
+        buffer.push_back(vertex_weights[i * ncon + c]);
+      } // for
+
+      buffer.push_back(dcrs.offsets[i + 1] - dcrs.offsets[i]);
+
+      for (size_t e(dcrs.offsets[i]); e < dcrs.offsets[i + 1]; ++e) {
+        buffer.push_back(dcrs.indices[e]);
+
+        if (weighted[1]) {
+          buffer.push_back(edge_weights[e]);
+        } // if
+      } // for
+    } // for
+
+    auto received = alltoallv(send);
+
+    std::vector<size_t> ids;
+    std::vector<size_t> weights;
+    crs_t edges;
+    std::vector<size_t> weights_of_edges;
+
+    edges.offsets.push_back(0);
+
+    for (size_t k(0); k < received.size();) {
+      ids.push_back(received[k++]);
+
+      for (size_t c(0); c < num_weights; ++c) {
+        weights.push_back(received[k++]);
+      } // for
+
+      const size_t degree = received[k++];
+
+      for (size_t d(0); d < degree; ++d) {
+        edges.indices.push_back(received[k++]);
+
+        if (weighted[1]) {
+          weights_of_edges.push_back(received[k++]);
+        } // if
+      } // for
+
+      edges.offsets.push_back(edges.indices.size());
+    } // for
+
+    //------------------------------------------------------------------------//
+    // Number the vertices of the node consecutively, in the order of the
+    // ranks of the node, and keep the edges within the node.
+    //------------------------------------------------------------------------//
+
+    MPI_Comm node_comm;
+    MPI_Comm_split(MPI_COMM_WORLD, node, rank, &node_comm);
+
+    int node_size;
+    MPI_Comm_size(node_comm, &node_size);
+
+    int count = ids.size();
+    std::vector<int> counts(node_size);
+    MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, node_comm);
+
+    std::vector<int> displs(node_size + 1, 0);
+    std::partial_sum(counts.begin(), counts.end(), displs.begin() + 1);
+
+    std::vector<size_t> node_ids(displs[node_size]);
+    MPI_Allgatherv(ids.data(), count, mpi_typetraits__<size_t>::type(),
+        node_ids.data(), counts.data(), displs.data(),
+        mpi_typetraits__<size_t>::type(), node_comm);
+
+    std::unordered_map<size_t, size_t> local;
+
+    for (size_t i(0); i < node_ids.size(); ++i) {
+      local[node_ids[i]] = i;
+    } // for
+
+    dcrs_t graph;
+    graph.distribution.assign(displs.begin(), displs.end());
+    graph.offsets.push_back(0);
+
+    std::vector<size_t> graph_edge_weights;
+
+    for (size_t i(0); i < ids.size(); ++i) {
+      for (size_t e(edges.offsets[i]); e < edges.offsets[i + 1]; ++e) {
+        auto it = local.find(edges.indices[e]);
+
+        if (it != local.end()) {
+          graph.indices.push_back(it->second);
+
+          if (weighted[1]) {
+            graph_edge_weights.push_back(weights_of_edges[e]);
+          } // if
+        } // if
+      } // for
+
+      graph.offsets.push_back(graph.indices.size());
+    } // for
+
+    //------------------------------------------------------------------------//
+    // Partition the graph of the node across its ranks, and return the
+    // rank of each vertex to the rank that it came from.
+    //------------------------------------------------------------------------//
+
+    std::vector<double> rank_targets;
+
+    for (auto r : members[node]) {
+      rank_targets.push_back(targets[r]);
+    } // for
+
+    auto rank_part = partition(graph, weights, graph_edge_weights, weighted,
+        ncon, rank_targets, node_comm);
+
+    MPI_Comm_free(&node_comm);
+
+    std::vector<std::vector<size_t>> replies(size);
+
+    for (size_t i(0); i < ids.size(); ++i) {
+      const size_t origin = std::upper_bound(dcrs.distribution.begin(),
+                                dcrs.distribution.end(), ids[i]) -
+                            dcrs.distribution.begin() - 1;
+      replies[origin].push_back(ids[i]);
+      replies[origin].push_back(members[node][rank_part[i]]);
+    } // for
+
+    auto owners = alltoallv(replies);
+
+    std::vector<idx_t> part(dcrs.size());
+
+    for (size_t k(0); k < owners.size(); k += 2) {
+      part[owners[k] - dcrs.distribution[rank]] = owners[k + 1];
+    } // for
+
+    return part;
+  } // partition_by_node
+
+  double target_weight_;
+  std::vector<size_t> nodes_;
+
 }; // struct parmetis_colorer_t
 
 } // namespace coloring
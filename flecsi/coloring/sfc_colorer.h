@@ -0,0 +1,441 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <cinchlog.h>
+
+#include <flecsi-config.h>
+
+#if !defined(FLECSI_ENABLE_MPI)
+#error FLECSI_ENABLE_MPI not defined! This file depends on MPI!
+#endif
+
+#include <mpi.h>
+
+#include <flecsi/coloring/colorer.h>
+#include <flecsi/coloring/dcrs_utils.h>
+#include <flecsi/geometry/point.h>
+
+namespace flecsi {
+namespace coloring {
+
+/*!
+  The space-filling curves supported by \ref sfc_colorer__.
+ */
+
+enum class sfc_curve_t { morton, hilbert };
+
+/*!
+  The sfc_colorer__ type provides a geometric implementation of the
+  colorer_t interface. The entities are sorted along a space-filling
+  curve through their centroids, and the curve is cut into contiguous
+  pieces of equal weight. This does not minimize the edge cut like
+  ParMETIS does, but it is much cheaper, does not need the graph, and
+  produces compact partitions, which makes it suitable for frequent
+  repartitioning.
+
+  The curve is sorted with a distributed sample sort: every rank sorts
+  its keys, contributes samples at the quantiles of its local weight,
+  and the splitters are chosen among the samples using their global
+  prefix weights.
+
+  @tparam DIMENSION The dimension of the centroids.
+
+  @ingroup coloring
+ */
+
+template<size_t DIMENSION>
+struct sfc_colorer__ : public colorer_t {
+  using point_t = point__<double, DIMENSION>;
+  using key_t = uint64_t;
+  using coordinates_t = std::array<key_t, DIMENSION>;
+
+  /*!
+   The number of bits of each coordinate in the keys. The keys have at
+   most 63 bits, and the coordinates are limited to the precision of a
+   double.
+   */
+  static constexpr size_t bits =
+      std::min(size_t(63) / DIMENSION, size_t(52));
+
+  /*!
+   Constructor.
+
+   @param centroids     The centroids of the local entities, in the
+                        order of their indices.
+   @param weights       The weights of the local entities, e.g., their
+                        cost. Empty for uniform weights.
+   @param curve         The space-filling curve to use.
+   @param target_weight The share of the total weight that the partition
+                        of the calling rank should receive, relative to
+                        the target weights of the other ranks. See
+                        \ref parmetis_colorer_t.
+
+   Every rank must construct the colorer.
+   */
+  sfc_colorer__(
+      const std::vector<point_t> & centroids,
+      const std::vector<double> & weights = {},
+      sfc_curve_t curve = sfc_curve_t::hilbert,
+      double target_weight = 1.0)
+    : centroids_(centroids), weights_(weights), curve_(curve),
+      target_weight_(target_weight) {
+    clog_assert(
+        weights_.empty() || weights_.size() == centroids_.size(),
+        "weights do not match the number of centroids");
+  } // sfc_colorer__
+
+  /*!
+   Copy constructor (disabled)
+   */
+  sfc_colorer__(const sfc_colorer__ &) = delete;
+
+  /*!
+   Assignment operator (disabled)
+   */
+  sfc_colorer__ & operator=(const sfc_colorer__ &) = delete;
+
+  /*!
+    Destructor
+   */
+  ~sfc_colorer__() {}
+
+  /*!
+   Implementation of color method. See \ref colorer_t::color. Only the
+   distribution of the graph is used: the centroids are those of the
+   vertices owned by the calling rank.
+   */
+
+  std::set<size_t> color(const dcrs_t & dcrs) override {
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    std::vector<size_t> indices(
+        dcrs.distribution[rank + 1] - dcrs.distribution[rank]);
+    std::iota(indices.begin(), indices.end(), dcrs.distribution[rank]);
+
+    return color(indices);
+  } // color
+
+  /*!
+   Color the entities with the given indices, e.g., the ones of a \ref
+   naive_coloring.
+
+   @param indices The indices of the centroids.
+
+   @return The set of indices that belong to the calling rank.
+   */
+
+  std::set<size_t> color(const std::set<size_t> & indices) {
+    return color(std::vector<size_t>(indices.begin(), indices.end()));
+  } // color
+
+  /*!
+   Color the entities with the given indices.
+
+   @param indices The indices of the centroids.
+
+   @return The set of indices that belong to the calling rank.
+   */
+
+  std::set<size_t> color(const std::vector<size_t> & indices) {
+    int size;
+    int rank;
+
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    const size_t n = centroids_.size();
+
+    clog_assert(
+        indices.size() == n, "indices do not match the number of centroids");
+
+    //------------------------------------------------------------------------//
+    // Compute the keys of the local entities in the global bounding box.
+    //------------------------------------------------------------------------//
+
+    std::array<double, DIMENSION> lower;
+    std::array<double, DIMENSION> upper;
+    lower.fill(std::numeric_limits<double>::max());
+    upper.fill(std::numeric_limits<double>::lowest());
+
+    for (auto & c : centroids_) {
+      for (size_t d(0); d < DIMENSION; ++d) {
+        lower[d] = std::min(lower[d], c[d]);
+        upper[d] = std::max(upper[d], c[d]);
+      } // for
+    } // for
+
+    MPI_Allreduce(
+        MPI_IN_PLACE, lower.data(), DIMENSION, MPI_DOUBLE, MPI_MIN,
+        MPI_COMM_WORLD);
+    MPI_Allreduce(
+        MPI_IN_PLACE, upper.data(), DIMENSION, MPI_DOUBLE, MPI_MAX,
+        MPI_COMM_WORLD);
+
+    // The items are ordered by key, and by index for equal keys, so that
+    // the order is total.
+    using item_t = std::pair<key_t, size_t>;
+
+    const key_t cells = key_t(1) << bits;
+    std::vector<item_t> items(n);
+    std::vector<double> weights(n);
+
+    {
+      std::vector<size_t> order(n);
+      std::iota(order.begin(), order.end(), 0);
+
+      std::vector<item_t> unsorted(n);
+
+      for (size_t i(0); i < n; ++i) {
+        coordinates_t x;
+
+        for (size_t d(0); d < DIMENSION; ++d) {
+          const double extent = upper[d] - lower[d];
+          const double scaled = extent > 0.0
+                                    ? (centroids_[i][d] - lower[d]) / extent
+                                    : 0.0;
+          x[d] = std::min(key_t(scaled * cells), cells - 1);
+        } // for
+
+        unsorted[i] = {encode(x, curve_), indices[i]};
+      } // for
+
+      std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return unsorted[a] < unsorted[b];
+      });
+
+      for (size_t i(0); i < n; ++i) {
+        items[i] = unsorted[order[i]];
+        weights[i] = weights_.empty() ? 1.0 : weights_[order[i]];
+      } // for
+    } // scope
+
+    // The weight of the local items before each item.
+    std::vector<double> prefix(n + 1, 0.0);
+    std::partial_sum(weights.begin(), weights.end(), prefix.begin() + 1);
+
+    //------------------------------------------------------------------------//
+    // Gather samples at the quantiles of the local weights.
+    //------------------------------------------------------------------------//
+
+    std::vector<key_t> samples;
+
+    if (n > 0) {
+      samples.reserve(2 * samples_per_rank);
+
+      for (size_t s(1); s <= samples_per_rank; ++s) {
+        const double target = prefix[n] * s / (samples_per_rank + 1);
+        const size_t i = std::min(
+            size_t(
+                std::upper_bound(prefix.begin() + 1, prefix.end(), target) -
+                (prefix.begin() + 1)),
+            n - 1);
+        samples.push_back(items[i].first);
+        samples.push_back(items[i].second);
+      } // for
+    } // if
+
+    int count = samples.size();
+    std::vector<int> counts(size);
+    MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT,
+      MPI_COMM_WORLD);
+
+    std::vector<int> offsets(size + 1, 0);
+    std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+
+    std::vector<key_t> gathered(offsets[size]);
+    MPI_Allgatherv(
+        samples.data(), count, MPI_UINT64_T, gathered.data(), counts.data(),
+        offsets.data(), MPI_UINT64_T, MPI_COMM_WORLD);
+
+    // The sentinels bound the curve, so that every boundary has a
+    // candidate on either side.
+    std::vector<item_t> candidates = {
+        {0, 0},
+        {std::numeric_limits<key_t>::max(),
+         std::numeric_limits<size_t>::max()}};
+
+    for (size_t i(0); i < gathered.size(); i += 2) {
+      candidates.emplace_back(gathered[i], gathered[i + 1]);
+    } // for
+
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(
+        std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    //------------------------------------------------------------------------//
+    // Compute the global weight before each candidate and choose the
+    // splitters closest to the target boundaries.
+    //------------------------------------------------------------------------//
+
+    std::vector<double> before(candidates.size());
+
+    for (size_t c(0); c < candidates.size(); ++c) {
+      before[c] = prefix[std::lower_bound(
+                             items.begin(), items.end(), candidates[c]) -
+                         items.begin()];
+    } // for
+
+    MPI_Allreduce(
+        MPI_IN_PLACE, before.data(), before.size(), MPI_DOUBLE, MPI_SUM,
+        MPI_COMM_WORLD);
+
+    std::vector<double> targets(size);
+    MPI_Allgather(
+        &target_weight_, 1, MPI_DOUBLE, targets.data(), 1, MPI_DOUBLE,
+        MPI_COMM_WORLD);
+
+    const double total_target =
+        std::accumulate(targets.begin(), targets.end(), 0.0);
+    const double total_weight = before.back();
+
+    // Rank r receives the items in [splitters[r-1], splitters[r]).
+    std::vector<item_t> splitters;
+    splitters.reserve(size - 1);
+
+    double cumulative(0.0);
+    size_t c(0);
+
+    for (size_t r(0); r + 1 < size_t(size); ++r) {
+      cumulative += targets[r];
+      const double boundary = total_weight * cumulative / total_target;
+
+      while (c + 1 < before.size() && before[c + 1] <= boundary) {
+        ++c;
+      } // while
+
+      const bool next = c + 1 < before.size() &&
+                        before[c + 1] - boundary < boundary - before[c];
+
+      splitters.push_back(candidates[next ? c + 1 : c]);
+    } // for
+
+    //------------------------------------------------------------------------//
+    // Send the indices to their new owners.
+    //------------------------------------------------------------------------//
+
+    std::vector<std::vector<size_t>> send(size);
+
+    for (auto & item : items) {
+      const size_t r =
+          std::upper_bound(splitters.begin(), splitters.end(), item) -
+          splitters.begin();
+      send[r].push_back(item.second);
+    } // for
+
+    std::vector<size_t> received = alltoallv(send);
+
+    return std::set<size_t>(received.begin(), received.end());
+  } // color
+
+  /*!
+   Return the key of a point on the given curve.
+
+   @param x     The integer coordinates of the point, each less than
+                2^bits.
+   @param curve The space-filling curve.
+   */
+
+  static key_t encode(coordinates_t x, sfc_curve_t curve) {
+    if (curve == sfc_curve_t::hilbert && DIMENSION > 1) {
+      transpose_hilbert(x);
+    } // if
+
+    // Interleave the bits of the coordinates, from the most significant
+    // ones. For the Morton curve, bit i of coordinate d is stored at
+    // position i * DIMENSION + d, as in the branch ids of the tree
+    // topology. The transposed Hilbert index stores its most significant
+    // bits in the first coordinate.
+    key_t key(0);
+
+    for (size_t b(bits); b-- > 0;) {
+      for (size_t d(0); d < DIMENSION; ++d) {
+        const size_t j = curve == sfc_curve_t::hilbert ? d : DIMENSION - 1 - d;
+        key = (key << 1) | ((x[j] >> b) & 1);
+      } // for
+    } // for
+
+    return key;
+  } // encode
+
+private:
+  /*!
+   Convert coordinates to the transposed Hilbert index in place, see
+   J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707
+   (2004).
+   */
+
+  static void transpose_hilbert(coordinates_t & x) {
+    const key_t m = key_t(1) << (bits - 1);
+
+    // Inverse undo.
+    for (key_t q(m); q > 1; q >>= 1) {
+      const key_t p = q - 1;
+
+      for (size_t d(0); d < DIMENSION; ++d) {
+        if (x[d] & q) {
+          x[0] ^= p;
+        }
+        else {
+          const key_t t = (x[0] ^ x[d]) & p;
+          x[0] ^= t;
+          x[d] ^= t;
+        } // if
+      } // for
+    } // for
+
+    // Gray encode.
+    for (size_t d(1); d < DIMENSION; ++d) {
+      x[d] ^= x[d - 1];
+    } // for
+
+    key_t t(0);
+
+    for (key_t q(m); q > 1; q >>= 1) {
+      if (x[DIMENSION - 1] & q) {
+        t ^= q - 1;
+      } // if
+    } // for
+
+    for (size_t d(0); d < DIMENSION; ++d) {
+      x[d] ^= t;
+    } // for
+  } // transpose_hilbert
+
+  // The number of samples that each rank contributes to the choice of
+  // the splitters. The imbalance is at most about the local weight
+  // divided by this number.
+  static constexpr size_t samples_per_rank = 64;
+
+  std::vector<point_t> centroids_;
+  std::vector<double> weights_;
+  sfc_curve_t curve_;
+  double target_weight_;
+
+}; // struct sfc_colorer__
+
+} // namespace coloring
+} // namespace flecsi
@@ -0,0 +1,117 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include <sstream>
+
+#include <flecsi/coloring/coloring_cache.h>
+#include <flecsi/coloring/dcrs_utils.h>
+#include <flecsi/coloring/entity_coloring.h>
+#include <flecsi/io/simple_definition.h>
+
+namespace cache = flecsi::coloring::cache;
+
+TEST(coloring_cache, round_trip) {
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+  flecsi::coloring::mpi_communicator_t communicator;
+
+  auto primary = flecsi::coloring::naive_coloring<2, 2>(sd);
+  auto colorings =
+      flecsi::coloring::color_entities(sd, communicator, primary, {0});
+
+  std::map<size_t, flecsi::coloring::index_coloring_t> index_colorings;
+  std::map<size_t, std::unordered_map<size_t, flecsi::coloring::coloring_info_t>>
+      coloring_info;
+
+  for (auto & c : colorings) {
+    index_colorings[c.first] = c.second.coloring;
+    index_colorings[c.first].entities_per_rank[communicator.rank()] =
+        c.second.coloring.primary.size();
+    coloring_info[c.first] =
+        communicator.gather_coloring_info(c.second.info);
+  } // for
+
+  std::map<size_t, flecsi::coloring::adjacency_info_t> adjacency_info;
+  adjacency_info[2] = {2, 0, 1, {4, 8, 12}};
+
+  std::stringstream stream;
+  cache::write(stream, index_colorings);
+  cache::write(stream, coloring_info);
+  cache::write(stream, adjacency_info);
+
+  decltype(index_colorings) read_colorings;
+  decltype(coloring_info) read_info;
+  decltype(adjacency_info) read_adjacency;
+
+  cache::read(stream, read_colorings);
+  cache::read(stream, read_info);
+  cache::read(stream, read_adjacency);
+
+  ASSERT_TRUE(stream.good());
+  ASSERT_EQ(read_colorings.size(), 2);
+
+  for (auto & c : index_colorings) {
+    auto & r = read_colorings.at(c.first);
+
+    // The entities are compared with their offsets and users.
+    ASSERT_TRUE(r == c.second);
+    ASSERT_EQ(r.entities_per_rank, c.second.entities_per_rank);
+  } // for
+
+  for (auto & is : coloring_info) {
+    for (auto & ci : is.second) {
+      auto & r = read_info.at(is.first).at(ci.first);
+
+      ASSERT_EQ(r.exclusive, ci.second.exclusive);
+      ASSERT_EQ(r.shared, ci.second.shared);
+      ASSERT_EQ(r.ghost, ci.second.ghost);
+      ASSERT_EQ(r.shared_users, ci.second.shared_users);
+      ASSERT_EQ(r.ghost_owners, ci.second.ghost_owners);
+
+      // The ranks on the same node depend on the placement of the run.
+      ASSERT_TRUE(r.shared_users_on_node.empty());
+      ASSERT_TRUE(r.ghost_owners_on_node.empty());
+    } // for
+  } // for
+
+  ASSERT_EQ(read_adjacency.at(2).color_sizes,
+    std::vector<size_t>({4, 8, 12}));
+
+  // A truncated stream fails instead of returning partial data.
+  std::string bytes = stream.str();
+  std::stringstream truncated(bytes.substr(0, bytes.size() / 2));
+  cache::read(truncated, read_colorings);
+  cache::read(truncated, read_info);
+  ASSERT_FALSE(truncated.good());
+} // TEST
+
+TEST(coloring_cache, file_names) {
+  ASSERT_EQ(flecsi::coloring::coloring_cache_file("cache", 0xabc, 16, 3),
+    "cache/coloring-0000000000000abc-16.3");
+} // TEST
+
+TEST(coloring_cache, mesh_checksum) {
+  flecsi::io::simple_definition_t sd8("simple2d-8x8.msh");
+  flecsi::io::simple_definition_t sd16("simple2d-16x16.msh");
+
+  const size_t checksum = flecsi::coloring::mesh_checksum(sd16);
+
+  ASSERT_NE(checksum, flecsi::coloring::mesh_checksum(sd8));
+  ASSERT_EQ(checksum, flecsi::coloring::mesh_checksum(sd16));
+
+  // All of the ranks have the same checksum.
+  size_t checksums[2] = {checksum, ~checksum};
+  MPI_Allreduce(MPI_IN_PLACE, checksums, 2, MPI_UINT64_T, MPI_MAX,
+    MPI_COMM_WORLD);
+  ASSERT_EQ(checksums[0], checksum);
+  ASSERT_EQ(~checksums[1], checksum);
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
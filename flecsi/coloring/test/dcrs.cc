@@ -6,6 +6,8 @@
 #include <cinchtest.h>
 #include <mpi.h>
 
+#include <algorithm>
+
 #include <flecsi/coloring/dcrs_utils.h>
 #include <flecsi/io/simple_definition.h>
 
@@ -59,6 +61,46 @@ TEST(dcrs, simple2d_16x16) {
 
 } // TEST
 
+TEST(dcrs, distributed) {
+
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+  auto dcrs = flecsi::coloring::make_dcrs(sd);
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  // Build the neighbors of the local cells from the global mesh, i.e.,
+  // the cells that share at least two vertices.
+  std::vector<size_t> offsets = {0};
+  std::vector<size_t> indices;
+
+  for (size_t cell(dcrs.distribution[rank]);
+       cell < dcrs.distribution[rank + 1]; ++cell) {
+    auto vertices = sd.entities(2, 0, cell);
+    std::sort(vertices.begin(), vertices.end());
+
+    for (size_t other(0); other < sd.num_entities(2); ++other) {
+      if (other == cell)
+        continue;
+
+      size_t shared(0);
+      for (auto v : sd.entities(2, 0, other)) {
+        shared += std::binary_search(vertices.begin(), vertices.end(), v);
+      } // for
+
+      if (shared > 1)
+        indices.push_back(other);
+    } // for
+
+    offsets.push_back(indices.size());
+  } // for
+
+  CINCH_ASSERT(EQ, dcrs.distribution.back(), sd.num_entities(2));
+  CINCH_ASSERT(EQ, dcrs.offsets, offsets);
+  CINCH_ASSERT(EQ, dcrs.indices, indices);
+
+} // TEST
+
 /*----------------------------------------------------------------------------*
  * Cinch test Macros
  *
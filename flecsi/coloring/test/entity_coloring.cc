@@ -0,0 +1,137 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include <flecsi/coloring/dcrs_utils.h>
+#include <flecsi/coloring/entity_coloring.h>
+#include <flecsi/io/simple_definition.h>
+
+using flecsi::coloring::entity_info_t;
+
+// The ids of a set of entities.
+std::set<size_t>
+ids(const std::set<entity_info_t> & entities) {
+  std::set<size_t> result;
+
+  for (auto & e : entities) {
+    result.insert(e.id);
+  } // for
+
+  return result;
+} // ids
+
+// Check the coloring of one dimension against the primary and ghost
+// entities of every rank.
+void
+check_coloring(
+    flecsi::coloring::mpi_communicator_t & communicator,
+    const flecsi::coloring::entity_coloring_t & entities,
+    const std::set<size_t> & expected_primary,
+    const std::set<size_t> & expected_ghost) {
+  auto & coloring = entities.coloring;
+
+  auto primary =
+      flecsi::utils::set_union(ids(coloring.exclusive), ids(coloring.shared));
+  ASSERT_EQ(primary, expected_primary);
+  ASSERT_EQ(coloring.primary, expected_primary);
+  ASSERT_EQ(ids(coloring.ghost), expected_ghost);
+
+  auto all_primary = communicator.get_entity_reduction(primary);
+  auto all_ghost = communicator.get_entity_reduction(expected_ghost);
+
+  // The ghosts are owned by the ranks that have them as primary.
+  for (auto & g : coloring.ghost) {
+    ASSERT_EQ(all_primary[g.rank].count(g.id), 1);
+  } // for
+
+  // The shared entities are shared with exactly the ranks that have
+  // them as ghosts.
+  for (auto & e : coloring.shared) {
+    std::set<size_t> users;
+
+    for (auto & g : all_ghost) {
+      if (g.second.count(e.id)) {
+        users.insert(g.first);
+      } // if
+    } // for
+
+    ASSERT_EQ(e.shared, users);
+  } // for
+
+  for (auto & e : coloring.exclusive) {
+    for (auto & g : all_ghost) {
+      ASSERT_EQ(g.second.count(e.id), 0);
+    } // for
+  } // for
+
+  ASSERT_EQ(entities.info.exclusive, coloring.exclusive.size());
+  ASSERT_EQ(entities.info.shared, coloring.shared.size());
+  ASSERT_EQ(entities.info.ghost, coloring.ghost.size());
+} // check_coloring
+
+TEST(entity_coloring, two_layers) {
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+  flecsi::coloring::mpi_communicator_t communicator;
+
+  auto primary = flecsi::coloring::naive_coloring<2, 2>(sd);
+
+  // Two layers of face neighbors.
+  auto colorings =
+      flecsi::coloring::color_entities(sd, communicator, primary, {0}, 2, 1);
+
+  auto one = flecsi::topology::entity_neighbors<2, 2, 1>(sd, primary);
+  auto two = flecsi::topology::entity_neighbors<2, 2, 1>(sd, one);
+  auto ghost_cells = flecsi::utils::set_difference(two, primary);
+
+  check_coloring(communicator, colorings[2], primary, ghost_cells);
+
+  // The vertices of the primary and ghost cells are owned by the lowest
+  // rank that owns a cell referencing them.
+  auto all_primary_cells = communicator.get_entity_reduction(primary);
+  auto vertices = flecsi::topology::entity_closure<2, 0>(sd, two);
+
+  std::set<size_t> primary_vertices;
+
+  for (auto v : vertices) {
+    size_t owner = communicator.size();
+
+    for (auto & p : all_primary_cells) {
+      for (auto c : flecsi::topology::entity_referencers<2, 0>(sd, v)) {
+        if (p.second.count(c)) {
+          owner = std::min(owner, p.first);
+        } // if
+      } // for
+    } // for
+
+    if (owner == communicator.rank()) {
+      primary_vertices.insert(v);
+    } // if
+  } // for
+
+  check_coloring(communicator, colorings[0], primary_vertices,
+    flecsi::utils::set_difference(vertices, primary_vertices));
+} // TEST
+
+TEST(entity_coloring, cells_only) {
+  flecsi::io::simple_definition_t sd("simple2d-8x8.msh");
+  flecsi::coloring::mpi_communicator_t communicator;
+
+  auto primary = flecsi::coloring::naive_coloring<2, 2>(sd);
+  auto colorings =
+      flecsi::coloring::color_entities(sd, communicator, primary, {});
+
+  ASSERT_EQ(colorings.size(), 1);
+
+  auto closure = flecsi::topology::entity_neighbors<2, 2, 0>(sd, primary);
+  check_coloring(communicator, colorings[2], primary,
+    flecsi::utils::set_difference(closure, primary));
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
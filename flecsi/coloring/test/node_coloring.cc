@@ -0,0 +1,119 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include <flecsi/coloring/dcrs_utils.h>
+#include <flecsi/coloring/entity_coloring.h>
+#include <flecsi/coloring/parmetis_colorer.h>
+#include <flecsi/io/simple_definition.h>
+
+// Group the ranks in pairs, so that there are several nodes on a single
+// machine.
+std::vector<size_t>
+pairs(size_t size) {
+  std::vector<size_t> nodes(size);
+
+  for (size_t r(0); r < size; ++r) {
+    nodes[r] = r / 2;
+  } // for
+
+  return nodes;
+} // pairs
+
+TEST(node_coloring, mpi_nodes) {
+  int rank;
+  int size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  auto nodes = flecsi::coloring::mpi_nodes();
+
+  ASSERT_EQ(nodes.size(), size);
+  ASSERT_EQ(nodes[0], 0);
+
+  // The nodes are numbered in the order of their lowest rank.
+  size_t next(1);
+
+  for (size_t r(1); r < size; ++r) {
+    ASSERT_LE(nodes[r], next);
+    next = std::max(next, nodes[r] + 1);
+  } // for
+
+  // The ranks of the node are the ones that share memory.
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(
+      MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+
+  int node_size;
+  MPI_Comm_size(node_comm, &node_size);
+  MPI_Comm_free(&node_comm);
+
+  ASSERT_EQ(std::count(nodes.begin(), nodes.end(), nodes[rank]), node_size);
+} // TEST
+
+TEST(node_coloring, two_levels) {
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+  flecsi::coloring::mpi_communicator_t communicator;
+
+  const size_t size = communicator.size();
+
+  auto dcrs = flecsi::coloring::make_dcrs(sd);
+
+  flecsi::coloring::parmetis_colorer_t colorer;
+  colorer.set_nodes(pairs(size));
+  auto primary = colorer.color(dcrs);
+
+  ASSERT_GT(primary.size(), 0);
+
+  // Every cell belongs to exactly one rank.
+  auto all_primary = communicator.get_entity_reduction(primary);
+  std::set<size_t> cells;
+  size_t count(0);
+
+  for (auto & p : all_primary) {
+    cells.insert(p.second.begin(), p.second.end());
+    count += p.second.size();
+  } // for
+
+  ASSERT_EQ(cells.size(), sd.num_entities(2));
+  ASSERT_EQ(count, sd.num_entities(2));
+
+  // The users and the owners on the same node are recorded separately.
+  communicator.set_nodes(pairs(size));
+
+  auto colorings =
+      flecsi::coloring::color_entities(sd, communicator, primary, {0});
+
+  for (auto & c : colorings) {
+    auto coloring_info = communicator.gather_coloring_info(c.second.info);
+
+    for (auto & ci : coloring_info) {
+      std::set<size_t> users;
+      std::set<size_t> owners;
+
+      for (auto u : ci.second.shared_users) {
+        if (u / 2 == ci.first / 2) {
+          users.insert(u);
+        } // if
+      } // for
+
+      for (auto o : ci.second.ghost_owners) {
+        if (o / 2 == ci.first / 2) {
+          owners.insert(o);
+        } // if
+      } // for
+
+      ASSERT_EQ(ci.second.shared_users_on_node, users);
+      ASSERT_EQ(ci.second.ghost_owners_on_node, owners);
+    } // for
+  } // for
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
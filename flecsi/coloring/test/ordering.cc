@@ -0,0 +1,137 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include <flecsi/coloring/ordering.h>
+#include <flecsi/io/simple_definition.h>
+
+using point_t = flecsi::point__<double, 2>;
+
+// The largest difference between the positions of adjacent vertices.
+size_t
+bandwidth(const flecsi::coloring::crs_t & graph,
+  const std::vector<size_t> & order) {
+  std::vector<size_t> position(order.size());
+
+  for (size_t i(0); i < order.size(); ++i) {
+    position[order[i]] = i;
+  } // for
+
+  size_t result(0);
+
+  for (size_t v(0); v < graph.size(); ++v) {
+    for (size_t e(graph.offsets[v]); e < graph.offsets[v + 1]; ++e) {
+      const size_t a = position[v];
+      const size_t b = position[graph.indices[e]];
+      result = std::max(result, a > b ? a - b : b - a);
+    } // for
+  } // for
+
+  return result;
+} // bandwidth
+
+// Check that an order is a permutation of [0, n).
+void
+check_permutation(std::vector<size_t> order, size_t n) {
+  std::sort(order.begin(), order.end());
+  std::vector<size_t> expected(n);
+  std::iota(expected.begin(), expected.end(), 0);
+  ASSERT_EQ(order, expected);
+} // check_permutation
+
+TEST(ordering, reverse_cuthill_mckee) {
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+  const size_t cells = sd.num_entities(2);
+
+  // Scramble the cells, so that the graph has a large bandwidth.
+  std::vector<size_t> ids(cells);
+
+  for (size_t i(0); i < cells; ++i) {
+    ids[i] = (i * 97) % cells;
+  } // for
+
+  auto graph = flecsi::coloring::make_crs<2, 1>(sd, ids);
+
+  // The interior cells have four face neighbors.
+  ASSERT_EQ(graph.size(), cells);
+  ASSERT_EQ(graph.indices.size(), 4 * 16 * 15);
+
+  std::vector<size_t> identity(cells);
+  std::iota(identity.begin(), identity.end(), 0);
+
+  auto order = flecsi::coloring::reverse_cuthill_mckee(graph);
+  check_permutation(order, cells);
+
+  ASSERT_GT(bandwidth(graph, identity), 200);
+  ASSERT_LE(bandwidth(graph, order), 17);
+
+  // Disconnected graphs are ordered by component.
+  auto halves = flecsi::coloring::make_crs<2, 1>(
+      sd, std::vector<size_t>{0, 1, 2, 200, 201, 202});
+  auto halves_order = flecsi::coloring::reverse_cuthill_mckee(halves);
+  check_permutation(halves_order, 6);
+  ASSERT_EQ(bandwidth(halves, halves_order), 1);
+} // TEST
+
+TEST(ordering, hilbert_order) {
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+  const size_t cells = sd.num_entities(2);
+
+  std::vector<point_t> centroids;
+
+  for (size_t c(0); c < cells; ++c) {
+    point_t centroid(0.0, 0.0);
+
+    for (auto v : sd.entities(2, 0, c)) {
+      auto x = sd.vertex(v);
+      centroid[0] += x[0] / 4;
+      centroid[1] += x[1] / 4;
+    } // for
+
+    centroids.push_back(centroid);
+  } // for
+
+  auto order = flecsi::coloring::hilbert_order(centroids);
+  check_permutation(order, cells);
+
+  // On a regular grid, consecutive cells along the curve are face
+  // neighbors.
+  for (size_t i(1); i < cells; ++i) {
+    auto & a = centroids[order[i - 1]];
+    auto & b = centroids[order[i]];
+    const double distance = std::abs(a[0] - b[0]) + std::abs(a[1] - b[1]);
+    ASSERT_NEAR(distance, 1.0 / 16, 0.01);
+  } // for
+} // TEST
+
+TEST(ordering, induced_order) {
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+  const size_t cells = sd.num_entities(2);
+
+  std::vector<size_t> cell_order(cells);
+
+  for (size_t i(0); i < cells; ++i) {
+    cell_order[i] = cells - 1 - i;
+  } // for
+
+  auto vertex_order = flecsi::coloring::induced_order(sd, 2, 0, cell_order);
+  check_permutation(vertex_order, sd.num_entities(0));
+
+  // The vertices of the first cell come first.
+  auto first = sd.entities(2, 0, cells - 1);
+  ASSERT_EQ(std::vector<size_t>(vertex_order.begin(), vertex_order.begin() + 4),
+    first);
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,198 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+
+#include <flecsi/coloring/dcrs_utils.h>
+#include <flecsi/coloring/sfc_colorer.h>
+#include <flecsi/io/simple_definition.h>
+
+using sfc2d_t = flecsi::coloring::sfc_colorer__<2>;
+using sfc3d_t = flecsi::coloring::sfc_colorer__<3>;
+using flecsi::coloring::sfc_curve_t;
+
+// The centroids of the cells with the given ids.
+std::vector<sfc2d_t::point_t>
+centroids(
+    const flecsi::io::simple_definition_t & sd,
+    const std::set<size_t> & cells) {
+  std::vector<sfc2d_t::point_t> result;
+
+  for (auto c : cells) {
+    sfc2d_t::point_t centroid(0.0, 0.0);
+    auto vertices = sd.entities(2, 0, c);
+
+    for (auto v : vertices) {
+      auto x = sd.vertex(v);
+      centroid[0] += x[0] / vertices.size();
+      centroid[1] += x[1] / vertices.size();
+    } // for
+
+    result.push_back(centroid);
+  } // for
+
+  return result;
+} // centroids
+
+// Check that every cell is owned by exactly one rank.
+void
+check_cover(const std::set<size_t> & primary, size_t cells) {
+  std::vector<int> owners(cells, 0);
+
+  for (auto c : primary) {
+    owners[c] = 1;
+  } // for
+
+  MPI_Allreduce(
+      MPI_IN_PLACE, owners.data(), cells, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  for (auto o : owners) {
+    ASSERT_EQ(o, 1);
+  } // for
+} // check_cover
+
+TEST(sfc_colorer, morton) {
+  // The first coordinate has the least significant bit.
+  EXPECT_EQ(sfc2d_t::encode({0, 0}, sfc_curve_t::morton), 0);
+  EXPECT_EQ(sfc2d_t::encode({1, 0}, sfc_curve_t::morton), 1);
+  EXPECT_EQ(sfc2d_t::encode({0, 1}, sfc_curve_t::morton), 2);
+  EXPECT_EQ(sfc2d_t::encode({1, 1}, sfc_curve_t::morton), 3);
+  EXPECT_EQ(sfc2d_t::encode({2, 0}, sfc_curve_t::morton), 4);
+  EXPECT_EQ(sfc3d_t::encode({0, 0, 1}, sfc_curve_t::morton), 4);
+} // TEST
+
+TEST(sfc_colorer, hilbert) {
+  // Consecutive points of a regular grid along the Hilbert curve are
+  // face neighbors.
+  const long n = 8;
+  const size_t shift2d = sfc2d_t::bits - 3;
+  std::vector<std::pair<uint64_t, std::array<long, 2>>> points2d;
+
+  for (long i(0); i < n; ++i) {
+    for (long j(0); j < n; ++j) {
+      points2d.push_back({sfc2d_t::encode({uint64_t(i) << shift2d,
+                                           uint64_t(j) << shift2d},
+                                          sfc_curve_t::hilbert),
+                          {i, j}});
+    } // for
+  } // for
+
+  std::sort(points2d.begin(), points2d.end());
+
+  for (size_t p(1); p < points2d.size(); ++p) {
+    auto & a = points2d[p - 1].second;
+    auto & b = points2d[p].second;
+    ASSERT_EQ(std::abs(a[0] - b[0]) + std::abs(a[1] - b[1]), 1);
+  } // for
+
+  const long m = 4;
+  const size_t shift3d = sfc3d_t::bits - 2;
+  std::vector<std::pair<uint64_t, std::array<long, 3>>> points3d;
+
+  for (long i(0); i < m; ++i) {
+    for (long j(0); j < m; ++j) {
+      for (long k(0); k < m; ++k) {
+        points3d.push_back({sfc3d_t::encode({uint64_t(i) << shift3d,
+                                             uint64_t(j) << shift3d,
+                                             uint64_t(k) << shift3d},
+                                            sfc_curve_t::hilbert),
+                            {i, j, k}});
+      } // for
+    } // for
+  } // for
+
+  std::sort(points3d.begin(), points3d.end());
+
+  for (size_t p(1); p < points3d.size(); ++p) {
+    auto & a = points3d[p - 1].second;
+    auto & b = points3d[p].second;
+    ASSERT_EQ(
+        std::abs(a[0] - b[0]) + std::abs(a[1] - b[1]) + std::abs(a[2] - b[2]),
+        1);
+  } // for
+} // TEST
+
+TEST(sfc_colorer, simple2d_16x16) {
+  int size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+  const size_t cells = sd.num_entities(2);
+  auto naive = flecsi::coloring::naive_coloring<2, 2>(sd);
+
+  for (auto curve : {sfc_curve_t::morton, sfc_curve_t::hilbert}) {
+    sfc2d_t colorer(centroids(sd, naive), {}, curve);
+    auto primary = colorer.color(naive);
+
+    check_cover(primary, cells);
+
+    // The samples resolve the boundaries to within a cell here.
+    const double average = double(cells) / size;
+    ASSERT_LE(std::abs(primary.size() - average), 1.0);
+  } // for
+
+  // The same partition from the distributed graph.
+  auto dcrs = flecsi::coloring::make_dcrs(sd);
+  sfc2d_t colorer(centroids(sd, naive));
+  sfc2d_t other(centroids(sd, naive));
+  ASSERT_EQ(colorer.color(dcrs), other.color(naive));
+} // TEST
+
+TEST(sfc_colorer, weighted) {
+  int size;
+  int rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+  const size_t cells = sd.num_entities(2);
+  auto naive = flecsi::coloring::naive_coloring<2, 2>(sd);
+
+  // Rank r receives a share proportional to r + 1.
+  {
+    sfc2d_t colorer(centroids(sd, naive), {}, sfc_curve_t::hilbert, rank + 1);
+    auto primary = colorer.color(naive);
+
+    check_cover(primary, cells);
+
+    const double share = double(cells) * (rank + 1) / (size * (size + 1) / 2);
+    ASSERT_LE(std::abs(primary.size() - share), 1.0);
+  } // scope
+
+  // The cells of the left half are three times as expensive.
+  {
+    auto points = centroids(sd, naive);
+    std::vector<double> weights;
+
+    for (auto & p : points) {
+      weights.push_back(p[0] < 0.5 ? 3.0 : 1.0);
+    } // for
+
+    sfc2d_t colorer(points, weights);
+    auto primary = colorer.color(naive);
+
+    check_cover(primary, cells);
+
+    double weight(0.0);
+
+    for (auto c : primary) {
+      auto p = centroids(sd, {c})[0];
+      weight += p[0] < 0.5 ? 3.0 : 1.0;
+    } // for
+
+    const double average = 2.0 * cells / size;
+    ASSERT_LE(std::abs(weight - average), 3.0);
+  } // scope
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,184 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+
+#include <flecsi-config.h>
+
+#if !defined(FLECSI_ENABLE_MPI)
+#error FLECSI_ENABLE_MPI not defined! This file depends on MPI!
+#endif
+
+#include <mpi.h>
+
+#include <flecsi/coloring/mpi_communicator.h>
+
+using flecsi::coloring::mpi_communicator_t;
+
+using exchange_t = std::map<size_t, std::vector<size_t>>;
+
+// The number of values that a rank sends to another rank in a round.
+// The pattern is not symmetric, some ranks do not send to or receive
+// from anybody in some rounds, and the message sizes differ.
+size_t
+message_size(size_t source, size_t destination, size_t round) {
+  // Rank 0 sends a message that is much larger than the others.
+  if (source == 0 && destination == 2 && round == 1) {
+    return 100000;
+  } // if
+
+  if ((source + 2 * destination + round) % 3 == 0) {
+    return 0;
+  } // if
+
+  return (source * 7 + destination * 3 + round) % 11;
+} // message_size
+
+// The buffer that a rank sends to another rank in a round.
+std::vector<size_t>
+message(size_t source, size_t destination, size_t round) {
+  std::vector<size_t> values(message_size(source, destination, round));
+
+  for (size_t i(0); i < values.size(); ++i) {
+    values[i] = ((source * 1000 + destination) * 1000 + round) * 1000 + i;
+  } // for
+
+  return values;
+} // message
+
+// Run a round of the exchange and check the received buffers.
+void
+check_round(mpi_communicator_t & communicator, size_t round) {
+  const size_t colors = communicator.size();
+  const size_t color = communicator.rank();
+
+  // Empty buffers are also added to the map, but must not be received.
+  exchange_t send;
+
+  for (size_t d(0); d < colors; ++d) {
+    send[d] = message(color, d, round);
+  } // for
+
+  auto recv = communicator.sparse_exchange(send);
+
+  exchange_t expected;
+
+  for (size_t s(0); s < colors; ++s) {
+    auto values = message(s, color, round);
+
+    if (!values.empty()) {
+      expected[s] = values;
+    } // if
+  } // for
+
+  ASSERT_EQ(recv.size(), expected.size());
+
+  for (auto & e : expected) {
+    ASSERT_EQ(recv.count(e.first), 1);
+    ASSERT_EQ(recv.at(e.first), e.second);
+  } // for
+} // check_round
+
+TEST(sparse_exchange, uneven) {
+  mpi_communicator_t communicator;
+
+  // Consecutive rounds with different patterns, so that some ranks
+  // start the next exchange while others are still receiving.
+  for (size_t round(0); round < 20; ++round) {
+    check_round(communicator, round);
+  } // for
+} // TEST
+
+// Run a round of the exchange with values of the given type, which
+// holds the low bits of the values of message.
+template<typename TYPE>
+void
+check_typed_round(mpi_communicator_t & communicator, size_t round) {
+  const size_t colors = communicator.size();
+  const size_t color = communicator.rank();
+
+  std::map<size_t, std::vector<TYPE>> send;
+
+  for (size_t d(0); d < colors; ++d) {
+    auto values = message(color, d, round);
+    send[d].assign(values.begin(), values.end());
+  } // for
+
+  auto recv = communicator.sparse_exchange(send);
+
+  std::map<size_t, std::vector<TYPE>> expected;
+
+  for (size_t s(0); s < colors; ++s) {
+    auto values = message(s, color, round);
+
+    if (!values.empty()) {
+      expected[s].assign(values.begin(), values.end());
+    } // if
+  } // for
+
+  ASSERT_EQ(recv, expected);
+} // check_typed_round
+
+TEST(sparse_exchange, mixed_types) {
+  mpi_communicator_t communicator;
+
+  // Back-to-back exchanges of different value types share the tags, so
+  // that an exchange never matches the messages of the next one.
+  for (size_t round(0); round < 60; ++round) {
+    switch (round % 3) {
+      case 0:
+        check_typed_round<uint8_t>(communicator, round);
+        break;
+      case 1:
+        check_typed_round<size_t>(communicator, round);
+        break;
+      default:
+        check_typed_round<double>(communicator, round);
+        break;
+    } // switch
+  } // for
+} // TEST
+
+TEST(sparse_exchange, one_sender) {
+  mpi_communicator_t communicator;
+
+  const size_t colors = communicator.size();
+  const size_t color = communicator.rank();
+
+  // Only the last rank sends, to every other rank, with different sizes.
+  exchange_t send;
+
+  if (color + 1 == colors) {
+    for (size_t d(0); d + 1 < colors; ++d) {
+      send[d].assign(d * 1000 + 1, d);
+    } // for
+  } // if
+
+  auto recv = communicator.sparse_exchange(send);
+
+  if (color + 1 == colors) {
+    ASSERT_TRUE(recv.empty());
+  } else {
+    ASSERT_EQ(recv.size(), 1);
+    ASSERT_EQ(recv.begin()->first, colors - 1);
+    ASSERT_EQ(recv.begin()->second, std::vector<size_t>(color * 1000 + 1,
+      color));
+  } // if
+} // TEST
+
+TEST(sparse_exchange, empty) {
+  mpi_communicator_t communicator;
+
+  // Nobody sends anything.
+  exchange_t send;
+  auto recv = communicator.sparse_exchange(send);
+
+  ASSERT_TRUE(recv.empty());
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,182 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+#include <mpi.h>
+
+#include <numeric>
+
+#include <flecsi/coloring/dcrs_utils.h>
+#include <flecsi/coloring/mpi_communicator.h>
+#include <flecsi/coloring/parmetis_colorer.h>
+#include <flecsi/io/simple_definition.h>
+
+// ParMETIS balances each constraint to within 5% of its target. Allow
+// some more on the small test mesh.
+const double tolerance = 1.1;
+
+// The cells of the 16x16 mesh in the left half cost four times as much.
+size_t
+cost(size_t cell) {
+  return cell % 16 < 8 ? 4 : 1;
+} // cost
+
+// The cells of the first four rows hold six materials.
+size_t
+materials(size_t cell) {
+  return cell / 16 < 4 ? 6 : 1;
+} // materials
+
+// Check that every cell is owned by exactly one rank.
+void
+check_cover(const std::set<size_t> & primary, size_t cells) {
+  std::vector<int> owners(cells, 0);
+
+  for (auto c : primary) {
+    owners[c] = 1;
+  } // for
+
+  MPI_Allreduce(
+      MPI_IN_PLACE, owners.data(), cells, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  for (auto o : owners) {
+    ASSERT_EQ(o, 1);
+  } // for
+} // check_cover
+
+// Return the weight of the primary cells of each rank.
+std::vector<double>
+part_weights(const std::set<size_t> & primary, size_t (*weight)(size_t)) {
+  int size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  double local(0.0);
+
+  for (auto c : primary) {
+    local += weight(c);
+  } // for
+
+  std::vector<double> weights(size);
+  MPI_Allgather(
+      &local, 1, MPI_DOUBLE, weights.data(), 1, MPI_DOUBLE, MPI_COMM_WORLD);
+
+  return weights;
+} // part_weights
+
+// Check that the weight of each part is within the tolerance of its
+// share of the targets.
+void
+check_balance(
+    const std::vector<double> & weights,
+    const std::vector<double> & targets) {
+  const double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+  const double total_targets =
+      std::accumulate(targets.begin(), targets.end(), 0.0);
+
+  for (size_t r(0); r < weights.size(); ++r) {
+    EXPECT_LE(weights[r], tolerance * total * targets[r] / total_targets);
+  } // for
+} // check_balance
+
+// The vertex weights of the local cells, with the given weights for each
+// cell.
+std::vector<size_t>
+vertex_weights(
+    const flecsi::coloring::dcrs_t & dcrs,
+    std::initializer_list<size_t (*)(size_t)> weights) {
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  std::vector<size_t> result;
+
+  for (size_t i(0); i < dcrs.size(); ++i) {
+    for (auto weight : weights) {
+      result.push_back(weight(dcrs.distribution[rank] + i));
+    } // for
+  } // for
+
+  return result;
+} // vertex_weights
+
+TEST(weighted_coloring, vertex_weights) {
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+
+  int size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  auto dcrs = flecsi::coloring::make_dcrs(sd);
+
+  flecsi::coloring::parmetis_colorer_t colorer;
+  auto primary = colorer.color(dcrs, vertex_weights(dcrs, {cost}));
+
+  check_cover(primary, sd.num_entities(2));
+  check_balance(
+      part_weights(primary, cost), std::vector<double>(size, 1.0));
+} // TEST
+
+TEST(weighted_coloring, multiple_constraints) {
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+
+  int size;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  auto dcrs = flecsi::coloring::make_dcrs(sd);
+
+  // Both the cost and the materials are balanced.
+  flecsi::coloring::parmetis_colorer_t colorer;
+  auto primary =
+      colorer.color(dcrs, vertex_weights(dcrs, {cost, materials}), 2);
+
+  check_cover(primary, sd.num_entities(2));
+
+  const std::vector<double> targets(size, 1.0);
+  check_balance(part_weights(primary, cost), targets);
+  check_balance(part_weights(primary, materials), targets);
+} // TEST
+
+TEST(weighted_coloring, target_weights) {
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+
+  int rank;
+  int size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  auto dcrs = flecsi::coloring::make_dcrs(sd);
+
+  // Rank 0 should receive three times the weight of the other ranks.
+  // The edges are weighted too, which exercises the full weight flag.
+  std::vector<double> targets(size, 1.0);
+  targets[0] = 3.0;
+
+  // The weight of an edge must be the same in both directions.
+  std::vector<size_t> edge_weights(dcrs.indices.size());
+
+  for (size_t i(0); i < dcrs.size(); ++i) {
+    const size_t cell = dcrs.distribution[rank] + i;
+
+    for (size_t j(dcrs.offsets[i]); j < dcrs.offsets[i + 1]; ++j) {
+      edge_weights[j] = 1 + (cell + dcrs.indices[j]) % 3;
+    } // for
+  } // for
+
+  flecsi::coloring::parmetis_colorer_t colorer(targets[rank]);
+  auto primary =
+      colorer.color(dcrs, vertex_weights(dcrs, {cost}), 1, edge_weights);
+
+  check_cover(primary, sd.num_entities(2));
+
+  auto weights = part_weights(primary, cost);
+  check_balance(weights, targets);
+
+  for (size_t r(1); r < size; ++r) {
+    EXPECT_GT(weights[0], weights[r]);
+  } // for
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,201 @@
+/*~--------------------------------------------------------------------------~*
+ *~--------------------------------------------------------------------------~*/
+
+#pragma once
+
+//----------------------------------------------------------------------------//
+//! @file
+//! @date Initial file creation: Oct 18, 2026
+//----------------------------------------------------------------------------//
+
+#include <cassert>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace flecsi {
+
+//------------------------------------------------------------------------//
+//! This class provides a fork-join pool for data-parallel kernels. A
+//! kernel is a callable object that is executed once by each thread of
+//! the pool, including the calling thread, which waits until all of the
+//! threads have finished.
+//!
+//! Only one kernel is executed at a time. Kernels that are launched
+//! while the pool is busy, e.g., nested kernels or kernels of tasks
+//! that execute concurrently, are not executed by the pool, so that the
+//! caller can execute them serially instead.
+//!
+//! @ingroup concurrency
+//------------------------------------------------------------------------//
+class kernel_pool {
+public:
+  //! signature of kernels, which take the index of the executing thread
+  using function_t = std::function<void(size_t)>;
+
+  //---------------------------------------------------------------------//
+  //! Constructor
+  //!
+  //! @param num_threads Number of threads, including the calling thread
+  //---------------------------------------------------------------------//
+  kernel_pool(size_t num_threads = 1) {
+    start(num_threads);
+  }
+
+  //---------------------------------------------------------------------//
+  //! Destructor
+  //---------------------------------------------------------------------//
+  ~kernel_pool() {
+    join();
+  }
+
+  //---------------------------------------------------------------------//
+  //! Internal run method. Do not call directly.
+  //---------------------------------------------------------------------//
+  void run_(size_t thread) {
+    size_t generation = 0;
+
+    for (;;) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [&] { return done_ || generation_ != generation; });
+
+      if (done_) {
+        return;
+      }
+
+      generation = generation_;
+      const function_t & function = *function_;
+      lock.unlock();
+
+      function(thread);
+
+      lock.lock();
+      if (--pending_ == 0) {
+        finish_.notify_one();
+      }
+    }
+  }
+
+  //---------------------------------------------------------------------//
+  //! Execute a kernel on all threads of the pool and wait for it to
+  //! finish.
+  //!
+  //! @param function The kernel
+  //!
+  //! @return False if the pool is busy, in which case the kernel was not
+  //!         executed.
+  //---------------------------------------------------------------------//
+  bool run(const function_t & function) {
+    std::unique_lock<std::mutex> busy(busy_, std::try_to_lock);
+
+    if (!busy.owns_lock()) {
+      return false;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      function_ = &function;
+      pending_ = threads_.size();
+      ++generation_;
+    }
+
+    start_.notify_all();
+
+    function(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    finish_.wait(lock, [&] { return pending_ == 0; });
+    function_ = nullptr;
+
+    return true;
+  }
+
+  //---------------------------------------------------------------------//
+  //! Change the number of threads of the pool. This must not be called
+  //! while a kernel is executing.
+  //!
+  //! @param num_threads Number of threads, including the calling thread
+  //---------------------------------------------------------------------//
+  void resize(size_t num_threads) {
+    std::lock_guard<std::mutex> busy(busy_);
+    join();
+    start(num_threads);
+  }
+
+  //---------------------------------------------------------------------//
+  //! Return the number of threads, including the calling thread
+  //---------------------------------------------------------------------//
+  size_t num_threads() const {
+    return threads_.size() + 1;
+  }
+
+private:
+  void start(size_t num_threads) {
+    assert(threads_.empty() && "kernel pool already started");
+
+    done_ = false;
+    generation_ = 0;
+
+    for (size_t i = 1; i < num_threads; ++i) {
+      threads_.emplace_back(&kernel_pool::run_, this, i);
+    }
+  }
+
+  void join() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_ = true;
+    }
+
+    start_.notify_all();
+
+    for (auto & t : threads_) {
+      t.join();
+    }
+
+    threads_.clear();
+  }
+
+  std::mutex busy_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable finish_;
+  const function_t * function_ = nullptr;
+  size_t generation_ = 0;
+  size_t pending_ = 0;
+  bool done_ = false;
+  std::vector<std::thread> threads_;
+};
+
+//------------------------------------------------------------------------//
+//! Call a function on contiguous chunks of the range [0, size) with the
+//! bounds of the chunk and the index of the calling thread. There is one
+//! chunk per thread of the pool, or a single chunk on the calling thread
+//! if there is no pool or if it is busy.
+//!
+//! @ingroup concurrency
+//------------------------------------------------------------------------//
+template<typename FUNCTION>
+void
+for_each_chunk(kernel_pool * pool, size_t size, FUNCTION && function) {
+  const size_t threads = pool ? pool->num_threads() : 1;
+
+  if (threads > 1 && size >= threads) {
+    auto chunk = [&](size_t thread) {
+      function(size * thread / threads, size * (thread + 1) / threads, thread);
+    };
+
+    if (pool->run(chunk)) {
+      return;
+    }
+  }
+
+  function(0, size, 0);
+}
+
+} // namespace flecsi
+
+/*~-------------------------------------------------------------------------~-*
+ *~-------------------------------------------------------------------------~-*/
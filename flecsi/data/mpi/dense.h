@@ -176,6 +176,10 @@ struct storage_class__<dense>
       // TODO: deal with VERSION
       context.register_field_data(field_info.fid,
                                   size);
+    }
+
+    // The metadata is released when the index space is repartitioned.
+    if (context.registered_field_metadata().count(field_info.fid) == 0) {
       context.register_field_metadata<DATA_TYPE>(field_info.fid,
                                                  color_info,
                                                  index_coloring);
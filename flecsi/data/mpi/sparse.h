@@ -150,7 +150,6 @@ struct storage_class__<sparse>
     if (fieldDataIter == registered_sparse_field_data.end()) {
       // get color_info for this field.
       auto& color_info = (context.coloring_info(field_info.index_space)).at(context.color());
-      auto &index_coloring = context.coloring(field_info.index_space);
 
       auto& im = context.sparse_index_space_info_map();
       auto iitr = im.find(field_info.index_space);
@@ -166,6 +165,14 @@ struct storage_class__<sparse>
       // TODO: deal with VERSION
       context.register_sparse_field_data(field_info.fid, field_info.size,
         color_info, max_entries_per_index, reserve_chunk);
+    }
+
+    // The metadata is released when the index space is repartitioned.
+    if (context.registered_sparse_field_metadata().count(field_info.fid) ==
+      0) {
+      auto& color_info =
+        (context.coloring_info(field_info.index_space)).at(context.color());
+      auto &index_coloring = context.coloring(field_info.index_space);
 
       context.register_sparse_field_metadata<DATA_TYPE>(
         field_info.fid, color_info, index_coloring);
@@ -224,7 +231,6 @@ struct storage_class__<sparse>
 
       // get color_info for this field.
       auto& color_info = (context.coloring_info(field_info.index_space)).at(context.color());
-      auto &index_coloring = context.coloring(field_info.index_space);
 
       auto& im = context.sparse_index_space_info_map();
       auto iitr = im.find(field_info.index_space);
@@ -240,6 +246,14 @@ struct storage_class__<sparse>
       // TODO: deal with VERSION
       context.register_sparse_field_data(field_info.fid, field_info.size,
         color_info, max_entries_per_index, reserve_chunk);
+    }
+
+    // The metadata is released when the index space is repartitioned.
+    if (context.registered_sparse_field_metadata().count(field_info.fid) ==
+      0) {
+      auto& color_info =
+        (context.coloring_info(field_info.index_space)).at(context.color());
+      auto &index_coloring = context.coloring(field_info.index_space);
 
       context.register_sparse_field_metadata<DATA_TYPE>(
         field_info.fid, color_info, index_coloring);
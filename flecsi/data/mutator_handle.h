@@ -283,11 +283,11 @@ public:
     cbuf = new entry_value_t[max_entries_per_index_];
 
     for (size_t index = start; index < end; ++index) {
-      entry_value_t * eptr = ci->entries[1] + max_entries_per_index_ * index;
-
       const offset_t & oi = offsets_[index];
       offset_t & coi = offsets[index];
 
+      entry_value_t * eptr = entries + coi.start();
+
       entry_value_t * sptr = entries_ + index * num_slots_;
 
       size_t num_existing = coi.count();
@@ -335,8 +335,8 @@ public:
           std::vector<T> & values = *changes->push_values;
           size_t ri = size - values.size();
           for (auto & vi : values) {
-            cptr[ri].entry = ri;
-            cptr[ri++].value = vi;
+            cbuf[ri].entry = ri;
+            cbuf[ri++].value = vi;
           }
         }
 
@@ -36,7 +36,8 @@ enum launch_mask_t : size_t {
   index = 1 << 1,
   leaf = 1 << 2,
   inner = 1 << 3,
-  idempotent = 1 << 4
+  idempotent = 1 << 4,
+  split = 1 << 5
 }; // enum launch_mask_t
 
 namespace execution {
@@ -46,7 +47,7 @@ namespace execution {
 // to increase the launch_bits accordingly, i.e., launch_bits must
 // be greater than or equal to the number of bits in the bitset for
 // launch_t below.
-constexpr size_t launch_bits = 5;
+constexpr size_t launch_bits = 6;
 
 /*!
   Use a std::bitset to store launch information.
@@ -60,6 +61,11 @@ using launch_t = std::bitset<launch_bits>;
   Enumeration of various task launch types. Not all of these may be
   supported by all runtimes. Unsupported launch information will be
   ignored.
+
+  A split task may be executed once over the exclusive indices and once
+  over the shared indices, so that the runtime can overlap the ghost
+  update with the exclusive part of the computation. Split tasks must
+  restrict their computation to context_t::task_partition().
  */
 
 enum class launch_type_t : size_t {
@@ -67,7 +73,8 @@ enum class launch_type_t : size_t {
   index,
   leaf,
   inner,
-  idempotent
+  idempotent,
+  split
 }; // enum launch_type_t
 
 /*!
@@ -90,7 +97,7 @@ mask_to_type(launch_mask_t m) {
 
 test_boolean_interface(single) test_boolean_interface(index)
     test_boolean_interface(leaf) test_boolean_interface(inner)
-        test_boolean_interface(idempotent)
+        test_boolean_interface(idempotent) test_boolean_interface(split)
 
 #undef test_boolean_interface
 
@@ -103,10 +110,12 @@ test_boolean_interface(single) test_boolean_interface(index)
         bool INDEX = false,
         bool LEAF = false,
         bool INNER = false,
-        bool IDEMPOTENT = false>
+        bool IDEMPOTENT = false,
+        bool SPLIT = false>
     launch_t make_launch() {
   return {(SINGLE ? 1 << 0 : 0) | (INDEX ? 1 << 1 : 0) | (LEAF ? 1 << 2 : 0) |
-          (INNER ? 1 << 3 : 0) | (IDEMPOTENT ? 1 << 4 : 0)};
+          (INNER ? 1 << 3 : 0) | (IDEMPOTENT ? 1 << 4 : 0) |
+          (SPLIT ? 1 << 5 : 0)};
 } // make_launch
 
 } // namespace execution
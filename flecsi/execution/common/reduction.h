@@ -0,0 +1,130 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <algorithm>
+#include <limits>
+
+namespace flecsi {
+namespace execution {
+namespace reduction {
+
+/*!
+  Reduction operators for global reductions. An operator is a type with
+  a static apply method that combines rhs into lhs. Operators must be
+  associative, but need not be commutative: lhs always holds the
+  contribution of the lower ranks. Operators that are used in kernels
+  also provide the identity of the operation through a static initial
+  method. User-defined operators follow the same interface, e.g.:
+
+  \code
+  struct bounds_t {
+    double lo;
+    double hi;
+  };
+
+  struct merge_bounds {
+    static void apply(bounds_t & lhs, const bounds_t & rhs) {
+      lhs.lo = std::min(lhs.lo, rhs.lo);
+      lhs.hi = std::max(lhs.hi, rhs.hi);
+    }
+
+    static bounds_t initial() {
+      return { std::numeric_limits<double>::max(),
+        std::numeric_limits<double>::lowest() };
+    }
+  };
+  \endcode
+
+  @ingroup execution
+ */
+
+struct sum {
+  template<typename T>
+  static void apply(T & lhs, const T & rhs) {
+    lhs += rhs;
+  } // apply
+
+  template<typename T>
+  static T initial() {
+    return T(0);
+  } // initial
+}; // struct sum
+
+struct product {
+  template<typename T>
+  static void apply(T & lhs, const T & rhs) {
+    lhs *= rhs;
+  } // apply
+
+  template<typename T>
+  static T initial() {
+    return T(1);
+  } // initial
+}; // struct product
+
+struct min {
+  template<typename T>
+  static void apply(T & lhs, const T & rhs) {
+    lhs = std::min(lhs, rhs);
+  } // apply
+
+  template<typename T>
+  static T initial() {
+    return std::numeric_limits<T>::max();
+  } // initial
+}; // struct min
+
+struct max {
+  template<typename T>
+  static void apply(T & lhs, const T & rhs) {
+    lhs = std::max(lhs, rhs);
+  } // apply
+
+  template<typename T>
+  static T initial() {
+    return std::numeric_limits<T>::lowest();
+  } // initial
+}; // struct max
+
+namespace detail {
+
+template<typename OP, typename T>
+auto identity(int) -> decltype(OP::template initial<T>()) {
+  return OP::template initial<T>();
+} // identity
+
+template<typename OP, typename T>
+T identity(long) {
+  return OP::initial();
+} // identity
+
+} // namespace detail
+
+/*!
+  Return the identity of a reduction operator for the type T. Operators
+  may define initial as a template, like the operators above, or for a
+  single type.
+ */
+
+template<typename OP, typename T>
+T identity() {
+  return detail::identity<OP, T>(0);
+} // identity
+
+} // namespace reduction
+} // namespace execution
+} // namespace flecsi
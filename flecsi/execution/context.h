@@ -16,20 +16,28 @@
 /*! @file */
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdio>
+#include <fstream>
 #include <functional>
 #include <map>
+#include <sstream>
+#include <string>
 #include <unordered_map>
 
 #include <cinchlog.h>
 
 #include <flecsi/coloring/adjacency_types.h>
+#include <flecsi/coloring/coloring_cache.h>
 #include <flecsi/coloring/coloring_types.h>
 #include <flecsi/coloring/index_coloring.h>
 #include <flecsi/execution/common/execution_state.h>
 #include <flecsi/execution/global_object_wrapper.h>
 #include <flecsi/runtime/types.h>
+#include <flecsi/topology/partition.h>
 #include <flecsi/utils/const_string.h>
+#include <flecsi/utils/index_map.h>
 #include <flecsi/utils/simple_id.h>
 
 clog_register_tag(context);
@@ -59,6 +67,14 @@ struct context__ : public CONTEXT_POLICY {
 
   using adjacency_triple_t = std::tuple<size_t, size_t, size_t>;
 
+  /*!
+    Maps from locally compacted ids to mesh ids, and vice versa. Both
+    store their entries contiguously.
+   */
+
+  using index_map_t = utils::dense_index_map_t;
+  using reverse_index_map_t = utils::sorted_index_map_t;
+
   /*!
     Gathers info about registered data fields.
    */
@@ -224,15 +240,27 @@ struct context__ : public CONTEXT_POLICY {
     compacted index spaces.
 
     @param index_space The map key.
-    @param index_map   The map to add.
+    @param index_map   The map to add. The keys must be the locally
+                       compacted ids [0, n).
    */
 
   void add_index_map(size_t index_space, std::map<size_t, size_t> & index_map) {
-    index_map_[index_space] = index_map;
+    index_map_[index_space] = index_map_t(index_map);
+    add_reverse_index_map(index_space);
+  } // add_index_map
 
-    for (auto i : index_map) {
-      reverse_index_map_[index_space][i.second] = i.first;
-    } // for
+  /*!
+    Add an index map from the mesh ids of the locally compacted ids
+    [0, index_map.size()).
+
+    @param index_space The map key.
+    @param index_map   The mesh id of each locally compacted id.
+   */
+
+  void add_index_map(size_t index_space,
+    const std::vector<size_t> & index_map) {
+    index_map_[index_space] = index_map_t(index_map);
+    add_reverse_index_map(index_space);
   } // add_index_map
 
   /*!
@@ -536,6 +564,27 @@ struct context__ : public CONTEXT_POLICY {
     coloring_info_[index_space] = coloring_info;
   } // add_coloring
 
+  /*!
+    Replace an existing index coloring, e.g., after a repartition.
+    References to the previous coloring information are invalidated.
+
+    @param index_space The map key.
+    @param coloring The new index coloring.
+    @param coloring_info The new index coloring information.
+   */
+
+  void update_coloring(
+      size_t index_space,
+      index_coloring_t & coloring,
+      std::unordered_map<size_t, coloring_info_t> & coloring_info) {
+    clog_assert(
+        colorings_.find(index_space) != colorings_.end(),
+        "color index does not exist");
+
+    colorings_[index_space] = coloring;
+    coloring_info_[index_space] = coloring_info;
+  } // update_coloring
+
   /*!
     Return the index coloring referenced by key.
 
@@ -591,6 +640,37 @@ struct context__ : public CONTEXT_POLICY {
     return coloring_info_;
   } // colorings
 
+  /*!
+    Set the order in which the exclusive entities of an index space are
+    numbered locally, e.g., a reverse Cuthill-McKee or Hilbert order that
+    improves the locality of the loops over the entities. By default,
+    the entities are numbered in the order of their mesh ids.
+
+    Only the exclusive entities are renumbered: the shared and ghost
+    entities keep the order of their mesh ids, which the ghost updates
+    depend on. The mesh ids of other entities in the order are ignored,
+    and the exclusive entities that it does not contain follow the
+    ordered ones. The order must be set before the index maps are
+    built, i.e., in the specialization top-level-task initialization.
+
+    @param index_space The map key.
+    @param order       The mesh ids of the entities in the new order.
+   */
+
+  void set_entity_order(size_t index_space, std::vector<size_t> order) {
+    entity_orders_[index_space] = std::move(order);
+  } // set_entity_order
+
+  /*!
+    Return the entity orders of the index spaces that have one.
+
+    @return The map of entity orders.
+   */
+
+  const std::map<size_t, std::vector<size_t>> & entity_order_map() const {
+    return entity_orders_;
+  } // entity_order_map
+
   /*!
     Add an adjacency/connectivity from one index space to another.
 
@@ -608,6 +688,20 @@ struct context__ : public CONTEXT_POLICY {
         adjacency_info.index_space, std::move(adjacency_info));
   } // add_adjacency
 
+  /*!
+    Replace the sizes of an existing adjacency, e.g., after a repartition
+    of its from or to index space.
+
+    @param adjacency_info The new adjacency information.
+   */
+
+  void update_adjacency(adjacency_info_t & adjacency_info) {
+    auto it = adjacency_info_.find(adjacency_info.index_space);
+    clog_assert(it != adjacency_info_.end(), "adjacency does not exist");
+
+    it->second = std::move(adjacency_info);
+  } // update_adjacency
+
   /*!
     Return the set of registered adjacencies.
 
@@ -618,6 +712,123 @@ struct context__ : public CONTEXT_POLICY {
     return adjacency_info_;
   } // adjacencies
 
+  /*!
+    Use a file to cache the colorings of the calling color, so that a
+    later run with the same input and number of colors does not need to
+    recompute them, e.g., a restart. This must be called in the
+    specialization top-level-task initialization by all of the colors,
+    before any coloring is added.
+
+    If the files of all of the colors exist and were written for the
+    same key and number of colors, the colorings, the coloring
+    information, the adjacencies, the entity orders and the index maps
+    are loaded from it, and the specialization must not add them again.
+    Otherwise, the runtime saves them to the file once the index maps are
+    built. The users and owners that are on the same node as each color
+    are not cached, since the ranks may be placed differently in the
+    later run. The runtime recomputes them after loading the file.
+
+    @param directory The directory of the cache files, which must exist.
+    @param key       Identifies the input of the colorings, e.g., the
+                     \ref flecsi::coloring::mesh_checksum of the mesh
+                     definition.
+
+    @return True if the colorings were loaded from the file.
+   */
+
+  bool use_coloring_cache(const std::string & directory, size_t key) {
+    clog_assert(colorings_.empty() && adjacency_info_.empty(),
+        "the coloring cache must be used before adding colorings");
+
+    coloring_cache_file_ = flecsi::coloring::coloring_cache_file(
+        directory, key, CONTEXT_POLICY::colors(), CONTEXT_POLICY::color());
+    coloring_cache_key_ = key;
+    colorings_cached_ = load_coloring_cache();
+
+    // The colorings are computed collectively, so they are only used if
+    // every color could load its file.
+    if (!CONTEXT_POLICY::all_colors(colorings_cached_)) {
+      if (colorings_cached_) {
+        colorings_.clear();
+        coloring_info_.clear();
+        adjacency_info_.clear();
+        entity_orders_.clear();
+        index_map_.clear();
+        reverse_index_map_.clear();
+      } // if
+
+      colorings_cached_ = false;
+    } // if
+
+    {
+      clog_tag_guard(context);
+      clog(info) << (colorings_cached_ ? "loaded" : "computing")
+                 << " colorings of cache file " << coloring_cache_file_
+                 << std::endl;
+    } // guard
+
+    return colorings_cached_;
+  } // use_coloring_cache
+
+  /*!
+    Return true if the colorings were loaded from a cache file, in which
+    case the index maps are already built. See use_coloring_cache.
+   */
+
+  bool colorings_cached() const {
+    return colorings_cached_;
+  } // colorings_cached
+
+  /*!
+    Save the colorings to the cache file, if one is used and they were
+    not loaded from it. The file is written under a temporary name and
+    renamed, so that an interrupted run does not leave a partial file.
+    This is called by the runtime once the index maps are built.
+   */
+
+  void save_coloring_cache() const {
+    if (coloring_cache_file_.empty() || colorings_cached_) {
+      return;
+    } // if
+
+    namespace cache = flecsi::coloring::cache;
+
+    const std::string temporary = coloring_cache_file_ + ".tmp";
+
+    {
+      std::ofstream stream(
+          temporary, std::ios::binary | std::ios::trunc);
+
+      write_coloring_cache_header(stream);
+      cache::write(stream, colorings_);
+      cache::write(stream, coloring_info_);
+      cache::write(stream, adjacency_info_);
+      cache::write(stream, entity_orders_);
+
+      std::map<size_t, std::vector<size_t>> index_maps;
+
+      for (auto & im : index_map_) {
+        auto & ids = index_maps[im.first];
+        ids.reserve(im.second.size());
+
+        for (auto & i : im.second) {
+          ids.push_back(i.second);
+        } // for
+      } // for
+
+      cache::write(stream, index_maps);
+      cache::write(stream, coloring_cache_magic);
+
+      if (!stream) {
+        clog(warn) << "failed to write coloring cache file " << temporary
+                   << std::endl;
+        return;
+      } // if
+    } // scope
+
+    std::rename(temporary.c_str(), coloring_cache_file_.c_str());
+  } // save_coloring_cache
+
   void add_index_subspace(size_t index_subspace, size_t capacity) {
     index_subspace_info_t info;
     info.index_subspace = index_subspace;
@@ -770,6 +981,40 @@ struct context__ : public CONTEXT_POLICY {
     return execution_state_;
   } // execution_state
 
+  /*!
+    Return the partition of the index spaces on which the current task
+    should compute. This is flecsi::owned, unless the runtime is executing
+    a split task, in which case it is flecsi::exclusive or flecsi::shared.
+   */
+
+  partition_t task_partition() const {
+    task_partition_read_.store(true, std::memory_order_relaxed);
+    return task_partition_;
+  } // task_partition
+
+  /*!
+    Set the partition of the index spaces on which the current task
+    should compute.
+
+    @param partition The partition.
+   */
+
+  void set_task_partition(partition_t partition) {
+    task_partition_ = partition;
+    task_partition_read_.store(false, std::memory_order_relaxed);
+  } // set_task_partition
+
+  /*!
+    Return true if the partition has been read by task_partition() since
+    it was last set. The runtime uses this to check that a split task
+    restricts its computation to its partition, since it would otherwise
+    compute every index once per partition.
+   */
+
+  bool task_partition_read() const {
+    return task_partition_read_.load(std::memory_order_relaxed);
+  } // task_partition_read
+
 private:
   // Default constructor
   context__() : CONTEXT_POLICY() {}
@@ -791,6 +1036,91 @@ private:
   context__(context__ &&) = delete;
   context__ & operator=(context__ &&) = delete;
 
+  // Identifies the coloring cache files, see use_coloring_cache.
+  static constexpr size_t coloring_cache_magic = 0x464c435349434f4c;
+
+  void write_coloring_cache_header(std::ostream & stream) const {
+    namespace cache = flecsi::coloring::cache;
+
+    cache::write(stream, coloring_cache_magic);
+    cache::write(stream, flecsi::coloring::coloring_cache_version);
+    cache::write(stream, coloring_cache_key_);
+    cache::write(stream, CONTEXT_POLICY::colors());
+    cache::write(stream, CONTEXT_POLICY::color());
+  } // write_coloring_cache_header
+
+  // Load the colorings from the cache file. The context is only modified
+  // if the whole file matches and could be read.
+  bool load_coloring_cache() {
+    namespace cache = flecsi::coloring::cache;
+
+    std::ifstream stream(coloring_cache_file_, std::ios::binary);
+
+    if (!stream) {
+      return false;
+    } // if
+
+    // The header must match the one that this run would write.
+    std::stringstream expected;
+    write_coloring_cache_header(expected);
+    const std::string header = expected.str();
+
+    std::string found(header.size(), '\0');
+    stream.read(&found[0], found.size());
+
+    if (!stream || found != header) {
+      clog(warn) << "ignoring coloring cache file " << coloring_cache_file_
+                 << " of another input" << std::endl;
+      return false;
+    } // if
+
+    std::map<size_t, index_coloring_t> colorings;
+    std::map<size_t, std::unordered_map<size_t, coloring_info_t>>
+        coloring_info;
+    std::map<size_t, adjacency_info_t> adjacency_info;
+    std::map<size_t, std::vector<size_t>> entity_orders;
+    std::map<size_t, std::vector<size_t>> index_maps;
+    size_t magic(0);
+
+    cache::read(stream, colorings);
+    cache::read(stream, coloring_info);
+    cache::read(stream, adjacency_info);
+    cache::read(stream, entity_orders);
+    cache::read(stream, index_maps);
+    cache::read(stream, magic);
+
+    if (!stream || magic != coloring_cache_magic) {
+      clog(warn) << "ignoring truncated coloring cache file "
+                 << coloring_cache_file_ << std::endl;
+      return false;
+    } // if
+
+    colorings_ = std::move(colorings);
+    coloring_info_ = std::move(coloring_info);
+    adjacency_info_ = std::move(adjacency_info);
+    entity_orders_ = std::move(entity_orders);
+
+    for (auto & im : index_maps) {
+      add_index_map(im.first, im.second);
+    } // for
+
+    return true;
+  } // load_coloring_cache
+
+  // Build the reverse index map from the index map of an index space.
+  void add_reverse_index_map(size_t index_space) {
+    const auto & index_map = index_map_.at(index_space);
+
+    reverse_index_map_t::storage_t entries;
+    entries.reserve(index_map.size());
+
+    for (auto & i : index_map) {
+      entries.emplace_back(i.second, i.first);
+    } // for
+
+    reverse_index_map_[index_space] = reverse_index_map_t(std::move(entries));
+  } // add_reverse_index_map
+
   //--------------------------------------------------------------------------//
   // Object data members.
   //--------------------------------------------------------------------------//
@@ -840,12 +1170,28 @@ private:
 
   std::map<size_t, index_coloring_t> colorings_;
 
+  //--------------------------------------------------------------------------//
+  // key: virtual index space id
+  // value: mesh ids in the local order of the exclusive entities
+  //--------------------------------------------------------------------------//
+
+  std::map<size_t, std::vector<size_t>> entity_orders_;
+
+  //--------------------------------------------------------------------------//
+  // The coloring cache file and the key of its input, see
+  // use_coloring_cache.
+  //--------------------------------------------------------------------------//
+
+  std::string coloring_cache_file_;
+  size_t coloring_cache_key_ = 0;
+  bool colorings_cached_ = false;
+
   //--------------------------------------------------------------------------//
   // key: mesh index space entity id
   //--------------------------------------------------------------------------//
 
-  std::map<size_t, std::map<size_t, size_t>> index_map_;
-  std::map<size_t, std::map<size_t, size_t>> reverse_index_map_;
+  std::map<size_t, index_map_t> index_map_;
+  std::map<size_t, reverse_index_map_t> reverse_index_map_;
 
   //--------------------------------------------------------------------------//
   // key: index space
@@ -859,8 +1205,8 @@ private:
 #endif
 
   // key: mesh index space entity id
-  std::map<size_t, std::map<size_t, size_t>> cis_to_gis_map_;
-  std::map<size_t, std::map<size_t, size_t>> gis_to_cis_map_;
+  std::map<size_t, index_map_t> cis_to_gis_map_;
+  std::map<size_t, reverse_index_map_t> gis_to_cis_map_;
 
   //--------------------------------------------------------------------------//
   // Data members for ntermediate mapping
@@ -960,6 +1306,13 @@ private:
 
   size_t execution_state_ = SPECIALIZATION_TLT_INIT;
 
+  //--------------------------------------------------------------------------//
+  // Partition of the currently executing task
+  //--------------------------------------------------------------------------//
+
+  partition_t task_partition_ = owned;
+  mutable std::atomic<bool> task_partition_read_{false};
+
 }; // class context__
 
 } // namespace execution
@@ -17,11 +17,109 @@
   @file
  */
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include <flecsi-config.h>
+#include <flecsi/concurrency/kernel_pool.h>
+#include <flecsi/execution/common/reduction.h>
 #include <flecsi/topology/index_space.h>
 
 namespace flecsi {
 namespace execution {
 
+//----------------------------------------------------------------------------//
+//! Scheduling of the offsets of an index space on the kernel threads.
+//! With static scheduling, the chunks are assigned to the threads
+//! cyclically, and the default chunk size gives one chunk per thread.
+//! With dynamic scheduling, the threads take the next chunk as they
+//! become idle.
+//!
+//! @ingroup execution
+//----------------------------------------------------------------------------//
+
+enum kernel_schedule_t : size_t {
+  static_schedule,
+  dynamic_schedule
+}; // enum kernel_schedule_t
+
+//! Minimum number of offsets per chunk. Smaller index spaces are
+//! traversed serially.
+constexpr size_t kernel_grain = 256;
+
+//----------------------------------------------------------------------------//
+//! Return the thread pool that executes kernels. The number of threads
+//! is set by FLECSI_KERNEL_THREADS and can be changed at runtime with
+//! kernel_pool::resize.
+//!
+//! @ingroup execution
+//----------------------------------------------------------------------------//
+
+inline kernel_pool &
+kernel_threads() {
+#if defined(FLECSI_KERNEL_THREADS)
+  static kernel_pool pool(FLECSI_KERNEL_THREADS);
+#else
+  static kernel_pool pool;
+#endif
+  return pool;
+} // kernel_threads
+
+//----------------------------------------------------------------------------//
+//! Split the offset range [begin, end) into chunks and execute them on
+//! the kernel threads. The function is called with the bounds of each
+//! chunk and the index of the executing thread. The range is executed
+//! serially by thread zero if it is too small or if the kernel threads
+//! are busy.
+//----------------------------------------------------------------------------//
+
+template<typename FUNCTION>
+inline void
+for_each_chunk__(
+    size_t begin,
+    size_t end,
+    kernel_schedule_t schedule,
+    size_t chunk,
+    FUNCTION && function) {
+  auto & pool = kernel_threads();
+  const size_t threads = pool.num_threads();
+  const size_t size = end - begin;
+
+  if (chunk == 0) {
+    chunk = schedule == static_schedule ?
+      std::max((size + threads - 1) / threads, kernel_grain) : kernel_grain;
+  } // if
+
+  const size_t chunks = (size + chunk - 1) / chunk;
+
+  if (threads == 1 || chunks <= 1) {
+    function(begin, end, 0);
+    return;
+  } // if
+
+  std::atomic<size_t> next(0);
+
+  const bool parallel = pool.run([&](size_t thread) {
+    if (schedule == static_schedule) {
+      for (size_t c(thread); c < chunks; c += threads) {
+        const size_t b = begin + c * chunk;
+        function(b, std::min(b + chunk, end), thread);
+      } // for
+    }
+    else {
+      for (size_t c(next++); c < chunks; c = next++) {
+        const size_t b = begin + c * chunk;
+        function(b, std::min(b + chunk, end), thread);
+      } // for
+    } // if
+  });
+
+  if (!parallel) {
+    function(begin, end, 0);
+  } // if
+} // for_each_chunk__
+
 //----------------------------------------------------------------------------//
 //! Abstraction function for fine-grained, data-parallel interface.
 //!
@@ -38,7 +136,12 @@ namespace execution {
 //!
 //! @param index_space  The index space over which to execute the calleable
 //!                     object.
-//! @param function     The calleable object instance.
+//! @param function     The calleable object instance. It may be called
+//!                     concurrently for different entities.
+//! @param schedule     The scheduling of the entities on the kernel
+//!                     threads.
+//! @param chunk        The number of entities per chunk, or zero for the
+//!                     default.
 //!
 //! @ingroup execution
 //----------------------------------------------------------------------------//
@@ -55,12 +158,15 @@ for_each__(
     flecsi::topology::
         index_space__<ENTITY_TYPE, STORAGE, OWNED, SORTED, PREDICATE> &
             index_space,
-    FUNCTION && function) {
-  const size_t end = index_space.end_offset();
-
-  for (size_t i(index_space.begin_offset()); i < end; ++i) {
-    function(std::forward<ENTITY_TYPE>(index_space.get_offset(i)));
-  } // for
+    FUNCTION && function,
+    kernel_schedule_t schedule = static_schedule,
+    size_t chunk = 0) {
+  for_each_chunk__(index_space.begin_offset(), index_space.end_offset(),
+    schedule, chunk, [&](size_t begin, size_t end, size_t) {
+      for (size_t i(begin); i < end; ++i) {
+        function(std::forward<ENTITY_TYPE>(index_space.get_offset(i)));
+      } // for
+    });
 } // for_each__
 
 //----------------------------------------------------------------------------//
@@ -77,15 +183,28 @@ for_each__(
 //!                     indices matching particular criteria.
 //! @tparam FUNCTION    The calleable object type.
 //! @tparam REDUCTION   The reduction variabel type.
+//! @tparam OP          The reduction operator, which combines the partial
+//!                     reductions of the kernel threads. It must be
+//!                     commutative, and its identity initializes the
+//!                     partial reductions.
 //!
 //! @param index_space  The index space over which to execute the calleable
 //!                     object.
-//! @param function     The calleable object instance.
+//! @param reduction    The reduction variable, which is combined with the
+//!                     partial reductions.
+//! @param function     The calleable object instance. It may be called
+//!                     concurrently for different entities, each with
+//!                     the partial reduction of the executing thread.
+//! @param schedule     The scheduling of the entities on the kernel
+//!                     threads.
+//! @param chunk        The number of entities per chunk, or zero for the
+//!                     default.
 //!
 //! @ingroup execution
 //----------------------------------------------------------------------------//
 
 template<
+    typename OP = reduction::sum,
     typename ENTITY_TYPE,
     bool STORAGE,
     bool OWNED,
@@ -99,12 +218,46 @@ reduce_each__(
         index_space__<ENTITY_TYPE, STORAGE, OWNED, SORTED, PREDICATE> &
             index_space,
     REDUCTION & reduction,
-    FUNCTION && function) {
-  size_t end = index_space.end_offset();
+    FUNCTION && function,
+    kernel_schedule_t schedule = static_schedule,
+    size_t chunk = 0) {
+  // The partial reductions of the kernel threads.
+  std::vector<REDUCTION> partials(kernel_threads().num_threads(),
+    flecsi::execution::reduction::identity<OP, REDUCTION>());
+  bool serial = false;
+
+  for_each_chunk__(index_space.begin_offset(), index_space.end_offset(),
+    schedule, chunk, [&](size_t begin, size_t end, size_t thread) {
+      // A chunk that spans the index space is executed serially and
+      // reduces directly into the reduction variable.
+      if (begin == index_space.begin_offset() &&
+        end == index_space.end_offset()) {
+        serial = true;
+
+        for (size_t i(begin); i < end; ++i) {
+          function(std::forward<ENTITY_TYPE>(index_space.get_offset(i)),
+            reduction);
+        } // for
+
+        return;
+      } // if
+
+      REDUCTION partial =
+        flecsi::execution::reduction::identity<OP, REDUCTION>();
+
+      for (size_t i(begin); i < end; ++i) {
+        function(std::forward<ENTITY_TYPE>(index_space.get_offset(i)),
+          partial);
+      } // for
+
+      OP::apply(partials[thread], partial);
+    });
 
-  for (size_t i(index_space.begin_offset()); i < end; ++i) {
-    function(std::forward<ENTITY_TYPE>(index_space.get_offset(i)), reduction);
-  } // for
+  if (!serial) {
+    for (auto & partial : partials) {
+      OP::apply(reduction, partial);
+    } // for
+  } // if
 } // reduce_each__
 
 } // namespace execution
@@ -136,6 +136,16 @@ struct legion_context_policy_t {
     return colors_;
   } // color
 
+  /*!
+    Return true if a condition holds on all of the colors. The
+    top-level-task initialization runs in a single task, so that this is
+    the condition itself.
+   */
+
+  bool all_colors(bool value) const {
+    return value;
+  } // all_colors
+
   //--------------------------------------------------------------------------//
   //  MPI interoperability.
   //--------------------------------------------------------------------------//
@@ -1102,20 +1102,21 @@ spmd_task(
   // This depends on the ordering of the BLIS data structure setup.
   // Currently, this is Exclusive - Shared - Ghost.
 
-  for(auto is: context_.coloring_map()) {
-    std::map<size_t, size_t> _map;
-    size_t counter(0);
+  for(auto & is: context_.coloring_map()) {
+    std::vector<size_t> _map;
+    _map.reserve(is.second.exclusive.size() + is.second.shared.size() +
+      is.second.ghost.size());
 
-    for(auto index: is.second.exclusive) {
-      _map[counter++] = index.id;
+    for(auto & index: is.second.exclusive) {
+      _map.push_back(index.id);
     } // for
 
-    for(auto index: is.second.shared) {
-      _map[counter++] = index.id;
+    for(auto & index: is.second.shared) {
+      _map.push_back(index.id);
     } // for
 
-    for(auto index: is.second.ghost) {
-      _map[counter++] = index.id;
+    for(auto & index: is.second.ghost) {
+      _map.push_back(index.id);
     } // for
 
     context_.add_index_map(is.first, _map);
@@ -1143,28 +1144,36 @@ spmd_task(
       offset += (_color_info.exclusive + _color_info.shared);
     } // for
 
+    // The global to local map is sorted once all of its entries have
+    // been added.
+    context_t::reverse_index_map_t::storage_t _gis_entries;
+    _gis_entries.reserve(is.second.exclusive.size() +
+      is.second.shared.size() + is.second.ghost.size());
+
     size_t cid{0};
     for(auto entity: is.second.exclusive) {
       size_t gid = _rank_offsets[entity.rank] + entity.offset;
       _cis_to_gis[cid] = gid;
-      _gis_to_cis[gid] = cid;
+      _gis_entries.emplace_back(gid, cid);
       ++cid;
     } // for
 
     for(auto entity: is.second.shared) {
       size_t gid = _rank_offsets[entity.rank] + entity.offset;
       _cis_to_gis[cid] = gid;
-      _gis_to_cis[gid] = cid;
+      _gis_entries.emplace_back(gid, cid);
       ++cid;
     } // for
 
     for(auto entity: is.second.ghost) {
       size_t gid = _rank_offsets[entity.rank] + entity.offset;
       _cis_to_gis[cid] = gid;
-      _gis_to_cis[gid] = cid;
+      _gis_entries.emplace_back(gid, cid);
       ++cid;
     } // for
 
+    _gis_to_cis = context_t::reverse_index_map_t(std::move(_gis_entries));
+
   } // for
 
 
@@ -14,11 +14,89 @@
 
 /*! @file */
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <unordered_map>
+
 #include <flecsi/execution/mpi/context_policy.h>
+#include <flecsi/coloring/mpi_communicator.h>
+#include <flecsi/execution/context.h>
+#include <flecsi/utils/hash.h>
 
 namespace flecsi {
 namespace execution {
 
+namespace {
+
+// The ranks of a set, with the ranks on other nodes first, so that the
+// transfers through the network start before the copies within the
+// node.
+std::vector<int>
+off_node_first(
+  const std::set<size_t> & ranks,
+  const std::set<size_t> & on_node
+)
+{
+  std::vector<int> ordered;
+  ordered.reserve(ranks.size());
+
+  for(auto rank: ranks) {
+    if(!on_node.count(rank)) {
+      ordered.push_back(rank);
+    } // if
+  } // for
+
+  for(auto rank: ranks) {
+    if(on_node.count(rank)) {
+      ordered.push_back(rank);
+    } // if
+  } // for
+
+  return ordered;
+} // off_node_first
+
+// Append n values to a byte buffer.
+template<typename T>
+void
+pack_values(
+  std::vector<uint8_t> & buffer,
+  const T * values,
+  size_t n
+)
+{
+  const uint8_t * bytes = reinterpret_cast<const uint8_t *>(values);
+  buffer.insert(buffer.end(), bytes, bytes + n * sizeof(T));
+} // pack_values
+
+// Read n values from a byte buffer and advance it past them.
+template<typename T>
+void
+unpack_values(
+  const uint8_t *& buffer,
+  T * values,
+  size_t n
+)
+{
+  std::memcpy(values, buffer, n * sizeof(T));
+  buffer += n * sizeof(T);
+} // unpack_values
+
+// The size of an entry of a sparse field, i.e., of an entry id and a
+// value, as laid out by sparse_entry_value__. The values are assumed to
+// be aligned at most like size_t.
+size_t
+sparse_entry_size(
+  size_t type_size
+)
+{
+  constexpr size_t align = alignof(size_t);
+  return (sizeof(size_t) + type_size + align - 1) / align * align;
+} // sparse_entry_size
+
+} // namespace
+
 //----------------------------------------------------------------------------//
 // Implementation of mpi_context_policy_t::initialize.
 //----------------------------------------------------------------------------//
@@ -32,11 +110,1060 @@ mpi_context_policy_t::initialize(
   MPI_Comm_rank(MPI_COMM_WORLD, &color_);
   MPI_Comm_size(MPI_COMM_WORLD, &colors_);
 
+#if defined(FLECSI_MPI_TASK_THREADS)
+  task_pool_.start(FLECSI_MPI_TASK_THREADS);
+#endif
+
   runtime_driver(argc, argv);
 
+  // The reduction datatypes and operator are released before MPI is
+  // finalized.
+  finalize_reductions();
+
   return 0;
 } // mpi_context_policy_t::initialize
 
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::start_ghost_update.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::start_ghost_update(
+  size_t index_space,
+  const coloring_info_t & coloring_info,
+  const std::set<field_id_t> & fids
+)
+{
+  auto & update = ghost_updates_[index_space];
+
+  clog_assert(!update.in_progress(),
+    "ghost update already in progress on index space " << index_space);
+
+  update.coloring_info = &coloring_info;
+  update.fids = fids;
+
+#if defined(FLECSI_ENABLE_MPI_NEIGHBORHOOD_COLLECTIVES)
+  // Create the graph communicator of the index space on first use. The
+  // ranks are not reordered, so that they match MPI_COMM_WORLD. The
+  // neighbors on other nodes come first, like for the point-to-point
+  // updates.
+  if(update.comm == MPI_COMM_NULL) {
+    update.sources = off_node_first(coloring_info.ghost_owners,
+      coloring_info.ghost_owners_on_node);
+    update.destinations = off_node_first(coloring_info.shared_users,
+      coloring_info.shared_users_on_node);
+
+    MPI_Dist_graph_create_adjacent(MPI_COMM_WORLD,
+      update.sources.size(), update.sources.data(), MPI_UNWEIGHTED,
+      update.destinations.size(), update.destinations.data(), MPI_UNWEIGHTED,
+      MPI_INFO_NULL, 0, &update.comm);
+  } // if
+
+  // Build the exchange schedule for this set of fields on first use.
+  auto sita = update.schedules.find(fids);
+
+  if(sita == update.schedules.end()) {
+    ghost_schedule_t schedule;
+
+    int offset = 0;
+    for(auto ghost_owner: update.sources) {
+      int size = 0;
+
+      for(auto fid: fids) {
+        int field_size;
+        MPI_Type_size(field_metadata.at(fid).origin_types.at(ghost_owner),
+          &field_size);
+        size += field_size;
+      } // for
+
+      schedule.recv_counts.push_back(size);
+      schedule.recv_displs.push_back(offset);
+      offset += size;
+    } // for
+
+    schedule.recv_buffer.resize(offset);
+
+    offset = 0;
+    for(auto shared_user: update.destinations) {
+      int size = 0;
+
+      for(auto fid: fids) {
+        int field_size;
+        MPI_Type_size(field_metadata.at(fid).shared_types.at(shared_user),
+          &field_size);
+        size += field_size;
+      } // for
+
+      schedule.send_counts.push_back(size);
+      schedule.send_displs.push_back(offset);
+      offset += size;
+    } // for
+
+    schedule.send_buffer.resize(offset);
+
+    sita = update.schedules.emplace(fids, std::move(schedule)).first;
+
+    // Create the persistent requests of the schedule. The buffers are
+    // not resized anymore, so that the requests stay valid.
+    auto & created = sita->second;
+    created.requests.reserve(update.sources.size() +
+      update.destinations.size());
+
+    size_t o = 0;
+    for(auto ghost_owner: update.sources) {
+      created.requests.push_back(MPI_REQUEST_NULL);
+      MPI_Recv_init(created.recv_buffer.data() + created.recv_displs[o],
+        created.recv_counts[o], MPI_PACKED, ghost_owner, ghost_tag,
+        update.comm, &created.requests.back());
+      ++o;
+    } // for
+
+    size_t u = 0;
+    for(auto shared_user: update.destinations) {
+      created.requests.push_back(MPI_REQUEST_NULL);
+      MPI_Send_init(created.send_buffer.data() + created.send_displs[u],
+        created.send_counts[u], MPI_PACKED, shared_user, ghost_tag,
+        update.comm, &created.requests.back());
+      ++u;
+    } // for
+  } // if
+
+  auto & schedule = sita->second;
+  update.schedule = &schedule;
+
+  // Pack the shared data of all fields for each of the users.
+  size_t u = 0;
+  for(auto shared_user: update.destinations) {
+    int position = schedule.send_displs[u];
+
+    for(auto fid: fids) {
+      auto & metadata = field_metadata.at(fid);
+      auto shared_data = field_data.at(fid).data() +
+        coloring_info.exclusive * metadata.type_size;
+
+      MPI_Pack(shared_data, 1, metadata.shared_types.at(shared_user),
+        schedule.send_buffer.data(), schedule.send_buffer.size(), &position,
+        update.comm);
+    } // for
+
+    clog_assert(position == schedule.send_displs[u] + schedule.send_counts[u],
+      "packed size does not match the type size");
+    ++u;
+  } // for
+
+  // A rank without neighbors has no requests to start.
+  if(!schedule.requests.empty()) {
+    MPI_Startall(schedule.requests.size(), schedule.requests.data());
+  } // if
+#else
+  update.requests.reserve(coloring_info.ghost_owners.size() +
+    coloring_info.shared_users.size());
+
+  // Post the receives for the packed ghost data of all fields.
+  for(auto ghost_owner: coloring_info.ghost_owners) {
+    int size = 0;
+
+    for(auto fid: fids) {
+      int field_size;
+      MPI_Pack_size(1, field_metadata.at(fid).origin_types.at(ghost_owner),
+        MPI_COMM_WORLD, &field_size);
+      size += field_size;
+    } // for
+
+    auto & buffer = update.recv_buffers[ghost_owner];
+    buffer.resize(size);
+
+    update.requests.push_back(MPI_REQUEST_NULL);
+    MPI_Irecv(buffer.data(), size, MPI_PACKED, ghost_owner, ghost_tag,
+      MPI_COMM_WORLD, &update.requests.back());
+  } // for
+
+  // Pack the shared data of all fields and send it to the users, the
+  // users on other nodes first.
+  for(auto shared_user: off_node_first(coloring_info.shared_users,
+    coloring_info.shared_users_on_node)) {
+    int size = 0;
+
+    for(auto fid: fids) {
+      int field_size;
+      MPI_Pack_size(1, field_metadata.at(fid).shared_types.at(shared_user),
+        MPI_COMM_WORLD, &field_size);
+      size += field_size;
+    } // for
+
+    auto & buffer = update.send_buffers[shared_user];
+    buffer.resize(size);
+
+    int position = 0;
+    for(auto fid: fids) {
+      auto & metadata = field_metadata.at(fid);
+      auto shared_data = field_data.at(fid).data() +
+        coloring_info.exclusive * metadata.type_size;
+
+      MPI_Pack(shared_data, 1, metadata.shared_types.at(shared_user),
+        buffer.data(), size, &position, MPI_COMM_WORLD);
+    } // for
+
+    update.requests.push_back(MPI_REQUEST_NULL);
+    MPI_Isend(buffer.data(), position, MPI_PACKED, shared_user, ghost_tag,
+      MPI_COMM_WORLD, &update.requests.back());
+  } // for
+#endif
+} // mpi_context_policy_t::start_ghost_update
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::finish_ghost_update.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::finish_ghost_update(
+  size_t index_space
+)
+{
+  auto & update = ghost_updates_.at(index_space);
+  auto & coloring_info = *update.coloring_info;
+
+  // Unpack the ghost data in the same field order.
+#if defined(FLECSI_ENABLE_MPI_NEIGHBORHOOD_COLLECTIVES)
+  auto & schedule = *update.schedule;
+  update.schedule = nullptr;
+
+  // The persistent requests become inactive, but are not freed.
+  MPI_Waitall(schedule.requests.size(), schedule.requests.data(),
+    MPI_STATUSES_IGNORE);
+
+  size_t o = 0;
+  for(auto ghost_owner: update.sources) {
+    int position = schedule.recv_displs[o++];
+
+    for(auto fid: update.fids) {
+      auto & metadata = field_metadata.at(fid);
+      auto ghost_data = field_data.at(fid).data() +
+        (coloring_info.exclusive + coloring_info.shared) * metadata.type_size;
+
+      MPI_Unpack(schedule.recv_buffer.data(), schedule.recv_buffer.size(),
+        &position, ghost_data, 1, metadata.origin_types.at(ghost_owner),
+        update.comm);
+    } // for
+  } // for
+#else
+  MPI_Waitall(update.requests.size(), update.requests.data(),
+    MPI_STATUSES_IGNORE);
+  update.requests.clear();
+
+  for(auto ghost_owner: coloring_info.ghost_owners) {
+    auto & buffer = update.recv_buffers[ghost_owner];
+
+    int position = 0;
+    for(auto fid: update.fids) {
+      auto & metadata = field_metadata.at(fid);
+      auto ghost_data = field_data.at(fid).data() +
+        (coloring_info.exclusive + coloring_info.shared) * metadata.type_size;
+
+      MPI_Unpack(buffer.data(), buffer.size(), &position, ghost_data, 1,
+        metadata.origin_types.at(ghost_owner), MPI_COMM_WORLD);
+    } // for
+  } // for
+#endif
+
+  for(auto fid: update.fids) {
+    auto & metadata = field_metadata.at(fid);
+    metadata.ghost_version = metadata.version;
+  } // for
+} // mpi_context_policy_t::finish_ghost_update
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::repartition.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::repartition(
+  size_t index_space,
+  const std::set<size_t> & primary,
+  const std::set<size_t> & ghost
+)
+{
+  auto & context = context_t::instance();
+  flecsi::coloring::mpi_communicator_t communicator;
+
+  // The queued tasks may still access the fields.
+  wait_on_tasks();
+
+  {
+  auto ita = ghost_updates_.find(index_space);
+  clog_assert(ita == ghost_updates_.end() || !ita->second.in_progress(),
+    "ghost update in progress on index space " << index_space);
+  } // scope
+
+  // The mesh ids of the previous primary entities, in the order of the
+  // field data.
+  std::vector<size_t> old_ids;
+  {
+  const auto & old_info = context.coloring_info(index_space).at(color_);
+  const auto & index_map = context.index_map(index_space);
+
+  old_ids.reserve(old_info.exclusive + old_info.shared);
+
+  for(size_t i{0}; i < old_info.exclusive + old_info.shared; ++i) {
+    old_ids.push_back(index_map.at(i));
+  } // for
+  } // scope
+
+  //--------------------------------------------------------------------------//
+  // Compute the new coloring, like the specialization does for the
+  // initial one.
+  //--------------------------------------------------------------------------//
+
+  {
+  index_coloring_t coloring;
+  coloring_info_t color_info;
+
+  auto primary_info = communicator.get_primary_info(primary, ghost);
+
+  size_t offset(0);
+  auto pita = primary.begin();
+  for(auto & users: primary_info.first) {
+    const flecsi::coloring::entity_info_t entity(*pita++, color_, offset++,
+      users);
+
+    if(users.empty()) {
+      coloring.exclusive.insert(entity);
+    }
+    else {
+      coloring.shared.insert(entity);
+      color_info.shared_users.insert(users.begin(), users.end());
+    } // if
+  } // for
+
+  for(auto & entity: primary_info.second) {
+    coloring.ghost.insert(entity);
+    color_info.ghost_owners.insert(entity.rank);
+  } // for
+
+  color_info.exclusive = coloring.exclusive.size();
+  color_info.shared = coloring.shared.size();
+  color_info.ghost = coloring.ghost.size();
+
+  auto coloring_info = communicator.gather_coloring_info(color_info);
+
+  context.update_coloring(index_space, coloring, coloring_info);
+  } // scope
+
+  remap_shared_entities(index_space);
+  build_index_maps(index_space);
+
+  const auto & new_info = context.coloring_info(index_space).at(color_);
+  const size_t num_total = new_info.exclusive + new_info.shared +
+    new_info.ghost;
+
+  //--------------------------------------------------------------------------//
+  // Select the fields to migrate, and release the topology.
+  //--------------------------------------------------------------------------//
+
+  std::vector<field_id_t> dense_fids;
+  std::vector<size_t> dense_sizes;
+  std::vector<field_id_t> sparse_fids;
+
+  for(auto & fi: context.registered_fields()) {
+    // The internal topology fields reside in the index spaces of the
+    // entities, or of the adjacencies between them.
+    if(utils::hash::is_internal(fi.key)) {
+      bool topology = fi.index_space == index_space;
+
+      auto ita = context.adjacency_info().find(fi.index_space);
+      if(ita != context.adjacency_info().end()) {
+        topology = topology || ita->second.from_index_space == index_space ||
+          ita->second.to_index_space == index_space;
+      } // if
+
+      if(topology && field_data.erase(fi.fid)) {
+        released_topology_fields_.insert(fi.fid);
+      } // if
+
+      continue;
+    } // if
+
+    if(fi.index_space != index_space) {
+      continue;
+    } // if
+
+    if(field_data.count(fi.fid)) {
+      dense_fids.push_back(fi.fid);
+      dense_sizes.push_back(fi.size);
+    }
+    else if(sparse_field_data.count(fi.fid)) {
+      sparse_fids.push_back(fi.fid);
+    } // if
+  } // for
+
+  //--------------------------------------------------------------------------//
+  // Find the previous owner of each new local entity through a
+  // directory that is distributed by mesh id. The previous owners offer
+  // the offsets of their primary entities and the new holders request
+  // them for their new positions.
+  //--------------------------------------------------------------------------//
+
+  enum : size_t { offer, request };
+
+  std::map<size_t, std::vector<size_t>> directory_send;
+
+  for(size_t i{0}; i < old_ids.size(); ++i) {
+    directory_send[old_ids[i] % colors_].insert(
+      directory_send[old_ids[i] % colors_].end(), {old_ids[i], offer, i});
+  } // for
+
+  for(auto & entry: context.index_map(index_space)) {
+    directory_send[entry.second % colors_].insert(
+      directory_send[entry.second % colors_].end(),
+      {entry.second, request, entry.first});
+  } // for
+
+  auto directory_recv = communicator.sparse_exchange(directory_send);
+  directory_send.clear();
+
+  // key: mesh id, value: previous owner and offset
+  std::unordered_map<size_t, std::pair<size_t, size_t>> owners;
+
+  for(auto & recv: directory_recv) {
+    for(size_t i{0}; i < recv.second.size(); i += 3) {
+      if(recv.second[i + 1] == offer) {
+        owners[recv.second[i]] = {recv.first, recv.second[i + 2]};
+      } // if
+    } // for
+  } // for
+
+  // Forward the requests to the previous owners as (offset, requester,
+  // position) triples.
+  std::map<size_t, std::vector<size_t>> owner_send;
+
+  for(auto & recv: directory_recv) {
+    for(size_t i{0}; i < recv.second.size(); i += 3) {
+      if(recv.second[i + 1] == request) {
+        auto ita = owners.find(recv.second[i]);
+        clog_assert(ita != owners.end(),
+          "entity " << recv.second[i] << " has no previous owner");
+
+        owner_send[ita->second.first].insert(
+          owner_send[ita->second.first].end(),
+          {ita->second.second, recv.first, recv.second[i + 2]});
+      } // if
+    } // for
+  } // for
+
+  directory_recv.clear();
+  owners.clear();
+
+  auto owner_recv = communicator.sparse_exchange(owner_send);
+  owner_send.clear();
+
+  //--------------------------------------------------------------------------//
+  // Send the field data to the new holders. Each message holds the
+  // number of entities and their new positions, followed by the values
+  // of the dense fields and by the entry counts and entries of the
+  // sparse fields, in the order of the entities.
+  //--------------------------------------------------------------------------//
+
+  // key: requester, value: (previous offset, new position) pairs
+  std::map<size_t, std::vector<std::pair<size_t, size_t>>> moves;
+
+  for(auto & recv: owner_recv) {
+    for(size_t i{0}; i < recv.second.size(); i += 3) {
+      moves[recv.second[i + 1]].emplace_back(recv.second[i],
+        recv.second[i + 2]);
+    } // for
+  } // for
+
+  owner_recv.clear();
+
+  std::map<size_t, std::vector<uint8_t>> data_send;
+
+  for(auto & move: moves) {
+    auto & buffer = data_send[move.first];
+    const size_t n = move.second.size();
+
+    pack_values(buffer, &n, 1);
+
+    for(auto & m: move.second) {
+      pack_values(buffer, &m.second, 1);
+    } // for
+
+    for(size_t f{0}; f < dense_fids.size(); ++f) {
+      const uint8_t * data = field_data.at(dense_fids[f]).data();
+
+      for(auto & m: move.second) {
+        pack_values(buffer, data + m.first * dense_sizes[f], dense_sizes[f]);
+      } // for
+    } // for
+
+    for(auto fid: sparse_fids) {
+      auto & fd = sparse_field_data.at(fid);
+      const size_t entry_size = sparse_entry_size(fd.type_size);
+
+      for(auto & m: move.second) {
+        const size_t count = fd.offsets[m.first].count();
+        pack_values(buffer, &count, 1);
+      } // for
+
+      for(auto & m: move.second) {
+        auto & offset = fd.offsets[m.first];
+        pack_values(buffer, fd.entries.data() + offset.start() * entry_size,
+          offset.count() * entry_size);
+      } // for
+    } // for
+  } // for
+
+  moves.clear();
+
+  auto data_recv = communicator.sparse_exchange(data_send);
+  data_send.clear();
+
+  //--------------------------------------------------------------------------//
+  // Unpack the field data into the new layout.
+  //--------------------------------------------------------------------------//
+
+  std::vector<std::vector<uint8_t>> new_field_data(dense_fids.size());
+
+  for(size_t f{0}; f < dense_fids.size(); ++f) {
+    new_field_data[f].resize(dense_sizes[f] * num_total);
+  } // for
+
+  // The entry count and entries of each new position of the sparse
+  // fields. The entries point into the received messages.
+  std::vector<std::vector<std::pair<size_t, const uint8_t *>>>
+    new_entries(sparse_fids.size(),
+      std::vector<std::pair<size_t, const uint8_t *>>(num_total, {0, nullptr}));
+
+  size_t received(0);
+  std::vector<size_t> positions;
+
+  for(auto & recv: data_recv) {
+    const uint8_t * buffer = recv.second.data();
+    size_t n;
+
+    unpack_values(buffer, &n, 1);
+    positions.resize(n);
+    unpack_values(buffer, positions.data(), n);
+    received += n;
+
+    for(size_t f{0}; f < dense_fids.size(); ++f) {
+      for(auto position: positions) {
+        unpack_values(buffer,
+          new_field_data[f].data() + position * dense_sizes[f],
+          dense_sizes[f]);
+      } // for
+    } // for
+
+    for(size_t s{0}; s < sparse_fids.size(); ++s) {
+      const size_t entry_size =
+        sparse_entry_size(sparse_field_data.at(sparse_fids[s]).type_size);
+
+      for(auto position: positions) {
+        unpack_values(buffer, &new_entries[s][position].first, 1);
+      } // for
+
+      for(auto position: positions) {
+        new_entries[s][position].second = buffer;
+        buffer += new_entries[s][position].first * entry_size;
+      } // for
+    } // for
+  } // for
+
+  clog_assert(received == num_total,
+    "received " << received << " of " << num_total << " entities");
+
+  //--------------------------------------------------------------------------//
+  // Release the ghost metadata, which depends on the coloring, and
+  // replace the field data.
+  //--------------------------------------------------------------------------//
+
+  {
+  auto ita = ghost_updates_.find(index_space);
+
+  if(ita != ghost_updates_.end()) {
+#if defined(FLECSI_ENABLE_MPI_NEIGHBORHOOD_COLLECTIVES)
+    for(auto & schedule: ita->second.schedules) {
+      for(auto & request: schedule.second.requests) {
+        MPI_Request_free(&request);
+      } // for
+    } // for
+
+    if(ita->second.comm != MPI_COMM_NULL) {
+      MPI_Comm_free(&ita->second.comm);
+    } // if
+#endif
+
+    ghost_updates_.erase(ita);
+  } // if
+  } // scope
+
+  for(size_t f{0}; f < dense_fids.size(); ++f) {
+    auto ita = field_metadata.find(dense_fids[f]);
+
+    if(ita != field_metadata.end()) {
+      auto & metadata = ita->second;
+
+      for(auto types: {&metadata.origin_types, &metadata.shared_types}) {
+        for(auto & type: *types) {
+          MPI_Type_free(&type.second);
+        } // for
+      } // for
+
+      field_metadata.erase(ita);
+    } // if
+
+    field_data.at(dense_fids[f]).swap(new_field_data[f]);
+  } // for
+
+  for(size_t s{0}; s < sparse_fids.size(); ++s) {
+    auto ita = sparse_field_metadata.find(sparse_fids[s]);
+
+    if(ita != sparse_field_metadata.end()) {
+      auto & metadata = ita->second;
+
+      for(auto types: {&metadata.origin_types, &metadata.target_types}) {
+        for(auto & type: *types) {
+          MPI_Type_free(&type.second);
+        } // for
+      } // for
+
+      MPI_Group_free(&metadata.shared_users_grp);
+      MPI_Group_free(&metadata.ghost_owners_grp);
+      MPI_Win_free(&metadata.win);
+
+      sparse_field_metadata.erase(ita);
+    } // if
+
+    // The exclusive entries are packed in the order of the indices, and
+    // each shared and ghost index has max_entries_per_index slots after
+    // the reserve.
+    auto & fd = sparse_field_data.at(sparse_fids[s]);
+    const size_t entry_size = sparse_entry_size(fd.type_size);
+
+    sparse_field_data_t data(fd.type_size, new_info.exclusive,
+      new_info.shared, new_info.ghost, fd.max_entries_per_index,
+      fd.reserve_chunk);
+
+    for(size_t i{0}; i < new_info.exclusive; ++i) {
+      data.num_exclusive_entries += new_entries[s][i].first;
+    } // for
+
+    data.reserve = std::max(data.reserve_chunk,
+      (data.num_exclusive_entries + data.reserve_chunk - 1) /
+      data.reserve_chunk * data.reserve_chunk);
+    data.entries.resize(entry_size * (data.reserve +
+      (new_info.shared + new_info.ghost) * data.max_entries_per_index));
+
+    size_t start(0);
+    for(size_t i{0}; i < num_total; ++i) {
+      const size_t count = new_entries[s][i].first;
+
+      if(i < new_info.exclusive) {
+        data.offsets[i] = sparse_field_data_t::offset_t(start, count);
+        start += count;
+      }
+      else {
+        clog_assert(count <= data.max_entries_per_index,
+          "too many entries for index " << i);
+
+        data.offsets[i] = sparse_field_data_t::offset_t(data.reserve +
+          (i - new_info.exclusive) * data.max_entries_per_index, count);
+      } // if
+
+      if(count) {
+        std::memcpy(data.entries.data() +
+          data.offsets[i].start() * entry_size, new_entries[s][i].second,
+          count * entry_size);
+      } // if
+    } // for
+
+    fd = std::move(data);
+  } // for
+} // mpi_context_policy_t::repartition
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::queue_task.
+//----------------------------------------------------------------------------//
+
+std::shared_future<void>
+mpi_context_policy_t::queue_task(
+  std::function<void()> task,
+  const std::set<field_id_t> & read_fields,
+  const std::set<field_id_t> & written_fields,
+  std::vector<std::shared_future<void>> dependencies
+)
+{
+  auto ready = [](const std::shared_future<void> & f) {
+    return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  };
+
+  // Read after write
+  for(auto fid: read_fields) {
+    auto & access = field_access_[fid];
+
+    if(access.writer.valid() && !ready(access.writer)) {
+      dependencies.push_back(access.writer);
+    } // if
+  } // for
+
+  // Write after write and write after read
+  for(auto fid: written_fields) {
+    auto & access = field_access_[fid];
+
+    if(access.writer.valid() && !ready(access.writer)) {
+      dependencies.push_back(access.writer);
+    } // if
+
+    for(auto & reader: access.readers) {
+      if(!ready(reader)) {
+        dependencies.push_back(reader);
+      } // if
+    } // for
+  } // for
+
+  auto promise = std::make_shared<std::promise<void>>();
+  std::shared_future<void> done = promise->get_future().share();
+
+  // The pool executes the tasks in the order in which they are queued,
+  // so the dependencies of a task have always been started before it.
+  task_pool_.queue([task, dependencies, promise]() {
+    try {
+      for(auto & d: dependencies) {
+        d.wait();
+      } // for
+
+      task();
+      promise->set_value();
+    }
+    catch(...) {
+      promise->set_exception(std::current_exception());
+    } // try
+  });
+
+  for(auto fid: read_fields) {
+    if(written_fields.count(fid) == 0) {
+      auto & readers = field_access_[fid].readers;
+      readers.erase(std::remove_if(readers.begin(), readers.end(), ready),
+        readers.end());
+      readers.push_back(done);
+    } // if
+  } // for
+
+  for(auto fid: written_fields) {
+    auto & access = field_access_[fid];
+    access.writer = done;
+    access.readers.clear();
+  } // for
+
+  queued_tasks_.erase(std::remove_if(queued_tasks_.begin(),
+    queued_tasks_.end(), ready), queued_tasks_.end());
+  queued_tasks_.push_back(done);
+
+  return done;
+} // mpi_context_policy_t::queue_task
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::wait_on_fields.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::wait_on_fields(
+  const std::set<field_id_t> & fids
+)
+{
+  for(auto fid: fids) {
+    auto ita = field_access_.find(fid);
+
+    if(ita == field_access_.end()) {
+      continue;
+    } // if
+
+    if(ita->second.writer.valid()) {
+      ita->second.writer.wait();
+    } // if
+
+    for(auto & reader: ita->second.readers) {
+      reader.wait();
+    } // for
+  } // for
+} // mpi_context_policy_t::wait_on_fields
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::wait_on_tasks.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::wait_on_tasks()
+{
+  for(auto & task: queued_tasks_) {
+    task.wait();
+  } // for
+
+  queued_tasks_.clear();
+  field_access_.clear();
+} // mpi_context_policy_t::wait_on_tasks
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::replay.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::replay(
+  const task_graph_t & graph
+)
+{
+  clog_assert(!capturing_, "cannot replay a task graph during capture");
+
+  std::vector<size_t> updates;
+  std::set<field_id_t> fids;
+
+  for(auto & task: graph) {
+    if(task.launch) {
+      task.launch();
+      continue;
+    } // if
+
+    // Start the updates of the stale ghost indices, aggregated per index
+    // space.
+    updates.clear();
+
+    auto ita = task.ghost_reads.begin();
+    while(ita != task.ghost_reads.end()) {
+      const size_t index_space = ita->index_space;
+      const coloring_info_t * coloring_info = ita->coloring_info;
+
+      fids.clear();
+      for(; ita != task.ghost_reads.end() &&
+        ita->index_space == index_space; ++ita) {
+        if(ita->metadata->ghost_version != ita->metadata->version) {
+          fids.insert(ita->fid);
+        } // if
+      } // for
+
+      if(!fids.empty()) {
+        if(task_threads() > 0) {
+          wait_on_fields(fids);
+        } // if
+
+        start_ghost_update(index_space, *coloring_info, fids);
+        updates.push_back(index_space);
+      } // if
+    } // while
+
+    for(auto index_space: updates) {
+      finish_ghost_update(index_space);
+    } // for
+
+    for(auto metadata: task.shared_writes) {
+      ++metadata->version;
+    } // for
+
+    for(auto metadata: task.ghost_writes) {
+      metadata->ghost_version = metadata->version;
+    } // for
+
+    if(task_threads() > 0) {
+      queue_task(task.body, task.read_fields, task.written_fields, {});
+    }
+    else {
+      task.body();
+    } // if
+  } // for
+} // mpi_context_policy_t::replay
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::add_reduction.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::add_reduction(
+  size_t size,
+  reduction_apply_t apply,
+  std::function<void(void *)> && pack,
+  std::function<void(const void *)> && unpack
+)
+{
+  if(!reductions_) {
+    auto batch = std::make_shared<reduction_batch_t>();
+
+    reductions_ = batch;
+    reductions_done_ = std::async(std::launch::deferred,
+      [this, batch]()
+      {
+        complete_reductions(*batch);
+      }).share();
+  } // if
+
+  reductions_->entries.push_back({size, apply, std::move(pack),
+    std::move(unpack)});
+} // mpi_context_policy_t::add_reduction
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::reduce_fused.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::reduce_fused(
+  void * invec,
+  void * inoutvec,
+  int * len,
+  MPI_Datatype * datatype
+)
+{
+  auto & layouts = context_t::instance().reduction_layouts_;
+  auto it = layouts.find(*datatype);
+
+  clog_assert(it != layouts.end(), "unknown reduction datatype");
+
+  const char * in = static_cast<const char *>(invec);
+  char * inout = static_cast<char *>(inoutvec);
+
+  for(int i = 0; i < *len; ++i) {
+    for(auto & value: it->second) {
+      value.second(in, inout);
+      in += value.first;
+      inout += value.first;
+    } // for
+  } // for
+} // mpi_context_policy_t::reduce_fused
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::finalize_reductions.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::finalize_reductions()
+{
+  wait_on_reductions();
+
+  for(auto & type: reduction_layouts_) {
+    MPI_Datatype datatype = type.first;
+    MPI_Type_free(&datatype);
+  } // for
+
+  reduction_layouts_.clear();
+
+  if(reduction_op_ != MPI_OP_NULL) {
+    MPI_Op_free(&reduction_op_);
+  } // if
+} // mpi_context_policy_t::finalize_reductions
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::start_reductions.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::start_reductions()
+{
+  if(!reductions_) {
+    return;
+  } // if
+
+  auto batch = std::move(reductions_);
+  auto done = std::move(reductions_done_);
+
+  started_reductions_.erase(std::remove_if(started_reductions_.begin(),
+    started_reductions_.end(),
+    [](const std::pair<std::shared_ptr<reduction_batch_t>,
+      std::shared_future<void>> & started)
+    {
+      return started.first->complete;
+    }), started_reductions_.end());
+
+  // Pack the local values. This waits for the tasks that produce them.
+  reduction_layout_t layout;
+  size_t bytes = 0;
+
+  for(auto & entry: batch->entries) {
+    layout.emplace_back(entry.size, entry.apply);
+    bytes += entry.size;
+  } // for
+
+  batch->send_buffer.resize(bytes);
+  batch->recv_buffer.resize(bytes);
+
+  char * buffer = batch->send_buffer.data();
+  for(auto & entry: batch->entries) {
+    entry.pack(buffer);
+    buffer += entry.size;
+  } // for
+
+  // Reuse the datatype of the layout, if any. There are only a few
+  // distinct layouts, e.g., one per time step pattern.
+  auto it = std::find_if(reduction_layouts_.begin(), reduction_layouts_.end(),
+    [&layout](const std::pair<const MPI_Datatype, reduction_layout_t> & type)
+    {
+      return type.second == layout;
+    });
+
+  if(it == reduction_layouts_.end()) {
+    MPI_Datatype type;
+    MPI_Type_contiguous(bytes, MPI_BYTE, &type);
+    MPI_Type_commit(&type);
+    it = reduction_layouts_.emplace(type, std::move(layout)).first;
+  } // if
+
+  if(reduction_op_ == MPI_OP_NULL) {
+    // The operators are not required to be commutative.
+    MPI_Op_create(reduce_fused, 0, &reduction_op_);
+  } // if
+
+  MPI_Iallreduce(batch->send_buffer.data(), batch->recv_buffer.data(), 1,
+    it->first, reduction_op_, MPI_COMM_WORLD, &batch->request);
+
+  batch->started = true;
+  started_reductions_.emplace_back(std::move(batch), std::move(done));
+} // mpi_context_policy_t::start_reductions
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::complete_reductions.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::complete_reductions(
+  reduction_batch_t & batch
+)
+{
+  if(batch.complete) {
+    return;
+  } // if
+
+  if(!batch.started) {
+    clog_assert(reductions_.get() == &batch,
+      "reduction batch was not started");
+    start_reductions();
+  } // if
+
+  MPI_Wait(&batch.request, MPI_STATUS_IGNORE);
+
+  const char * buffer = batch.recv_buffer.data();
+  for(auto & entry: batch.entries) {
+    entry.unpack(buffer);
+    buffer += entry.size;
+  } // for
+
+  // Release the local values and the buffers.
+  batch.entries.clear();
+  batch.send_buffer.clear();
+  batch.recv_buffer.clear();
+  batch.complete = true;
+} // mpi_context_policy_t::complete_reductions
+
+//----------------------------------------------------------------------------//
+// Implementation of mpi_context_policy_t::wait_on_reductions.
+//----------------------------------------------------------------------------//
+
+void
+mpi_context_policy_t::wait_on_reductions()
+{
+  start_reductions();
+
+  for(auto & started: started_reductions_) {
+    started.second.get();
+  } // for
+
+  started_reductions_.clear();
+} // mpi_context_policy_t::wait_on_reductions
+
 } // namespace execution 
 } // namespace flecsi
 
@@ -17,7 +17,13 @@
 
 #include <unordered_map>
 #include <map>
+#include <set>
 #include <functional>
+#include <future>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <type_traits>
 
 #include <cinchlog.h>
 #include <flecsi-config.h>
@@ -29,8 +35,10 @@
 #include <mpi.h>
 
 #include <flecsi/coloring/coloring_types.h>
+#include <flecsi/concurrency/thread_pool.h>
 #include <flecsi/execution/common/launch.h>
 #include <flecsi/execution/common/processor.h>
+#include <flecsi/execution/common/reduction.h>
 #include <flecsi/execution/mpi/runtime_driver.h>
 #include <flecsi/execution/mpi/future.h>
 #include <flecsi/runtime/types.h>
@@ -142,6 +150,17 @@ struct mpi_context_policy_t
 
   size_t colors() const { return colors_; } // color
 
+  /*!
+    Return true if a condition holds on all of the colors. This is a
+    collective operation.
+   */
+
+  bool all_colors(bool value) const {
+    int all = value;
+    MPI_Allreduce(MPI_IN_PLACE, &all, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+    return all;
+  } // all_colors
+
 
   //--------------------------------------------------------------------------//
   // Task interface.
@@ -191,6 +210,112 @@ struct mpi_context_policy_t
 //    return true;
 //  } // register_task
 
+  /*!
+   Record the launch flags with which a task was registered.
+
+   @param key    The task hash key.
+   @param launch The launch flags of the task.
+   */
+
+  void
+  register_task_launch(
+    size_t key,
+    launch_t launch
+  )
+  {
+    task_launch_[key] = launch;
+  } // register_task_launch
+
+  /*!
+   Return the launch flags with which a task was registered.
+
+   @param key The task hash key.
+   */
+
+  launch_t
+  task_launch(
+    size_t key
+  )
+  const
+  {
+    auto ita = task_launch_.find(key);
+    return ita == task_launch_.end() ? launch_t() : ita->second;
+  } // task_launch
+
+  //--------------------------------------------------------------------------//
+  // Asynchronous task interface.
+  //--------------------------------------------------------------------------//
+
+  /*!
+   Return the number of worker threads that execute tasks on this rank.
+   If this is zero, all tasks are executed inline.
+   */
+
+  size_t
+  task_threads()
+  const
+  {
+    return task_pool_.num_threads();
+  } // task_threads
+
+  /*!
+   Start the worker threads that execute tasks on this rank, unless they
+   were started with FLECSI_MPI_TASK_THREADS. The tasks that are launched
+   afterwards may be executed asynchronously.
+
+   @param threads The number of worker threads.
+   */
+
+  void
+  start_task_threads(
+    size_t threads
+  )
+  {
+    if(task_threads() == 0) {
+      task_pool_.start(threads);
+    } // if
+  } // start_task_threads
+
+  /*!
+   Queue a task for execution on the worker threads. The task does not
+   start before the last task that wrote one of the fields it accesses,
+   and the tasks that read one of the fields it writes since that write,
+   have completed.
+
+   @param task           The task body.
+   @param read_fields    The fields read by the task.
+   @param written_fields The fields written by the task.
+   @param dependencies   Additional tasks that must complete first.
+
+   @return The completion of the task.
+   */
+
+  std::shared_future<void>
+  queue_task(
+    std::function<void()> task,
+    const std::set<field_id_t> & read_fields,
+    const std::set<field_id_t> & written_fields,
+    std::vector<std::shared_future<void>> dependencies
+  );
+
+  /*!
+   Wait for the queued tasks that access any of the given fields.
+
+   @param fids The ids of the fields.
+   */
+
+  void
+  wait_on_fields(
+    const std::set<field_id_t> & fids
+  );
+
+  /*!
+   Wait for all of the queued tasks.
+   */
+
+  void
+  wait_on_tasks();
+
   //--------------------------------------------------------------------------//
   // Function interface.
   //--------------------------------------------------------------------------//
@@ -221,22 +346,29 @@ struct mpi_context_policy_t
   using index_coloring_t = flecsi::coloring::index_coloring_t;
 
   /*!
-   Field metadata is used maintain MPI information and data types for
-   MPI windows/one-sided communication to perform ghost copies.
+   Field metadata is used to maintain MPI information and data types for
+   ghost copies. The origin types describe the ghost indices that we
+   receive from each ghost owner, and the shared types describe the
+   shared indices that we send to each shared user.
    */
   struct field_metadata_t {
 
-    MPI_Group shared_users_grp;
-    MPI_Group ghost_owners_grp;
-
     std::map<int, MPI_Datatype> origin_types;
-    std::map<int, MPI_Datatype> target_types;
+    std::map<int, MPI_Datatype> shared_types;
 
-    MPI_Win win;
+    size_t type_size;
+
+    //! The version of the field data. This is advanced by every task
+    //! that writes the shared indices of the field.
+    size_t version = 0;
+
+    //! The version of the field data from which the ghost indices were
+    //! last updated.
+    size_t ghost_version = 0;
   };
 
   /*!
-   Field metadata is used maintain MPI information and data types for
+   Field metadata is used to maintain MPI information and data types for
    MPI windows/one-sided communication to perform ghost copies.
    */
   struct sparse_field_metadata_t{
@@ -257,8 +389,8 @@ struct mpi_context_policy_t
 
   /*!
    Create MPI datatypes use for ghost copy by inspecting shared regions,
-   and ghost owners, to compute origin and target lengths and displacements
-   for MPI windows.
+   and ghost owners, to compute the layouts of the ghost indices that we
+   receive and of the shared indices that we send.
    */
   template <typename T>
   void register_field_metadata(const field_id_t fid,
@@ -267,18 +399,13 @@ struct mpi_context_policy_t
     std::map<int, std::vector<int>> compact_origin_lengs;
     std::map<int, std::vector<int>> compact_origin_disps;
 
-    std::map<int, std::vector<int>> compact_target_lengs;
-    std::map<int, std::vector<int>> compact_target_disps;
-
     field_metadata_t metadata;
 
-    register_field_metadata_<T>(metadata, fid, coloring_info, index_coloring,
-      compact_origin_lengs, compact_origin_disps, compact_target_lengs,
-      compact_target_disps);
+    register_field_metadata_<T>(fid, coloring_info, index_coloring,
+      compact_origin_lengs, compact_origin_disps);
 
     for (auto ghost_owner : coloring_info.ghost_owners) {
       MPI_Datatype origin_type;
-      MPI_Datatype target_type;
 
       MPI_Type_indexed(compact_origin_lengs[ghost_owner].size(),
                        compact_origin_lengs[ghost_owner].data(),
@@ -287,22 +414,31 @@ struct mpi_context_policy_t
                        &origin_type);
       MPI_Type_commit(&origin_type);
       metadata.origin_types.insert({ghost_owner, origin_type});
+    }
 
-      MPI_Type_indexed(compact_target_lengs[ghost_owner].size(),
-                       compact_target_lengs[ghost_owner].data(),
-                       compact_target_disps[ghost_owner].data(),
-                       flecsi::coloring::mpi_typetraits__<T>::type(),
-                       &target_type);
-      MPI_Type_commit(&target_type);
-      metadata.target_types.insert({ghost_owner, target_type});
+    // The shared indices that each shared user has as ghosts. Both are
+    // ordered by entity id, so the indices are packed in the order in
+    // which the user unpacks its ghosts, as in remap_shared_entities.
+    std::map<int, std::vector<int>> shared_disps;
+
+    for (const auto & shared : index_coloring.shared) {
+      for (auto shared_user : shared.shared) {
+        shared_disps[shared_user].push_back(shared.offset);
+      }
     }
 
+    for (auto shared_user : coloring_info.shared_users) {
+      auto & disps = shared_disps[shared_user];
 
-    auto data = field_data[fid].data();
-    auto shared_data = data + coloring_info.exclusive * sizeof(T);
-    MPI_Win_create(shared_data, coloring_info.shared * sizeof(T),
-                   sizeof(T), MPI_INFO_NULL, MPI_COMM_WORLD,
-                   &metadata.win);
+      MPI_Datatype shared_type;
+      MPI_Type_create_indexed_block(disps.size(), 1, disps.data(),
+                       flecsi::coloring::mpi_typetraits__<T>::type(),
+                       &shared_type);
+      MPI_Type_commit(&shared_type);
+      metadata.shared_types.insert({shared_user, shared_type});
+    }
+
+    metadata.type_size = sizeof(T);
 
     field_metadata.insert({fid, metadata});
   }
@@ -321,8 +457,31 @@ struct mpi_context_policy_t
   {
     sparse_field_metadata_t metadata;
 
-    register_field_metadata_<T>(metadata, fid, coloring_info, index_coloring,
-      metadata.compact_origin_lengs, metadata.compact_origin_disps,
+    // The group for MPI_Win_post are the "origin" processes, i.e.
+    // the peer processes calling MPI_Get to get our shared cells. Thus
+    // granting access of local window to these processes. This is the set
+    // coloring_info_t::shared_users
+    // On the other hand, the group for MPI_Win_start are the 'target'
+    // processes, i.e. the peer processes this rank is going to get ghost
+    // cells from. This is the set coloring_info_t::ghost_owners.
+    // Since both shared_users and ghost_owners are std::set, we have copy
+    // them to std::vector be passed to MPI.
+    std::vector<int> shared_users(coloring_info.shared_users.begin(),
+                                  coloring_info.shared_users.end());
+    std::vector<int> ghost_owners(coloring_info.ghost_owners.begin(),
+                                  coloring_info.ghost_owners.end());
+
+    MPI_Group comm_grp;
+    MPI_Comm_group(MPI_COMM_WORLD, &comm_grp);
+
+    MPI_Group_incl(comm_grp, shared_users.size(),
+                   shared_users.data(), &metadata.shared_users_grp);
+    MPI_Group_incl(comm_grp, ghost_owners.size(),
+                   ghost_owners.data(), &metadata.ghost_owners_grp);
+
+    register_field_metadata_<T>(fid, coloring_info, index_coloring,
+      metadata.compact_origin_lengs, metadata.compact_origin_disps);
+    register_target_metadata_(coloring_info, index_coloring,
       metadata.compact_target_lengs, metadata.compact_target_disps);
 
     // Each shared and ghost cells element is an array of max_entries_per_index
@@ -371,61 +530,34 @@ struct mpi_context_policy_t
   }
 
   /*!
-   Compute MPI datatypes, compacted length and displacement for ghost copy
-   with MPI window.
+   Compute the compacted lengths and displacements of the ghost indices
+   that we receive from each ghost owner, which describe the origin
+   types of both the dense and the sparse ghost copies.
    */
-  template <typename T, typename MD>
+  template <typename T>
   void register_field_metadata_(
-    MD& metadata,
     const field_id_t fid,
     const coloring_info_t& coloring_info,
     const index_coloring_t& index_coloring,
     std::map<int, std::vector<int>>& compact_origin_lengs,
-    std::map<int, std::vector<int>>& compact_origin_disps,
-    std::map<int, std::vector<int>>& compact_target_lengs,
-    std::map<int, std::vector<int>>& compact_target_disps
+    std::map<int, std::vector<int>>& compact_origin_disps
   )
   {
-    // The group for MPI_Win_post are the "origin" processes, i.e.
-    // the peer processes calling MPI_Get to get our shared cells. Thus
-    // granting access of local window to these processes. This is the set
-    // coloring_info_t::shared_users
-    // On the other hand, the group for MPI_Win_start are the 'target'
-    // processes, i.e. the peer processes this rank is going to get ghost
-    // cells from. This is the set coloring_info_t::ghost_owners.
-    // Since both shared_users and ghost_owners are std::set, we have copy
-    // them to std::vector be passed to MPI.
-    std::vector<int> shared_users(coloring_info.shared_users.begin(),
-                                  coloring_info.shared_users.end());
     std::vector<int> ghost_owners(coloring_info.ghost_owners.begin(),
                                   coloring_info.ghost_owners.end());
 
-    MPI_Group comm_grp;
-    MPI_Comm_group(MPI_COMM_WORLD, &comm_grp);
-
-    MPI_Group_incl(comm_grp, shared_users.size(),
-                   shared_users.data(), &metadata.shared_users_grp);
-    MPI_Group_incl(comm_grp, ghost_owners.size(),
-                   ghost_owners.data(), &metadata.ghost_owners_grp);
-
     std::map<int, std::vector<int>> origin_lens;
     std::map<int, std::vector<int>> origin_disps;
-    std::map<int, std::vector<int>> target_lens;
-    std::map<int, std::vector<int>> target_disps;
 
     for (auto ghost_owner : ghost_owners) {
       origin_lens.insert({ghost_owner, {}});
       origin_disps.insert({ghost_owner, {}});
-      target_lens.insert({ghost_owner, {}});
-      target_disps.insert({ghost_owner, {}});
     }
 
     int origin_index = 0;
     for (const auto& ghost : index_coloring.ghost) {
       origin_lens[ghost.rank].push_back(1);
       origin_disps[ghost.rank].push_back(origin_index++);
-      target_lens[ghost.rank].push_back(1);
-      target_disps[ghost.rank].push_back(ghost.offset);
     }
 
     int my_color;
@@ -444,18 +576,6 @@ struct mpi_context_policy_t
           std::cout << len << " ";
         }
         std::cout << std::endl;
-        std::cout << "\ttarget length: ";
-        for (auto len : target_lens[ghost_owner]) {
-          std::cout << len << " ";
-        }
-        std::cout << std::endl;
-
-        std::cout << "\ttarget disp: ";
-        for (auto len : target_disps[ghost_owner]) {
-          std::cout << len << " ";
-        }
-        std::cout << std::endl;
-
       }
     }
 
@@ -494,6 +614,55 @@ struct mpi_context_policy_t
         std::cout << std::endl;
       }
     }
+  }
+
+  /*!
+   Compute the compacted lengths and displacements of the ghost indices
+   in the windows of each ghost owner, which are only read by the sparse
+   ghost copies.
+   */
+  void register_target_metadata_(
+    const coloring_info_t& coloring_info,
+    const index_coloring_t& index_coloring,
+    std::map<int, std::vector<int>>& compact_target_lengs,
+    std::map<int, std::vector<int>>& compact_target_disps
+  )
+  {
+    std::vector<int> ghost_owners(coloring_info.ghost_owners.begin(),
+                                  coloring_info.ghost_owners.end());
+
+    std::map<int, std::vector<int>> target_lens;
+    std::map<int, std::vector<int>> target_disps;
+
+    for (auto ghost_owner : ghost_owners) {
+      target_lens.insert({ghost_owner, {}});
+      target_disps.insert({ghost_owner, {}});
+    }
+
+    for (const auto& ghost : index_coloring.ghost) {
+      target_lens[ghost.rank].push_back(1);
+      target_disps[ghost.rank].push_back(ghost.offset);
+    }
+
+    int my_color;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_color);
+
+    if (my_color == 0) {
+      for (auto ghost_owner : ghost_owners) {
+        std::cout << "ghost owner: " << ghost_owner << std::endl;
+        std::cout << "\ttarget length: ";
+        for (auto len : target_lens[ghost_owner]) {
+          std::cout << len << " ";
+        }
+        std::cout << std::endl;
+
+        std::cout << "\ttarget disp: ";
+        for (auto len : target_disps[ghost_owner]) {
+          std::cout << len << " ";
+        }
+        std::cout << std::endl;
+      }
+    }
 
     for (auto ghost_owner : ghost_owners) {
       if (target_disps.size() == 0)
@@ -536,6 +705,201 @@ struct mpi_context_policy_t
     return field_metadata;
   };
 
+  /*!
+   Start the update of the ghost indices of the given dense fields from
+   their owners. All of the fields must be defined on the given index
+   space. The data of all of the fields is packed into a single message
+   per peer, so that the number of messages and synchronizations does not
+   grow with the number of fields. This call does not block; the ghost
+   indices may not be read, and the shared indices may not be written,
+   until the matching call to finish_ghost_update.
+
+   If FleCSI is configured with ENABLE_MPI_NEIGHBORHOOD_COLLECTIVES, the
+   exchange starts persistent requests to the neighbors of a distributed
+   graph communicator. The communicator is created once per index space
+   and the requests once per set of fields. Otherwise, it is a set of
+   point-to-point messages that are posted for each update. In both cases, every rank
+   must start the updates of its index spaces in the same order.
+
+   @param index_space   The index space of the fields.
+   @param coloring_info The coloring information of the index space.
+   @param fids          The ids of the fields to update.
+   */
+
+  void
+  start_ghost_update(
+    size_t index_space,
+    const coloring_info_t & coloring_info,
+    const std::set<field_id_t> & fids
+  );
+
+  /*!
+   Wait for the ghost update started on the given index space and unpack
+   the ghost indices. After the update, the ghost version of each field
+   matches its current version.
+
+   @param index_space The index space of the fields.
+   */
+
+  void
+  finish_ghost_update(
+    size_t index_space
+  );
+
+  //--------------------------------------------------------------------------//
+  // Repartition interface.
+  //--------------------------------------------------------------------------//
+
+  /*!
+   Move the entities of an index space to a new partition, e.g., to
+   balance the load between the ranks. The coloring, the coloring
+   information and the index maps of the index space are recomputed from
+   the new primary and ghost entities of each rank, and the data of the
+   dense, sparse and ragged fields of the index space is migrated from
+   the previous owners, including the ghost indices. The ghost metadata
+   of the fields is released and is rebuilt when the fields are next
+   accessed.
+
+   The mesh topology stores local ids, so it cannot be migrated. Its
+   buffers are released instead, and the specialization must initialize
+   it again, after updating the adjacency sizes with update_adjacency,
+   by executing a task that takes the data client with write-only
+   permissions. The buffers are then allocated for the new partition.
+   A task that reads the released topology before it is initialized
+   again fails with an assertion.
+
+   This must be called collectively, outside of tasks. The fields must
+   have been accessed on every rank or on none. Handles, accessors and
+   task graphs that were obtained before the call must not be used
+   afterwards.
+
+   @param index_space The index space to repartition.
+   @param primary     The mesh ids of the new primary entities of the
+                      calling rank. Every entity must be primary on
+                      exactly one rank.
+   @param ghost       The mesh ids of the new ghost entities of the
+                      calling rank.
+   */
+
+  void
+  repartition(
+    size_t index_space,
+    const std::set<size_t> & primary,
+    const std::set<size_t> & ghost
+  );
+
+  //--------------------------------------------------------------------------//
+  // Task graph interface.
+  //--------------------------------------------------------------------------//
+
+  /*!
+   A dense field whose ghost indices are read by a captured task.
+   */
+
+  struct captured_ghost_read_t {
+    size_t index_space;
+    const coloring_info_t * coloring_info;
+    field_id_t fid;
+    const field_metadata_t * metadata;
+  };
+
+  /*!
+   A task recorded during a capture, with its arguments resolved.
+   */
+
+  struct captured_task_t {
+    //! Execute the task through the full launch path. This is only set
+    //! for tasks that cannot be replayed directly.
+    std::function<void()> launch;
+
+    //! Execute the body of the task.
+    std::function<void()> body;
+
+    //! The ghost reads, ordered by index space.
+    std::vector<captured_ghost_read_t> ghost_reads;
+
+    //! The metadata of the fields whose shared indices are written.
+    std::vector<field_metadata_t *> shared_writes;
+
+    //! The metadata of the fields whose ghost indices are only written.
+    std::vector<field_metadata_t *> ghost_writes;
+
+    std::set<field_id_t> read_fields;
+    std::set<field_id_t> written_fields;
+  };
+
+  /*!
+   The task_graph_t type holds the tasks recorded during a capture in
+   launch order.
+   */
+
+  using task_graph_t = std::vector<captured_task_t>;
+
+  /*!
+   Start recording the tasks that are executed by this rank. The tasks
+   are still executed while they are recorded.
+   */
+
+  void
+  begin_capture()
+  {
+    clog_assert(!capturing_, "task capture already in progress");
+    capturing_ = true;
+    captured_tasks_.clear();
+  } // begin_capture
+
+  /*!
+   Stop recording tasks and return the recorded task graph.
+   */
+
+  task_graph_t
+  end_capture()
+  {
+    clog_assert(capturing_, "no task capture in progress");
+    capturing_ = false;
+    return std::move(captured_tasks_);
+  } // end_capture
+
+  /*!
+   Return true if tasks are currently being recorded.
+   */
+
+  bool
+  capturing()
+  const
+  {
+    return capturing_;
+  } // capturing
+
+  /*!
+   Record a task during a capture.
+   */
+
+  void
+  capture_task(
+    captured_task_t && task
+  )
+  {
+    captured_tasks_.emplace_back(std::move(task));
+  } // capture_task
+
+  /*!
+   Execute the tasks of a captured graph in launch order. The tasks reuse
+   the arguments with which they were captured, including scalar values,
+   and do not return futures. Tasks that only take dense fields and
+   read-only global data skip the argument walks and context lookups;
+   the versions of their fields are checked through the captured
+   metadata, so that ghosts are updated exactly when they are stale.
+   All other tasks are executed through the full launch path.
+
+   @param graph The task graph returned by end_capture.
+   */
+
+  void
+  replay(
+    const task_graph_t & graph
+  );
+
   /*!
    Register new field data, i.e. allocate a new buffer for the specified field
    ID.
@@ -552,6 +916,32 @@ struct mpi_context_policy_t
     return field_data;
   }
 
+  /*!
+   Check that the buffer of an internal topology field that was released
+   by repartition is initialized again before it is read. This must be
+   called before the buffer of the field is registered again.
+
+   @param fid  The field id of the topology field.
+   @param read Whether the task reads the topology, i.e., it does not
+               take the data client with write-only permissions.
+   */
+
+  void
+  check_released_topology(
+    field_id_t fid,
+    bool read
+  )
+  {
+    auto it = released_topology_fields_.find(fid);
+
+    if(it != released_topology_fields_.end()) {
+      clog_assert(!read, "the topology was released by repartition and " <<
+        "must be initialized again by a task with write-only permissions");
+
+      released_topology_fields_.erase(it);
+    } // if
+  } // check_released_topology
+
   /*!
    Register new sparse field data, i.e. allocate a new buffer for the
    specified field ID. Sparse data consists of a buffer of offsets
@@ -607,26 +997,19 @@ struct mpi_context_policy_t
   }
 
   /*!
-   Perform reduction for the maximum value type <double>
-  
-   @param
+   Perform reduction for the maximum value. The reduction is fused with
+   the other reductions of the current batch.
+
+   @param local_future The future of the local value.
    */
 
   template <typename T>
   auto
   reduce_max(mpi_future__<T> & local_future)
   {
-    T global_max_;
-    auto local_max_ = local_future.get();
-    MPI_Allreduce(&local_max_, &global_max_, 1,
-           flecsi::coloring::mpi_typetraits__<T>::type(), MPI_MAX,
-           MPI_COMM_WORLD);
-    mpi_future__<T> fut;
-    fut.set(global_max_);
-    return fut;
+    return reduce<reduction::max>(local_future);
   }
 
-
   /*!
     return <double> min reduction
    */
@@ -650,30 +1033,178 @@ struct mpi_context_policy_t
   }
 
   /*!
-   Perform reduction for the minimum value type <double>
-  
-   @param
+   Perform reduction for the minimum value. The reduction is fused with
+   the other reductions of the current batch.
+
+   @param local_future The future of the local value.
    */
 
   template <typename T>
   auto
   reduce_min(mpi_future__<T> & local_future)
   {
-    T global_min_;
-    auto local_min_ = local_future.get();
-    MPI_Allreduce(&local_min_, &global_min_, 1,
-           flecsi::coloring::mpi_typetraits__<T>::type(), MPI_MIN,
-           MPI_COMM_WORLD);
-    mpi_future__<T> fut;
-    fut.set(global_min_);
-    return fut;
+    return reduce<reduction::min>(local_future);
   }
 
+  //--------------------------------------------------------------------------//
+  // Global reduction interface.
+  //--------------------------------------------------------------------------//
+
+  /*!
+   Reduce a value over all of the ranks. The reduction is added to the
+   current batch and the returned future is ready once the batch has
+   been reduced. All of the reductions of a batch are fused into a
+   single non-blocking collective, which is started by start_reductions
+   or, at the latest, when one of the futures of the batch is waited on.
+   As for any collective, the ranks must issue the reductions and start
+   the batches in the same order.
+
+   @tparam OP The reduction operator, e.g., reduction::sum, or a
+              user-defined operator with the same interface.
+   @tparam T  The value type, which must be trivially copyable.
+
+   @param local_future The future of the local value. It is waited on
+                       when the batch is started.
+   */
+
+  template<
+    typename OP,
+    typename T
+  >
+  mpi_future__<T>
+  reduce(
+    const mpi_future__<T> & local_future
+  )
+  {
+    static_assert(std::is_trivially_copyable<T>::value,
+      "reductions require trivially copyable types");
+
+    // A deferred future is the result of a reduction that has not been
+    // completed. It cannot be packed into its own batch, so the current
+    // batch is started first.
+    if(local_future.done_.valid() &&
+      local_future.done_.wait_for(std::chrono::seconds(0)) ==
+      std::future_status::deferred) {
+      start_reductions();
+    } // if
+
+    mpi_future__<T> global_future;
+    auto result = global_future.result_;
+
+    add_reduction(sizeof(T), &apply_reduction<OP, T>,
+      [local_future](void * buffer)
+      {
+        std::memcpy(buffer, &local_future.get(), sizeof(T));
+      },
+      [result](const void * buffer)
+      {
+        std::memcpy(result.get(), buffer, sizeof(T));
+      });
+
+    global_future.done_ = reductions_done_;
+    return global_future;
+  } // reduce
+
+  /*!
+   Reduce a local value over all of the ranks.
+
+   @tparam OP The reduction operator.
+   @tparam T  The value type, which must be trivially copyable.
+
+   @param local_value The local value.
+   */
+
+  template<
+    typename OP,
+    typename T
+  >
+  mpi_future__<T>
+  reduce(
+    const T & local_value
+  )
+  {
+    mpi_future__<T> local_future;
+    local_future.set(local_value);
+    return reduce<OP>(local_future);
+  } // reduce
+
+  /*!
+   Start the reductions of the current batch. The following reductions
+   are added to a new batch.
+   */
+
+  void start_reductions();
+
+  /*!
+   Complete all of the reductions, including those of the current batch.
+   */
+
+  void wait_on_reductions();
 
   int rank;
 
 private:
 
+  // Combine the values at lhs and rhs and store the result at rhs. The
+  // buffers are not necessarily aligned for T.
+  template<
+    typename OP,
+    typename T
+  >
+  static
+  void
+  apply_reduction(
+    const void * lhs,
+    void * rhs
+  )
+  {
+    T a, b;
+    std::memcpy(&a, lhs, sizeof(T));
+    std::memcpy(&b, rhs, sizeof(T));
+    OP::apply(a, b);
+    std::memcpy(rhs, &a, sizeof(T));
+  } // apply_reduction
+
+  using reduction_apply_t = void (*)(const void *, void *);
+
+  // A reduction of a batch, with the functions that copy the local value
+  // into the send buffer and the global value out of the receive buffer.
+  struct reduction_entry_t {
+    size_t size;
+    reduction_apply_t apply;
+    std::function<void(void *)> pack;
+    std::function<void(const void *)> unpack;
+  };
+
+  // Reductions that are fused into one collective.
+  struct reduction_batch_t {
+    std::vector<reduction_entry_t> entries;
+    std::vector<char> send_buffer;
+    std::vector<char> recv_buffer;
+    MPI_Request request = MPI_REQUEST_NULL;
+    bool started = false;
+    bool complete = false;
+  };
+
+  void add_reduction(size_t size, reduction_apply_t apply,
+    std::function<void(void *)> && pack,
+    std::function<void(const void *)> && unpack);
+
+  void complete_reductions(reduction_batch_t & batch);
+
+  // The sizes and operators of the values of a fused reduction.
+  using reduction_layout_t =
+    std::vector<std::pair<size_t, reduction_apply_t>>;
+
+  // MPI operator that applies the operator of each value of a fused
+  // reduction. The layout is looked up from the datatype.
+  static void reduce_fused(void * invec, void * inoutvec, int * len,
+    MPI_Datatype * datatype);
+
+  // Wait for the outstanding reductions and release the datatypes and
+  // the operator of the fused reductions.
+  void finalize_reductions();
+
   int color_ = 0;
   int colors_ = 0;
 
@@ -694,6 +1225,79 @@ private:
   std::map<field_id_t, std::vector<uint8_t>> field_data;
   std::map<field_id_t, field_metadata_t> field_metadata;
 
+  // The internal topology fields whose buffers were released by
+  // repartition and were not initialized again.
+  std::set<field_id_t> released_topology_fields_;
+
+#if defined(FLECSI_ENABLE_MPI_NEIGHBORHOOD_COLLECTIVES)
+  // Neighborhood exchange schedule for a set of fields. The counts and
+  // displacements are in bytes and follow the neighbor order of the
+  // graph communicator, i.e., the ghost owners for the receives and the
+  // shared users for the sends. The persistent requests receive and
+  // send the packed buffers, one per neighbor, receives first.
+  struct ghost_schedule_t {
+    std::vector<int> send_counts;
+    std::vector<int> send_displs;
+    std::vector<int> recv_counts;
+    std::vector<int> recv_displs;
+    std::vector<char> send_buffer;
+    std::vector<char> recv_buffer;
+    std::vector<MPI_Request> requests;
+  };
+#endif
+
+  // State of a ghost update on one index space. The packed buffers
+  // (key: peer rank) are kept to be reused by the next update.
+  struct ghost_update_t {
+    const coloring_info_t * coloring_info = nullptr;
+    std::set<field_id_t> fids;
+#if defined(FLECSI_ENABLE_MPI_NEIGHBORHOOD_COLLECTIVES)
+    // Distributed graph communicator with the ghost owners as sources
+    // and the shared users as destinations, in this order, i.e., the
+    // ranks on other nodes first.
+    MPI_Comm comm = MPI_COMM_NULL;
+    std::vector<int> sources;
+    std::vector<int> destinations;
+
+    // Exchange schedules, built once per set of fields. The schedule of
+    // the update in progress, if any.
+    std::map<std::set<field_id_t>, ghost_schedule_t> schedules;
+    ghost_schedule_t * schedule = nullptr;
+
+    bool in_progress() const { return schedule != nullptr; }
+#else
+    std::vector<MPI_Request> requests;
+    std::map<int, std::vector<char>> send_buffers;
+    std::map<int, std::vector<char>> recv_buffers;
+
+    bool in_progress() const { return !requests.empty(); }
+#endif
+  };
+
+  // key: index space
+  std::map<size_t, ghost_update_t> ghost_updates_;
+
+  // Launch flags of the registered tasks. key: task hash key
+  std::map<size_t, launch_t> task_launch_;
+
+  // Queued tasks that access a field.
+  struct field_access_t {
+    std::shared_future<void> writer;
+    std::vector<std::shared_future<void>> readers;
+  };
+
+  // key: field id
+  std::map<field_id_t, field_access_t> field_access_;
+
+  std::vector<std::shared_future<void>> queued_tasks_;
+  thread_pool task_pool_;
+
+  bool capturing_ = false;
+  task_graph_t captured_tasks_;
+
+  // Message tag used for ghost updates.
+  static constexpr int ghost_tag = 79;
+
   std::map<size_t, index_space_data_t> index_space_data_map_;
   std::map<size_t, index_subspace_data_t> index_subspace_data_map_;
 
@@ -703,6 +1307,20 @@ private:
   double min_reduction_;
   double max_reduction_;
 
+  // The batch to which reductions are added, and its completion.
+  std::shared_ptr<reduction_batch_t> reductions_;
+  std::shared_future<void> reductions_done_;
+
+  // Batches that have been started. Completed batches are removed when
+  // the next batch is started.
+  std::vector<std::pair<std::shared_ptr<reduction_batch_t>,
+    std::shared_future<void>>> started_reductions_;
+
+  // The contiguous datatypes that span the values of fused reductions,
+  // with their layouts, and the operator that reduces them.
+  std::map<MPI_Datatype, reduction_layout_t> reduction_layouts_;
+  MPI_Op reduction_op_ = MPI_OP_NULL;
+
 }; // class mpi_context_policy_t
 
 } // namespace execution
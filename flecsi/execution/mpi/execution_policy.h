@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <memory>
+#include <set>
 #include <type_traits>
 #include <future>
 #include <cinchlog.h>
@@ -54,11 +55,29 @@ struct executor__
     A && targs
   )
   {
-    auto user_fun = (reinterpret_cast<RETURN(*)(ARG_TUPLE)>(fun));
     mpi_future__<RETURN> fut;
-    fut.set(user_fun(std::forward<A>(targs)));
+    execute(fun, std::forward<A>(targs), fut);
     return fut;
   } // execute_task
+
+  /*!
+   Execute the task and store its result in the given future.
+   */
+  template<
+    typename T,
+    typename A
+  >
+  static
+  void
+  execute(
+    T fun,
+    A && targs,
+    mpi_future__<RETURN> & fut
+  )
+  {
+    auto user_fun = (reinterpret_cast<RETURN(*)(ARG_TUPLE)>(fun));
+    fut.set(user_fun(std::forward<A>(targs)));
+  } // execute_task
 }; // struct executor__
 
 /*!
@@ -83,13 +102,29 @@ struct executor__<void, ARG_TUPLE>
     A && targs
   )
   {
-    auto user_fun = (reinterpret_cast<void(*)(ARG_TUPLE)>(fun));
-
     mpi_future__<void> fut;
-    user_fun(std::forward<A>(targs));
-
+    execute(fun, std::forward<A>(targs), fut);
     return fut;
   } // execute_task
+
+  /*!
+   Execute the task.
+   */
+  template<
+    typename T,
+    typename A
+  >
+  static
+  void
+  execute(
+    T fun,
+    A && targs,
+    mpi_future__<void> &
+  )
+  {
+    auto user_fun = (reinterpret_cast<void(*)(ARG_TUPLE)>(fun));
+    user_fun(std::forward<A>(targs));
+  } // execute_task
 }; // struct executor__
 
 //----------------------------------------------------------------------------//
@@ -163,6 +198,14 @@ struct mpi_execution_policy_t
      std::string name
   )
   {
+    // A split task is executed once per partition of the index spaces,
+    // so it must restrict its computation to context_t::task_partition(),
+    // which is checked when it is split.
+    clog_assert(!launch_split(launch) || std::is_void<RETURN>::value,
+      "split tasks cannot return a value: " << name);
+
+    context_t::instance().register_task_launch(KEY, launch);
+
     return context_t::instance().template register_function<
       KEY, RETURN, ARG_TUPLE, DELEGATE>();
   } // register_task
@@ -185,15 +228,115 @@ struct mpi_execution_policy_t
     ARGS && ... args
   )
   {
-    auto fun = context_t::instance().function(KEY);
     // Make a tuple from the task arguments.
     ARG_TUPLE task_args = std::make_tuple(args ...);
 
+    return execute_task_tuple<launch, KEY, RETURN, ARG_TUPLE>(task_args);
+  } // execute_task
+
+  /*!
+   Execute a task on a tuple of its arguments. This is the implementation
+   of execute_task.
+   */
+
+  template<
+    launch_type_t launch,
+    size_t KEY,
+    typename RETURN,
+    typename ARG_TUPLE
+  >
+  static
+  decltype(auto)
+  execute_task_tuple(
+    ARG_TUPLE & task_args
+  )
+  {
+    auto & context = context_t::instance();
+    auto fun = context.function(KEY);
+
+    const bool split = launch_split(context.task_launch(KEY));
+
+    // The prolog initializes some of the arguments, so a capture has to
+    // copy them first.
+    std::unique_ptr<ARG_TUPLE> captured_args;
+    if(context.capturing()) {
+      captured_args.reset(new ARG_TUPLE(task_args));
+    } // if
+
     // run task_prolog to copy ghost cells.
     task_prolog_t task_prolog;
     task_prolog.walk(task_args);
 
-    auto fut = executor__<RETURN, ARG_TUPLE>::execute(fun, std::forward<ARG_TUPLE>(task_args));
+    if(context.capturing()) {
+      capture_task<launch, KEY, RETURN, ARG_TUPLE>(*captured_args,
+        task_prolog, split);
+    } // if
+
+    mpi_future__<RETURN> fut;
+
+    // Single launches are queued on the worker threads of the rank,
+    // unless their arguments require communication after the task. Index
+    // launches are MPI tasks and are always executed inline.
+    if(context.task_threads() > 0 && launch == launch_type_t::single &&
+      !split && !task_prolog.synchronous) {
+      // The ghost update reads the shared data and writes the ghost data
+      // of the stale fields, so it has to wait for the queued tasks that
+      // access them.
+      std::set<field_id_t> ghost_fields;
+      for(auto & is: task_prolog.stale_fields) {
+        ghost_fields.insert(is.second.begin(), is.second.end());
+      } // for
+
+      context.wait_on_fields(ghost_fields);
+      task_prolog.update_ghosts();
+
+      // The epilog only advances the versions of the written fields.
+      task_epilog_t task_epilog;
+      task_epilog.walk(task_args);
+
+      auto result = fut;
+
+      fut.done_ = context.queue_task([fun, task_args, result]() mutable {
+        executor__<RETURN, ARG_TUPLE>::execute(fun, task_args, result);
+
+        finalize_handles_t finalize_handles;
+        finalize_handles.walk(task_args);
+      }, task_prolog.read_fields, task_prolog.written_fields,
+        task_prolog.dependencies);
+
+      return fut;
+    } // if
+
+    // Inline tasks observe the results of all of the queued tasks.
+    context.wait_on_tasks();
+
+    if(split && !task_prolog.stale_fields.empty()) {
+      // Overlap the ghost update with the computation on the exclusive
+      // indices, which do not depend on ghost data. The shared indices
+      // are computed once the ghost data has arrived.
+      task_prolog.start_ghost_updates();
+
+      context.set_task_partition(exclusive);
+      executor__<RETURN, ARG_TUPLE>::execute(fun, task_args);
+
+      // A task that does not look at its partition would compute all of
+      // the owned indices, with stale ghosts, and then again.
+      clog_assert(context.task_partition_read(),
+        "split task does not restrict its computation to "
+        "context_t::task_partition()");
+
+      task_prolog.finish_ghost_updates();
+
+      context.set_task_partition(shared);
+      fut = executor__<RETURN, ARG_TUPLE>::execute(fun, task_args);
+
+      context.set_task_partition(owned);
+    }
+    else {
+      task_prolog.update_ghosts();
+      fut = executor__<RETURN, ARG_TUPLE>::execute(fun,
+        std::forward<ARG_TUPLE>(task_args));
+    } // if
 
     task_epilog_t task_epilog;
     task_epilog.walk(task_args);
@@ -202,7 +345,82 @@ struct mpi_execution_policy_t
     finalize_handles.walk(task_args);
 
     return fut;
-  } // execute_task
+  } // execute_task_tuple
+
+  /*!
+   Record a task during a capture. Tasks that are eligible for the worker
+   threads are recorded with their resolved ghost reads and written
+   fields, so that a replay does not need the argument walks. All other
+   tasks, and the tasks with data client handles, whose storage is set
+   up by the prolog of each launch, are recorded for a full launch.
+
+   @param task_args   The arguments of the task before the prolog.
+   @param task_prolog The prolog of the task.
+   @param split       Whether the task was registered as a split task.
+   */
+
+  template<
+    launch_type_t launch,
+    size_t KEY,
+    typename RETURN,
+    typename ARG_TUPLE
+  >
+  static
+  void
+  capture_task(
+    const ARG_TUPLE & task_args,
+    const task_prolog_t & task_prolog,
+    bool split
+  )
+  {
+    auto & context = context_t::instance();
+    mpi_context_policy_t::captured_task_t task;
+
+    if(launch != launch_type_t::single || split ||
+      task_prolog.synchronous || task_prolog.client_storage) {
+      task.launch = [task_args]() {
+        ARG_TUPLE args = task_args;
+        execute_task_tuple<launch, KEY, RETURN, ARG_TUPLE>(args);
+      };
+
+      context.capture_task(std::move(task));
+      return;
+    } // if
+
+    const size_t my_color = context.color();
+    auto & field_metadata = context.registered_field_metadata();
+
+    for(auto & is: task_prolog.ghost_fields) {
+      auto & coloring_info = context.coloring_info(is.first).at(my_color);
+
+      for(auto fid: is.second) {
+        task.ghost_reads.push_back(
+          { is.first, &coloring_info, fid, &field_metadata.at(fid) });
+      } // for
+    } // for
+
+    for(auto fid: task_prolog.shared_written_fields) {
+      task.shared_writes.push_back(&field_metadata.at(fid));
+    } // for
+
+    for(auto fid: task_prolog.ghost_written_fields) {
+      task.ghost_writes.push_back(&field_metadata.at(fid));
+    } // for
+
+    task.read_fields = task_prolog.read_fields;
+    task.written_fields = task_prolog.written_fields;
+
+    auto fun = context.function(KEY);
+    task.body = [fun, args = ARG_TUPLE(task_args)]() mutable {
+      mpi_future__<RETURN> result;
+      executor__<RETURN, ARG_TUPLE>::execute(fun, args, result);
+
+      finalize_handles_t finalize_handles;
+      finalize_handles.walk(args);
+    };
+
+    context.capture_task(std::move(task));
+  } // capture_task
 
   //--------------------------------------------------------------------------//
   // Function interface.
@@ -16,6 +16,7 @@
 /*! @file */
 
 #include <functional>
+#include <future>
 #include <memory>
 
 namespace flecsi {
@@ -26,9 +27,11 @@ namespace execution {
 //----------------------------------------------------------------------------//
 
 /*!
- Abstract interface type for MPI futures.
+ Abstract interface type for MPI futures. A future refers to the result
+ of a task that may still be executing on the worker threads of the
+ rank. Copies of a future refer to the same result.
 
- @ingroup legion-execution
+ @ingroup mpi-execution
  */
 template<
   typename R,
@@ -39,31 +42,44 @@ struct mpi_future__
   using result_t = R;
 
   /*!
-    wait() method
+    Wait for the task to complete.
    */
-  void wait() {}
+  void wait() const {
+    if(done_.valid()) {
+      done_.get();
+    } // if
+  } // wait
 
   /*!
-    get() mothod
+    Wait for the task to complete and return its result.
    */
-  const result_t & get(size_t index = 0) const { return result_; }
+  const result_t & get(size_t index = 0) const {
+    wait();
+    return *result_;
+  } // get
 
 //private:
 
   /*!
     set method
    */
-  void set(const result_t & result) { result_ = result; }
+  void set(const result_t & result) { *result_ = result; }
 
   operator R &() {
-    return result_;
+    wait();
+    return *result_;
   }
 
   operator const R  &() const {
-    return result_;
+    wait();
+    return *result_;
   }
 
-  result_t result_;
+  std::shared_ptr<result_t> result_ = std::make_shared<result_t>();
+
+  //! Completion of the task that produces the result. This is invalid
+  //! for tasks that were executed inline.
+  std::shared_future<void> done_;
 
 }; // struct mpi_future__
 
@@ -74,9 +90,17 @@ template<launch_type_t launch>
 struct mpi_future__<void, launch>
 {
   /*!
-   FIXME documentation
+    Wait for the task to complete.
    */
-  void wait() {}
+  void wait() const {
+    if(done_.valid()) {
+      done_.get();
+    } // if
+  } // wait
+
+  //! Completion of the task. This is invalid for tasks that were
+  //! executed inline.
+  std::shared_future<void> done_;
 
 }; // struct mpi_future__
 
@@ -14,8 +14,11 @@
 /*! @file */
 
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <map>
+#include <vector>
 
 #include <flecsi/data/data.h>
 
@@ -29,69 +32,174 @@ namespace execution {
 //----------------------------------------------------------------------------//
 
 void
-remap_shared_entities()
+remap_shared_entities(
+  size_t index_space
+)
 {
   // TODO: Is this superseded by index_map/reverse_index_map?
   auto& flecsi_context = context_t::instance();
-  const int my_color = flecsi_context.color();
-
-  for (auto& coloring_info_pair : flecsi_context.coloring_info_map()) {
-    auto index_space = coloring_info_pair.first;
-    auto &coloring_info = coloring_info_pair.second;
-
-    auto &my_coloring_info = flecsi_context.coloring_info(index_space).at(
-      my_color);
-    auto &index_coloring = flecsi_context.coloring(index_space);
-
-    std::set<flecsi::coloring::entity_info_t> new_shared;
-
-//    for (auto& shared : index_coloring.shared) {
-//      clog_rank(warn, 0) << "myrank: " << my_color
-//                         << " shared id: " << shared.id
-//                         << ", rank: " << shared.rank
-//                         << ", offset: " << shared.offset
-//                         << ", index: " << index << std::endl;
-//     }
-
-    // FIXME: does this cause deadlock?
-    size_t index = 0;
-    for (auto& shared : index_coloring.shared) {
-      for (auto peer : shared.shared) {
-        MPI_Send(&index, 1, MPI_UNSIGNED_LONG_LONG, peer, 77, MPI_COMM_WORLD);
-      }
-      new_shared.insert(
-        flecsi::coloring::entity_info_t(shared.id, shared.rank, index, shared.shared));
-      index++;
-    }
-    context_t::instance().coloring(index_space).shared.swap(new_shared);
 
+  auto &index_coloring = flecsi_context.coloring(index_space);
+
+  std::set<flecsi::coloring::entity_info_t> new_shared;
 
-    MPI_Status status;
-    std::set<flecsi::coloring::entity_info_t> new_ghost;
+  // The offset of each shared entity is sent to the peers that have
+  // it as a ghost, packed into one message per peer. The offsets are
+  // packed in the order of the shared entities, which matches the
+  // order of the ghost entities on the peer.
+  std::map<int, std::vector<size_t>> send_offsets;
 
-    for (auto ghost : index_coloring.ghost) {
-      MPI_Recv(&index, 1, MPI_UNSIGNED_LONG_LONG,
-               ghost.rank, 77, MPI_COMM_WORLD, &status);
-      new_ghost.insert(
-        flecsi::coloring::entity_info_t(ghost.id, ghost.rank, index, {}));
+  size_t index = 0;
+  for (auto& shared : index_coloring.shared) {
+    for (auto peer : shared.shared) {
+      send_offsets[peer].push_back(index);
     }
-//    for (auto ghost : index_coloring.ghost) {
-//      clog_rank(warn, 1) << "myrank: " << my_color
-//                         << " old ghost id: " << ghost.id
-//                         << ", rank: " << ghost.rank
-//                         << ", offset: " << ghost.offset
-//                         << std::endl;
-//    }
-//    for (auto ghost : new_ghost) {
-//      clog_rank(warn, 1) << "myrank: " << my_color
-//                         << " new ghost id: " << ghost.id
-//                         << ", rank: " << ghost.rank
-//                         << ", offset: " << ghost.offset
-//                         << std::endl;
-//    }
-    context_t::instance().coloring(index_space).ghost.swap(new_ghost);
+    new_shared.insert(
+      flecsi::coloring::entity_info_t(shared.id, shared.rank, index, shared.shared));
+    index++;
+  }
+
+  std::map<int, std::vector<size_t>> recv_offsets;
+
+  for (auto& ghost : index_coloring.ghost) {
+    recv_offsets[ghost.rank].emplace_back();
+  }
+
+  std::vector<MPI_Request> requests;
+  requests.reserve(send_offsets.size() + recv_offsets.size());
+
+  for (auto& recv : recv_offsets) {
+    requests.emplace_back();
+    MPI_Irecv(recv.second.data(), recv.second.size(),
+      flecsi::coloring::mpi_typetraits__<size_t>::type(), recv.first, 77,
+      MPI_COMM_WORLD, &requests.back());
+  }
+
+  for (auto& send : send_offsets) {
+    requests.emplace_back();
+    MPI_Isend(send.second.data(), send.second.size(),
+      flecsi::coloring::mpi_typetraits__<size_t>::type(), send.first, 77,
+      MPI_COMM_WORLD, &requests.back());
+  }
+
+  MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+  context_t::instance().coloring(index_space).shared.swap(new_shared);
+
+  std::set<flecsi::coloring::entity_info_t> new_ghost;
+  std::map<int, size_t> recv_index;
+
+  for (auto& ghost : index_coloring.ghost) {
+    const size_t offset = recv_offsets[ghost.rank][recv_index[ghost.rank]++];
+    new_ghost.insert(
+      flecsi::coloring::entity_info_t(ghost.id, ghost.rank, offset, {}));
+  }
+  context_t::instance().coloring(index_space).ghost.swap(new_ghost);
+} // remap_shared_entities
+
+void
+remap_shared_entities()
+{
+  for (auto& coloring_info_pair : context_t::instance().coloring_info_map()) {
+    remap_shared_entities(coloring_info_pair.first);
+  }
+} // remap_shared_entities
+
+void
+build_index_maps(
+  size_t index_space
+)
+{
+  auto& flecsi_context = context_t::instance();
+  auto& coloring = flecsi_context.coloring(index_space);
+
+  std::vector<size_t> _map;
+  _map.reserve(coloring.exclusive.size() + coloring.shared.size() +
+    coloring.ghost.size());
+
+  auto order = flecsi_context.entity_order_map().find(index_space);
+
+  if(order == flecsi_context.entity_order_map().end()) {
+    for(auto & index: coloring.exclusive) {
+      _map.push_back(index.id);
+    } // for
   }
-}
+  else {
+    // The exclusive entities in the requested order, followed by the
+    // ones that the order does not contain.
+    std::vector<size_t> exclusive;
+    exclusive.reserve(coloring.exclusive.size());
+
+    for(auto & index: coloring.exclusive) {
+      exclusive.push_back(index.id);
+    } // for
+
+    std::vector<bool> numbered(exclusive.size(), false);
+
+    for(auto id: order->second) {
+      auto it = std::lower_bound(exclusive.begin(), exclusive.end(), id);
+      const size_t i = it - exclusive.begin();
+
+      if(it != exclusive.end() && *it == id && !numbered[i]) {
+        numbered[i] = true;
+        _map.push_back(id);
+      } // if
+    } // for
+
+    for(size_t i{0}; i < exclusive.size(); ++i) {
+      if(!numbered[i]) {
+        _map.push_back(exclusive[i]);
+      } // if
+    } // for
+  } // if
+
+  for(auto & index: coloring.shared) {
+    _map.push_back(index.id);
+  } // for
+
+  for(auto & index: coloring.ghost) {
+    _map.push_back(index.id);
+  } // for
+
+  flecsi_context.add_index_map(index_space, _map);
+} // build_index_maps
+
+//----------------------------------------------------------------------------//
+// Recompute the users and owners on the same node as each color, which
+// are not part of the coloring cache, from the current placement of the
+// ranks.
+//----------------------------------------------------------------------------//
+
+void
+update_coloring_nodes()
+{
+  auto& flecsi_context = context_t::instance();
+  const auto nodes = flecsi::coloring::mpi_nodes();
+
+  for(auto & is: flecsi_context.coloring_map()) {
+    auto coloring_info = flecsi_context.coloring_info(is.first);
+
+    for(auto & ci: coloring_info) {
+      ci.second.shared_users_on_node.clear();
+      ci.second.ghost_owners_on_node.clear();
+
+      for(auto u: ci.second.shared_users) {
+        if(nodes[u] == nodes[ci.first]) {
+          ci.second.shared_users_on_node.insert(u);
+        } // if
+      } // for
+
+      for(auto o: ci.second.ghost_owners) {
+        if(nodes[o] == nodes[ci.first]) {
+          ci.second.ghost_owners_on_node.insert(o);
+        } // if
+      } // for
+    } // for
+
+    flecsi_context.update_coloring(is.first,
+      flecsi_context.coloring(is.first), coloring_info);
+  } // for
+} // update_coloring_nodes
 
 void
 runtime_driver(
@@ -149,31 +257,25 @@ runtime_driver(
   specialization_tlt_init(argc, argv);
 #endif // FLECSI_ENABLE_SPECIALIZATION_TLT_INIT
 
-  remap_shared_entities();
-
-  // Setup maps from mesh to compacted (local) index space and vice versa
-  //
-  // This depends on the ordering of the BLIS data structure setup.
-  // Currently, this is Exclusive - Shared - Ghost.
-
-  for(auto is: flecsi_context.coloring_map()) {
-    std::map<size_t, size_t> _map;
-    size_t counter(0);
-
-    for(auto index: is.second.exclusive) {
-      _map[counter++] = index.id;
-    } // for
+  // The colorings that were loaded from a cache file are already
+  // remapped, and their index maps are built.
+  if(!flecsi_context.colorings_cached()) {
+    remap_shared_entities();
 
-    for(auto index: is.second.shared) {
-      _map[counter++] = index.id;
-    } // for
+    // Setup maps from mesh to compacted (local) index space and vice versa
+    //
+    // This depends on the ordering of the BLIS data structure setup.
+    // Currently, this is Exclusive - Shared - Ghost.
 
-    for(auto index: is.second.ghost) {
-      _map[counter++] = index.id;
+    for(auto & is: flecsi_context.coloring_map()) {
+      build_index_maps(is.first);
     } // for
 
-    flecsi_context.add_index_map(is.first, _map);
-  } // for
+    flecsi_context.save_coloring_cache();
+  }
+  else {
+    update_coloring_nodes();
+  } // if
 
   flecsi_context.advance_state();
   // Call the specialization color initialization function.
@@ -186,6 +288,12 @@ runtime_driver(
   // Execute the user driver.
   driver(argc, argv);
 
+  // Wait for the tasks that are still executing on the worker threads.
+  flecsi_context.wait_on_tasks();
+
+  // Complete the global reductions that were not waited on.
+  flecsi_context.wait_on_reductions();
+
 } // runtime_driver
 
 } // namespace execution
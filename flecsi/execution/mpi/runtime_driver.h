@@ -15,6 +15,7 @@
 
 /*! @file */
 
+#include <cstddef>
 
 namespace flecsi {
 namespace execution {
@@ -55,5 +56,30 @@ void driver(int argc, char ** argv);
 
 void runtime_driver(int argc, char ** argv);
 
+/*!
+ Replace the offsets of the shared and ghost entities of an index space
+ by their offsets in the shared region of the owner. The owners send
+ the offsets to the users, so this must be called collectively.
+
+ @param index_space The index space of the coloring.
+
+ @ingroup mpi-execution
+ */
+
+void remap_shared_entities(size_t index_space);
+
+/*!
+ Build the index maps between the mesh ids and the locally compacted ids
+ of an index space from its coloring, in the order exclusive, shared,
+ ghost. The exclusive entities follow the entity order of the index
+ space, if the specialization has set one.
+
+ @param index_space The index space of the coloring.
+
+ @ingroup mpi-execution
+ */
+
+void build_index_maps(size_t index_space);
+
 } // namespace execution
 } // namespace flecsi
@@ -85,30 +85,24 @@ namespace execution {
     {
       auto& h = a.handle;
 
-      // Skip Read Only handles
-      if (EXCLUSIVE_PERMISSIONS == ro && SHARED_PERMISSIONS == ro)
+      if (SHARED_PERMISSIONS != wo && SHARED_PERMISSIONS != rw &&
+        GHOST_PERMISSIONS != wo)
         return;
 
       auto &context = context_t::instance();
-      const int my_color = context.color();
-      auto &my_coloring_info =
-        context.coloring_info(h.index_space).at(my_color);
-
-      auto &field_metadata = context.registered_field_metadata().at(h.fid);
-
-      MPI_Win win = field_metadata.win;
-
-      MPI_Win_post(field_metadata.shared_users_grp, 0, win);
-      MPI_Win_start(field_metadata.ghost_owners_grp, 0, win);
-
-      for (auto ghost_owner : my_coloring_info.ghost_owners) {
-        MPI_Get(h.ghost_data, 1, field_metadata.origin_types[ghost_owner],
-                ghost_owner, 0, 1, field_metadata.target_types[ghost_owner],
-                win);
-      }
-
-      MPI_Win_complete(win);
-      MPI_Win_wait(win);
+      auto &metadata = context.registered_field_metadata().at(h.fid);
+
+      // Only writes to the shared indices invalidate the ghosts of our
+      // peers. Advance the version of the field. The ghost copy is
+      // deferred to the prolog of the first task that reads the ghost
+      // indices.
+      if (SHARED_PERMISSIONS == wo || SHARED_PERMISSIONS == rw)
+        ++metadata.version;
+
+      // A task that only writes the ghost indices defines them, so they
+      // are current until the shared indices are written again.
+      if (GHOST_PERMISSIONS == wo)
+        metadata.ghost_version = metadata.version;
     } // handle
 
 
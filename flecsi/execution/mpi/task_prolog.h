@@ -16,6 +16,10 @@
 /*! @file */
 
 
+#include <chrono>
+#include <future>
+#include <map>
+#include <set>
 #include <vector>
 
 #include "mpi.h"
@@ -28,6 +32,7 @@
 #include <flecsi/data/sparse_accessor.h>
 #include <flecsi/data/sparse_mutator.h>
 #include <flecsi/execution/context.h>
+#include <flecsi/execution/mpi/future.h>
 #include <flecsi/coloring/mpi_utils.h>
 
 namespace flecsi {
@@ -80,7 +85,41 @@ namespace execution {
      > & a
     )
     {
-      // TODO: move field data allocation here?
+      auto& h = a.handle;
+
+      // Record the accesses of the task for dependency analysis.
+      if (EXCLUSIVE_PERMISSIONS == wo || EXCLUSIVE_PERMISSIONS == rw ||
+        SHARED_PERMISSIONS == wo || SHARED_PERMISSIONS == rw ||
+        GHOST_PERMISSIONS == wo || GHOST_PERMISSIONS == rw) {
+        written_fields.insert(h.fid);
+      }
+      else {
+        read_fields.insert(h.fid);
+      } // if
+
+      if (SHARED_PERMISSIONS == wo || SHARED_PERMISSIONS == rw) {
+        shared_written_fields.insert(h.fid);
+      } // if
+
+      // A task that only writes the ghost indices does not need their
+      // current values.
+      if (GHOST_PERMISSIONS == wo) {
+        ghost_written_fields.insert(h.fid);
+      } // if
+
+      // Ghost indices are only updated for tasks that read them.
+      if (GHOST_PERMISSIONS == reserved || GHOST_PERMISSIONS == wo)
+        return;
+
+      ghost_fields[h.index_space].insert(h.fid);
+
+      // Skip fields that have not been written since the last update.
+      auto& context = context_t::instance();
+      auto& metadata = context.registered_field_metadata().at(h.fid);
+
+      if (metadata.ghost_version != metadata.version) {
+        stale_fields[h.index_space].insert(h.fid);
+      } // if
     } // handle
 
     template<
@@ -99,6 +138,11 @@ namespace execution {
         clog_assert(PERMISSIONS == size_t(ro), "you are not allowed "
            "to modify global data in specialization_spmd_init or driver");
       }
+
+      // Global data is broadcast after it is written.
+      if (PERMISSIONS != ro) {
+        synchronous = true;
+      }
     } // handle
 
     template<
@@ -117,6 +161,9 @@ namespace execution {
       > & a
     )
     {
+      // The ghost data of sparse fields is exchanged after the task.
+      synchronous = true;
+
 //      // TODO: move field data allocation here?
 //      auto& context = context_t::instance();
 //      const int my_color = context.color();
@@ -160,6 +207,7 @@ namespace execution {
     )
     {
       m.h_.init();
+      synchronous = true;
     } // handle
 
     template<
@@ -173,6 +221,55 @@ namespace execution {
     )
     {
       m.h_.init();
+      synchronous = true;
+    } // handle
+
+    template<
+      typename T,
+      size_t EXCLUSIVE_PERMISSIONS,
+      size_t SHARED_PERMISSIONS,
+      size_t GHOST_PERMISSIONS
+    >
+    void
+    handle(
+      ragged_accessor<
+        T,
+        EXCLUSIVE_PERMISSIONS,
+        SHARED_PERMISSIONS,
+        GHOST_PERMISSIONS
+      > & a
+    )
+    {
+      synchronous = true;
+    } // handle
+
+    /*!
+     Tasks that take a future as an argument depend on the task that
+     produces it.
+     */
+
+    template<
+      typename R,
+      launch_type_t launch
+    >
+    void
+    handle(
+      mpi_future__<R, launch> & f
+    )
+    {
+      if (!f.done_.valid()) {
+        return;
+      }
+
+      // The results of global reductions are completed on this thread,
+      // which is the only one that communicates.
+      if (f.done_.wait_for(std::chrono::seconds(0)) ==
+        std::future_status::deferred) {
+        f.wait();
+      }
+      else {
+        dependencies.push_back(f.done_);
+      }
     } // handle
 
     template<
@@ -186,6 +283,14 @@ namespace execution {
     {
       auto& context_ = context_t::instance();
 
+      // Tasks that modify the topology are executed inline.
+      if (PERMISSIONS != ro) {
+        synchronous = true;
+      }
+
+      // The storage is deleted by finalize_handles after the task.
+      client_storage = true;
+
       // h is partially initialized in client.h
       auto storage = h.set_storage(new typename T::storage_t);
 
@@ -214,6 +319,7 @@ namespace execution {
         if (fieldDataIter == registered_field_data.end()) {
           size_t size = ent.size * num_entities;
 
+          context_.check_released_topology(ent.fid, _read);
           execution::context_t::instance().register_field_data(ent.fid,
                                                                size);
         }
@@ -224,6 +330,7 @@ namespace execution {
         if (fieldDataIter == registered_field_data.end()) {
           size_t size = ent.size * num_entities;
 
+          context_.check_released_topology(ent.id_fid, _read);
           execution::context_t::instance().register_field_data(ent.id_fid,
                                                                size);
         }
@@ -253,6 +360,7 @@ namespace execution {
         if (fieldDataIter == registered_field_data.end()) {
           size_t size = sizeof(size_t) * adj.num_offsets;
 
+          context_.check_released_topology(adj.offset_fid, _read);
           execution::context_t::instance().register_field_data(adj.offset_fid,
                                                                size);
         }
@@ -263,6 +371,7 @@ namespace execution {
         fieldDataIter = registered_field_data.find(adj.index_fid);
         if (fieldDataIter == registered_field_data.end()) {
           size_t size = sizeof(utils::id_t) * adj.num_indices;
+          context_.check_released_topology(adj.index_fid, _read);
           execution::context_t::instance().register_field_data(adj.index_fid,
                                                                size);
         }
@@ -329,6 +438,10 @@ namespace execution {
     {
       auto& context_ = context_t::instance();
 
+      // Set topology storage is finalized after the task.
+      synchronous = true;
+      client_storage = true;
+
       auto& ism = context_.set_index_space_map();
 
       // h is partially initialized in client.h
@@ -390,6 +503,84 @@ namespace execution {
     {
     } // handle
 
+    /*!
+     Start the update of the ghost data of the stale dense fields that are
+     read by the task. This must be called after walking the task
+     arguments. The fields of each index space are aggregated into a single
+     ghost update.
+     */
+
+    void
+    start_ghost_updates()
+    {
+      auto& context = context_t::instance();
+      const int my_color = context.color();
+
+      for (auto& is : stale_fields) {
+        auto& my_coloring_info =
+          context.coloring_info(is.first).at(my_color);
+
+        context.start_ghost_update(is.first, my_coloring_info, is.second);
+      } // for
+    } // start_ghost_updates
+
+    /*!
+     Wait for the ghost updates started by start_ghost_updates.
+     */
+
+    void
+    finish_ghost_updates()
+    {
+      auto& context = context_t::instance();
+
+      for (auto& is : stale_fields) {
+        context.finish_ghost_update(is.first);
+      } // for
+    } // finish_ghost_updates
+
+    /*!
+     Update the ghost data of the stale dense fields that are read by the
+     task.
+     */
+
+    void
+    update_ghosts()
+    {
+      start_ghost_updates();
+      finish_ghost_updates();
+    } // update_ghosts
+
+    //! The dense fields with stale ghost data that are read by the task.
+    //! key: index space, value: field ids
+    std::map<size_t, std::set<field_id_t>> stale_fields;
+
+    //! The dense fields whose ghost indices are read by the task.
+    //! key: index space, value: field ids
+    std::map<size_t, std::set<field_id_t>> ghost_fields;
+
+    //! The dense fields whose shared indices are written by the task.
+    std::set<field_id_t> shared_written_fields;
+
+    //! The dense fields whose ghost indices are only written by the task.
+    std::set<field_id_t> ghost_written_fields;
+
+    //! The dense fields that are only read by the task.
+    std::set<field_id_t> read_fields;
+
+    //! The dense fields that are written by the task.
+    std::set<field_id_t> written_fields;
+
+    //! The tasks producing the futures passed to the task.
+    std::vector<std::shared_future<void>> dependencies;
+
+    //! Whether the task must be executed inline, because its arguments
+    //! require communication or shared state updates after it has run.
+    bool synchronous = false;
+
+    //! Whether the prolog set up the storage of a data client handle,
+    //! which only lives for one launch of the task.
+    bool client_storage = false;
+
   }; // struct task_prolog_t
 
 } // namespace execution
@@ -0,0 +1,124 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+///
+/// \file
+/// \date Initial file creation: Oct 18, 2026
+///
+
+#include <cinchtest.h>
+
+#include <flecsi/execution/execution.h>
+
+// Range of ranks that contributed to a reduction.
+struct rank_range_t {
+  int first;
+  int last;
+  int count;
+};
+
+// Concatenate two adjacent ranges. This operator is associative but not
+// commutative.
+struct concatenate {
+  static void apply(rank_range_t & lhs, const rank_range_t & rhs) {
+    ASSERT_EQ(lhs.last + 1, rhs.first);
+    lhs.last = rhs.last;
+    lhs.count += rhs.count;
+  } // apply
+}; // struct concatenate
+
+namespace flecsi {
+namespace execution {
+
+double local_value_task(
+        const int my_color)
+{
+  return static_cast<double>(my_color);
+}
+
+flecsi_register_task(local_value_task, flecsi::execution, loc, single);
+
+template<typename T>
+using handle_t = flecsi::execution::flecsi_future<T,
+    flecsi::execution::launch_type_t::single>;
+
+void reduction_check_task(handle_t<double> f_sum, handle_t<size_t> f_count,
+      int num_colors)
+{
+    ASSERT_EQ(f_sum.get(), static_cast<double>(num_colors * (num_colors + 1) / 2));
+    ASSERT_EQ(f_count.get(), size_t(num_colors));
+}
+
+flecsi_register_task(reduction_check_task, flecsi::execution, loc, single);
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto & context = context_t::instance();
+
+  int num_colors, my_color;
+  MPI_Comm_size(MPI_COMM_WORLD, &num_colors);
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_color);
+
+  for(int cycle=1; cycle < 10; cycle++) {
+    auto local_future =
+      flecsi_execute_task(local_value_task, flecsi::execution, single,
+        my_color + 1);
+
+    // These reductions are fused into one collective.
+    auto dt = context.reduce<reduction::min>(local_future);
+    auto energy = context.reduce<reduction::sum>(local_future);
+    auto count = context.reduce<reduction::sum>(size_t(1));
+    auto flag = context.reduce<reduction::product>(int(cycle % 2 ? -1 : 1));
+    auto peak = context.reduce<reduction::max>(float(my_color * cycle));
+    auto range = context.reduce<concatenate>(
+      rank_range_t{my_color, my_color, 1});
+
+    // Reductions that are issued after the start are added to a new
+    // batch.
+    context.start_reductions();
+
+    auto total = context.reduce<reduction::sum>(energy);
+
+    ASSERT_EQ(dt.get(), 1.0);
+    ASSERT_EQ(energy.get(), double(num_colors * (num_colors + 1) / 2));
+    ASSERT_EQ(count.get(), size_t(num_colors));
+    ASSERT_EQ(flag.get(), cycle % 2 && num_colors % 2 ? -1 : 1);
+    ASSERT_EQ(peak.get(), float((num_colors - 1) * cycle));
+
+    const rank_range_t & r = range;
+    ASSERT_EQ(r.first, 0);
+    ASSERT_EQ(r.last, num_colors - 1);
+    ASSERT_EQ(r.count, num_colors);
+
+    // The reduction of a reduction is reduced once more.
+    ASSERT_EQ(total.get(), double(num_colors * num_colors *
+      (num_colors + 1) / 2));
+
+    // Tasks can take the futures of reductions that are not complete.
+    flecsi_execute_task(reduction_check_task, flecsi::execution, single,
+      context.reduce<reduction::sum>(local_future),
+      context.reduce<reduction::sum>(size_t(1)), num_colors);
+  } // cycle
+
+  // Reductions that are not waited on are completed at the end of the
+  // driver.
+  context.reduce<reduction::sum>(1.0);
+
+} // driver
+
+} // namespace execution
+} // namespace flecsi
+
+TEST(fused_reduction, testname) {
+
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
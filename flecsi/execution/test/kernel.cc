@@ -0,0 +1,146 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <atomic>
+
+#include <cinchtest.h>
+
+#include <flecsi/execution/kernel.h>
+
+using namespace flecsi;
+using namespace flecsi::execution;
+using namespace flecsi::topology;
+
+struct object_id {
+  size_t id;
+
+  object_id(size_t id) : id(id) {}
+
+  operator size_t() {
+    return id;
+  }
+
+  size_t index_space_index() const {
+    return id;
+  }
+
+  bool operator<(const object_id & oid) const {
+    return id < oid.id;
+  }
+};
+
+struct object {
+  object(object_id id) : id(id) {}
+
+  using id_t = object_id;
+
+  object_id index_space_id() const {
+    return id;
+  }
+
+  object_id id;
+
+  size_t value = 0;
+  std::atomic<size_t> visits{0};
+};
+
+struct bounds_t {
+  size_t lo;
+  size_t hi;
+};
+
+struct merge_bounds {
+  static void apply(bounds_t & lhs, const bounds_t & rhs) {
+    lhs.lo = std::min(lhs.lo, rhs.lo);
+    lhs.hi = std::max(lhs.hi, rhs.hi);
+  }
+
+  static bounds_t initial() {
+    return { std::numeric_limits<size_t>::max(), 0 };
+  }
+};
+
+TEST(kernel, for_each) {
+  using index_space_t = index_space__<object *, true, true, false>;
+  index_space_t is;
+
+  constexpr size_t n = 10000;
+
+  for (size_t i = 0; i < n; ++i) {
+    is << new object(i);
+  }
+
+  for (size_t threads : {1, 2, 4}) {
+    kernel_threads().resize(threads);
+    ASSERT_EQ(kernel_threads().num_threads(), threads);
+
+    for (auto schedule : {static_schedule, dynamic_schedule}) {
+      for (size_t chunk : {0, 1, 300}) {
+        for_each__(is, [](object * o) {
+          o->value = o->id.id + 1;
+          ++o->visits;
+        }, schedule, chunk);
+
+        size_t sum = 0;
+        reduce_each__(is, sum, [](object * o, size_t & r) {
+          r += o->value;
+        }, schedule, chunk);
+        ASSERT_EQ(sum, n * (n + 1) / 2);
+
+        size_t lo = n;
+        reduce_each__<reduction::min>(is, lo, [](object * o, size_t & r) {
+          r = std::min(r, o->value);
+        }, schedule, chunk);
+        ASSERT_EQ(lo, 1);
+
+        bounds_t bounds = merge_bounds::initial();
+        reduce_each__<merge_bounds>(is, bounds,
+          [](object * o, bounds_t & r) {
+          r.lo = std::min(r.lo, o->value);
+          r.hi = std::max(r.hi, o->value);
+        }, schedule, chunk);
+        ASSERT_EQ(bounds.lo, 1);
+        ASSERT_EQ(bounds.hi, n);
+      } // for
+    } // for
+  } // for
+
+  // Each entity is visited once per traversal.
+  for (size_t i = 0; i < n; ++i) {
+    ASSERT_EQ(is[i]->visits, 18);
+  }
+
+  // Nested kernels are executed serially.
+  index_space_t inner;
+
+  for (size_t i = 0; i < 1000; ++i) {
+    inner << new object(i);
+  }
+
+  std::atomic<size_t> total(0);
+  for_each__(is, [&](object *) {
+    size_t sum = 0;
+    reduce_each__(inner, sum, [](object * o, size_t & r) {
+      r += o->id.id;
+    });
+    total += sum;
+  }, dynamic_schedule, 1000);
+  ASSERT_EQ(total, n * 999 * 1000 / 2);
+
+  kernel_threads().resize(1);
+
+  for (size_t i = 0; i < n; ++i) {
+    delete is[i];
+  }
+
+  for (size_t i = 0; i < 1000; ++i) {
+    delete inner[i];
+  }
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -20,6 +20,7 @@ TEST(launch, sanity) {
   ASSERT_FALSE(launch_leaf(l));
   ASSERT_TRUE(launch_inner(l));
   ASSERT_FALSE(launch_idempotent(l));
+  ASSERT_FALSE(launch_split(l));
   } // scope
 
   {
@@ -30,6 +31,15 @@ TEST(launch, sanity) {
   ASSERT_TRUE(launch_leaf(l));
   ASSERT_FALSE(launch_inner(l));
   ASSERT_TRUE(launch_idempotent(l));
+  ASSERT_FALSE(launch_split(l));
+  } // scope
+
+  {
+  launch_t l(single | split);
+
+  ASSERT_TRUE(launch_single(l));
+  ASSERT_FALSE(launch_leaf(l));
+  ASSERT_TRUE(launch_split(l));
   } // scope
 
 } // TEST
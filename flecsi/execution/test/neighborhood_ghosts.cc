@@ -0,0 +1,261 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+///
+/// \file
+/// \date Initial file creation: Oct 18, 2026
+///
+
+#include <cinchlog.h>
+#include <cinchtest.h>
+
+#include <flecsi/execution/execution.h>
+#include <flecsi/supplemental/coloring/add_colorings.h>
+#include <flecsi/supplemental/mesh/empty_mesh_2d.h>
+#include <flecsi/data/dense_accessor.h>
+
+#define CELLS 0
+#define VERTICES 1
+#define VERSIONS 1
+#define CYCLES 3
+
+using namespace flecsi;
+using namespace supplemental;
+
+clog_register_tag(neighborhood_ghosts);
+
+using namespace flecsi;
+using namespace topology;
+
+flecsi_register_data_client(empty_mesh_t, meshes, mesh1);
+
+flecsi_register_field(empty_mesh_t, name_space, cell_ID, size_t, dense,
+    VERSIONS, CELLS);
+flecsi_register_field(empty_mesh_t, name_space, cell_value, double, dense,
+    VERSIONS, CELLS);
+flecsi_register_field(empty_mesh_t, name_space, vertex_value, double, dense,
+    VERSIONS, VERTICES);
+
+// The value that the owner of an entity writes in a cycle. It depends on
+// the owner, so that a ghost copied from the wrong rank is detected.
+double
+entity_value(size_t id, size_t cycle, size_t owner) {
+  return 100.0 * id + 10.0 * cycle + owner;
+} // entity_value
+
+// The ghost values of each index space and cycle, as exchanged by
+// point-to-point messages from the owners. key: (index space, cycle)
+std::map<std::pair<size_t, size_t>, std::vector<double>> reference_ghosts;
+
+// Send the values of the shared entities to their users with one
+// message per peer, and return the received values in ghost order.
+std::vector<double>
+exchange_reference(size_t index_space, size_t cycle, int my_color) {
+  auto & context = flecsi::execution::context_t::instance();
+  auto & index_coloring = context.coloring(index_space);
+
+  std::map<size_t, std::vector<double>> send_values;
+
+  for (auto & shared: index_coloring.shared) {
+    for (auto user: shared.shared) {
+      send_values[user].push_back(shared.id);
+      send_values[user].push_back(entity_value(shared.id, cycle, my_color));
+    } // for
+  } // for
+
+  std::map<size_t, std::vector<double>> recv_values;
+
+  for (auto & ghost: index_coloring.ghost) {
+    recv_values[ghost.rank].resize(recv_values[ghost.rank].size() + 2);
+  } // for
+
+  std::vector<MPI_Request> requests;
+
+  for (auto & recv: recv_values) {
+    requests.push_back(MPI_REQUEST_NULL);
+    MPI_Irecv(recv.second.data(), recv.second.size(), MPI_DOUBLE,
+      recv.first, 0, MPI_COMM_WORLD, &requests.back());
+  } // for
+
+  for (auto & send: send_values) {
+    requests.push_back(MPI_REQUEST_NULL);
+    MPI_Isend(send.second.data(), send.second.size(), MPI_DOUBLE,
+      send.first, 0, MPI_COMM_WORLD, &requests.back());
+  } // for
+
+  MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+  std::map<size_t, double> values;
+
+  for (auto & recv: recv_values) {
+    for (size_t i = 0; i < recv.second.size(); i += 2) {
+      values[size_t(recv.second[i])] = recv.second[i + 1];
+    } // for
+  } // for
+
+  std::vector<double> ghosts;
+
+  for (auto & ghost: index_coloring.ghost) {
+    clog_assert(values.count(ghost.id), "missing ghost " << ghost.id);
+    ghosts.push_back(values[ghost.id]);
+  } // for
+
+  return ghosts;
+} // exchange_reference
+
+// Write the owned indices of all fields.
+void write_task(
+        dense_accessor<size_t, flecsi::rw, flecsi::rw, flecsi::ro> cell_ID,
+        dense_accessor<double, flecsi::rw, flecsi::rw, flecsi::ro> cell_value,
+        dense_accessor<double, flecsi::rw, flecsi::rw, flecsi::ro> vertex_value,
+        int my_color, size_t cycle) {
+  auto & context = flecsi::execution::context_t::instance();
+  auto & cells = context.coloring(CELLS);
+  auto & vertices = context.coloring(VERTICES);
+
+  size_t index = 0;
+  for (auto & exclusive: cells.exclusive) {
+    cell_ID.exclusive(index) = exclusive.id + cycle;
+    cell_value.exclusive(index) = entity_value(exclusive.id, cycle, my_color);
+    ++index;
+  } // for
+
+  index = 0;
+  for (auto & shared: cells.shared) {
+    cell_ID.shared(index) = shared.id + cycle;
+    cell_value.shared(index) = entity_value(shared.id, cycle, my_color);
+    ++index;
+  } // for
+
+  index = 0;
+  for (auto & exclusive: vertices.exclusive) {
+    vertex_value.exclusive(index) =
+      entity_value(exclusive.id, cycle, my_color);
+    ++index;
+  } // for
+
+  index = 0;
+  for (auto & shared: vertices.shared) {
+    vertex_value.shared(index) = entity_value(shared.id, cycle, my_color);
+    ++index;
+  } // for
+} // write_task
+
+flecsi_register_task_simple(write_task, loc, single|leaf);
+
+// Check the cell and vertex ghosts against the reference.
+void check_task(
+        dense_accessor<size_t, flecsi::ro, flecsi::ro, flecsi::ro> cell_ID,
+        dense_accessor<double, flecsi::ro, flecsi::ro, flecsi::ro> cell_value,
+        dense_accessor<double, flecsi::ro, flecsi::ro, flecsi::ro> vertex_value,
+        size_t cycle) {
+  auto & context = flecsi::execution::context_t::instance();
+  auto & cells = context.coloring(CELLS);
+  auto & cell_ghosts = reference_ghosts.at({CELLS, cycle});
+  auto & vertex_ghosts = reference_ghosts.at({VERTICES, cycle});
+
+  ASSERT_EQ(cell_value.ghost_size(), cell_ghosts.size());
+  ASSERT_EQ(vertex_value.ghost_size(), vertex_ghosts.size());
+
+  size_t index = 0;
+  for (auto & ghost: cells.ghost) {
+    ASSERT_EQ(cell_ID.ghost(index), ghost.id + cycle);
+    ASSERT_EQ(cell_value.ghost(index), cell_ghosts[index]);
+    ++index;
+  } // for
+
+  for (size_t i = 0; i < vertex_ghosts.size(); ++i) {
+    ASSERT_EQ(vertex_value.ghost(i), vertex_ghosts[i]);
+  } // for
+} // check_task
+
+flecsi_register_task_simple(check_task, loc, single|leaf);
+
+// Check only the cell value ghosts, which needs an exchange schedule
+// for a different set of fields.
+void check_cell_value_task(
+        dense_accessor<double, flecsi::ro, flecsi::ro, flecsi::ro> cell_value,
+        size_t cycle) {
+  auto & cell_ghosts = reference_ghosts.at({CELLS, cycle});
+
+  ASSERT_EQ(cell_value.ghost_size(), cell_ghosts.size());
+
+  for (size_t i = 0; i < cell_ghosts.size(); ++i) {
+    ASSERT_EQ(cell_value.ghost(i), cell_ghosts[i]);
+  } // for
+} // check_cell_value_task
+
+flecsi_register_task_simple(check_cell_value_task, loc, single|leaf);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  clog(trace) << "In specialization top-level-task init" << std::endl;
+
+  coloring_map_t map;
+  map.vertices = VERTICES;
+  map.cells = CELLS;
+
+  flecsi_execute_mpi_task(add_colorings, flecsi::execution, map);
+
+} // specialization_tlt_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  int my_color;
+  MPI_Comm_rank(MPI_COMM_WORLD, &my_color);
+
+  // The reference exchanges run before any task, since the tasks may run
+  // on other threads.
+  for (size_t cycle = 0; cycle < CYCLES; ++cycle) {
+    for (size_t index_space: {CELLS, VERTICES}) {
+      reference_ghosts[{index_space, cycle}] =
+        exchange_reference(index_space, cycle, my_color);
+    } // for
+  } // for
+
+  auto ch = flecsi_get_client_handle(empty_mesh_t, meshes, mesh1);
+
+  auto cell_ID = flecsi_get_handle(ch, name_space, cell_ID, size_t, dense,
+      0);
+  auto cell_value = flecsi_get_handle(ch, name_space, cell_value, double,
+      dense, 0);
+  auto vertex_value = flecsi_get_handle(ch, name_space, vertex_value, double,
+      dense, 0);
+
+  for (size_t cycle = 0; cycle < CYCLES; ++cycle) {
+    flecsi_execute_task_simple(write_task, single, cell_ID, cell_value,
+      vertex_value, my_color, cycle);
+
+    if (cycle % 2) {
+      flecsi_execute_task_simple(check_cell_value_task, single, cell_value,
+        cycle);
+    } // if
+
+    flecsi_execute_task_simple(check_task, single, cell_ID, cell_value,
+      vertex_value, cycle);
+  } // for
+
+} // driver
+
+} // namespace execution
+} // namespace flecsi
+
+TEST(neighborhood_ghosts, testname) {
+
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,140 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+///
+/// \file
+/// \date Initial file creation: Oct 18, 2026
+///
+
+#include <cinchlog.h>
+#include <cinchtest.h>
+
+#include <flecsi/execution/execution.h>
+#include <flecsi/coloring/mpi_utils.h>
+#include <flecsi/supplemental/coloring/add_colorings.h>
+
+using namespace flecsi;
+
+clog_register_tag(remap_shared);
+
+using entity_set_t = std::set<flecsi::coloring::entity_info_t>;
+
+// The remapped shared and ghost entities of each index space, computed
+// with one message per shared entity and peer. key: index space
+std::map<size_t, std::pair<entity_set_t, entity_set_t>> reference;
+
+// Remap the shared and ghost entities of an index coloring by sending
+// the offset of each shared entity to each of its peers in a separate
+// message.
+std::pair<entity_set_t, entity_set_t>
+remap_per_entity(const flecsi::coloring::index_coloring_t & index_coloring) {
+  entity_set_t new_shared;
+  std::vector<size_t> offsets;
+  std::vector<MPI_Request> requests;
+
+  // The offsets are stored before sending, so that the send buffers do
+  // not move.
+  offsets.reserve(index_coloring.shared.size());
+
+  size_t index = 0;
+  for (auto & shared: index_coloring.shared) {
+    offsets.push_back(index);
+
+    for (auto peer: shared.shared) {
+      requests.push_back(MPI_REQUEST_NULL);
+      MPI_Isend(&offsets.back(), 1,
+        flecsi::coloring::mpi_typetraits__<size_t>::type(), peer, 77,
+        MPI_COMM_WORLD, &requests.back());
+    } // for
+
+    new_shared.insert(flecsi::coloring::entity_info_t(shared.id,
+      shared.rank, index, shared.shared));
+    ++index;
+  } // for
+
+  entity_set_t new_ghost;
+
+  for (auto & ghost: index_coloring.ghost) {
+    size_t offset;
+    MPI_Recv(&offset, 1, flecsi::coloring::mpi_typetraits__<size_t>::type(),
+      ghost.rank, 77, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    new_ghost.insert(
+      flecsi::coloring::entity_info_t(ghost.id, ghost.rank, offset, {}));
+  } // for
+
+  MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+  return { new_shared, new_ghost };
+} // remap_per_entity
+
+// Check that two sets of entities have the same ids, owners and offsets.
+void
+check_entities(const entity_set_t & entities, const entity_set_t & expected) {
+  ASSERT_EQ(entities.size(), expected.size());
+
+  auto eita = expected.begin();
+  for (auto & entity: entities) {
+    ASSERT_EQ(entity.id, eita->id);
+    ASSERT_EQ(entity.rank, eita->rank);
+    ASSERT_EQ(entity.offset, eita->offset);
+    ++eita;
+  } // for
+} // check_entities
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  clog(trace) << "In specialization top-level-task init" << std::endl;
+
+  coloring_map_t map;
+  map.vertices = 1;
+  map.cells = 0;
+
+  flecsi_execute_mpi_task(add_colorings, flecsi::execution, map);
+
+  // Compute the reference from the colorings before the runtime driver
+  // remaps them, i.e., after this function returns.
+  auto & context = context_t::instance();
+
+  for (auto & is: context.coloring_map()) {
+    reference[is.first] = remap_per_entity(is.second);
+  } // for
+
+} // specialization_tlt_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto & context = context_t::instance();
+
+  ASSERT_EQ(context.coloring_map().size(), reference.size());
+
+  for (auto & is: context.coloring_map()) {
+    auto & expected = reference.at(is.first);
+
+    check_entities(is.second.shared, expected.first);
+    check_entities(is.second.ghost, expected.second);
+  } // for
+
+} // driver
+
+} // namespace execution
+} // namespace flecsi
+
+TEST(remap_shared, testname) {
+
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
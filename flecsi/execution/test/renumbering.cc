@@ -0,0 +1,269 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+
+#include <flecsi/execution/execution.h>
+#include <flecsi/io/simple_definition.h>
+#include <flecsi/coloring/dcrs_utils.h>
+#include <flecsi/coloring/ordering.h>
+#include <flecsi/coloring/parmetis_colorer.h>
+#include <flecsi/coloring/mpi_communicator.h>
+#include <flecsi/supplemental/coloring/add_colorings.h>
+
+using namespace std;
+using namespace flecsi;
+using namespace topology;
+using namespace execution;
+using namespace coloring;
+
+clog_register_tag(coloring);
+
+class vertex : public mesh_entity__<0, 1>{
+public:
+  template<size_t M>
+  uint64_t precedence() const { return 0; }
+  vertex() = default;
+
+};
+
+class cell : public mesh_entity__<2, 1>{
+public:
+
+  using id_t = flecsi::utils::id_t;
+
+}; // class cell
+
+class test_mesh_types_t{
+public:
+  static constexpr size_t num_dimensions = 2;
+
+  static constexpr size_t num_domains = 1;
+
+  using id_t = flecsi::utils::id_t;
+
+  using entity_types = std::tuple<
+    std::tuple<index_space_<0>, domain_<0>, cell>,
+    std::tuple<index_space_<1>, domain_<0>, vertex>>;
+
+  using connectivities =
+    std::tuple<std::tuple<index_space_<3>, domain_<0>, cell, vertex>>;
+
+  using bindings = std::tuple<>;
+
+  template<size_t M, size_t D, typename ST>
+  static mesh_entity_base__<num_domains>*
+  create_entity(mesh_topology_base__<ST>* mesh, size_t num_vertices,
+    id_t const & id){
+    assert(false && "invalid domain");
+    return nullptr;
+  }
+};
+
+struct test_mesh_t : public mesh_topology__<test_mesh_types_t> {};
+
+// The mesh id of a local entity.
+size_t
+mesh_id(size_t index_space, size_t index)
+{
+  return context_t::instance().index_map(index_space).at(index);
+} // mesh_id
+
+// The largest difference between the local ids of adjacent exclusive
+// cells, with the given mesh ids of the exclusive cells.
+size_t
+bandwidth(const flecsi::io::simple_definition_t & sd,
+  const std::vector<size_t> & exclusive)
+{
+  auto graph = make_crs<2, 1>(sd, exclusive);
+  size_t result = 0;
+
+  for(size_t v = 0; v < graph.size(); ++v) {
+    for(size_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+      const size_t u = graph.indices[e];
+      result = std::max(result, u > v ? u - v : v - u);
+    }
+  }
+
+  return result;
+} // bandwidth
+
+void set_values_task(dense_accessor<double, rw, rw, ro> cd,
+  dense_accessor<double, rw, rw, ro> vd) {
+  auto& context = execution::context_t::instance();
+
+  for(size_t is = 0; is < 2; ++is) {
+    auto& d = is == 0 ? cd : vd;
+    auto coloring_info = context.coloring_info(is).at(context.color());
+
+    for(size_t i = 0; i < coloring_info.exclusive + coloring_info.shared; ++i){
+      d(i) = mesh_id(is, i);
+    }
+  }
+} // set_values_task
+
+void check_values_task(dense_accessor<double, ro, ro, ro> cd,
+  dense_accessor<double, ro, ro, ro> vd) {
+  auto& context = execution::context_t::instance();
+
+  // The ghost indices are updated before the task.
+  for(size_t is = 0; is < 2; ++is) {
+    auto& d = is == 0 ? cd : vd;
+    auto coloring_info = context.coloring_info(is).at(context.color());
+    const size_t num_total = coloring_info.exclusive + coloring_info.shared +
+      coloring_info.ghost;
+
+    for(size_t i = 0; i < num_total; ++i){
+      ASSERT_EQ(d(i), mesh_id(is, i));
+    }
+  }
+} // check_values_task
+
+flecsi_register_data_client(test_mesh_t, meshes, mesh1);
+
+flecsi_register_task_simple(set_values_task, loc, single);
+flecsi_register_task_simple(check_values_task, loc, single);
+
+flecsi_register_field(test_mesh_t, hydro, cell_density, double, dense, 1, 0);
+flecsi_register_field(test_mesh_t, hydro, vertex_density, double, dense, 1,
+  1);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  clog(info) << "In specialization top-level-task init" << std::endl;
+  coloring_map_t map;
+  map.vertices = 1;
+  map.cells = 0;
+  flecsi_execute_mpi_task(add_colorings, flecsi::execution, map);
+
+  auto& context = execution::context_t::instance();
+
+  auto& cc = context.coloring_info(0);
+
+  adjacency_info_t ai;
+  ai.index_space = 3;
+  ai.from_index_space = 0;
+  ai.to_index_space = 1;
+  ai.color_sizes.resize(cc.size());
+
+  for(auto& itr : cc){
+    size_t color = itr.first;
+    const coloring_info_t& ci = itr.second;
+    ai.color_sizes[color] = (ci.exclusive + ci.shared + ci.ghost) * 4;
+  }
+
+  context.add_adjacency(ai);
+
+  // Order the primary cells of this color by reverse Cuthill-McKee, and
+  // the vertices after the cells.
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+  auto& cells = context.coloring(0);
+
+  std::vector<size_t> primary;
+  for(auto& c : cells.exclusive) {
+    primary.push_back(c.id);
+  }
+  for(auto& c : cells.shared) {
+    primary.push_back(c.id);
+  }
+
+  std::vector<size_t> cell_order;
+  for(auto i : reverse_cuthill_mckee(make_crs<2, 1>(sd, primary))) {
+    cell_order.push_back(primary[i]);
+  }
+
+  context.set_entity_order(1, induced_order(sd, 2, 0, cell_order));
+  context.set_entity_order(0, std::move(cell_order));
+} // specialization_tlt_init
+
+void specialization_spmd_init(int argc, char ** argv) {
+
+} // specialization_spmd_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto& context = execution::context_t::instance();
+  flecsi::io::simple_definition_t sd("simple2d-16x16.msh");
+
+  for(size_t is = 0; is < 2; ++is) {
+    auto& coloring = context.coloring(is);
+    auto& order = context.entity_order_map().at(is);
+    auto& index_map = context.index_map(is);
+
+    // The exclusive entities are numbered in the requested order.
+    std::vector<size_t> expected;
+    for(auto id : order) {
+      if(coloring.exclusive.count(entity_info_t(id))) {
+        expected.push_back(id);
+      }
+    }
+
+    ASSERT_EQ(expected.size(), coloring.exclusive.size());
+
+    size_t index = 0;
+    for(auto id : expected) {
+      ASSERT_EQ(index_map.at(index), id);
+      ASSERT_EQ(context.reverse_index_map(is).at(id), index);
+      ++index;
+    }
+
+    // The shared and ghost entities keep the order of their mesh ids.
+    for(auto& e : coloring.shared) {
+      ASSERT_EQ(index_map.at(index++), e.id);
+    }
+    for(auto& e : coloring.ghost) {
+      ASSERT_EQ(index_map.at(index++), e.id);
+    }
+  }
+
+  // The ordering does not widen the exclusive cell graph.
+  auto& cells = context.coloring(0);
+  const size_t num_exclusive = cells.exclusive.size();
+
+  std::vector<size_t> by_id;
+  for(auto& c : cells.exclusive) {
+    by_id.push_back(c.id);
+  }
+
+  std::vector<size_t> by_order;
+  for(size_t i = 0; i < num_exclusive; ++i) {
+    by_order.push_back(mesh_id(0, i));
+  }
+
+  ASSERT_LE(bandwidth(sd, by_order), bandwidth(sd, by_id));
+
+  // The ghost updates use the new numbering.
+  auto ch = flecsi_get_client_handle(test_mesh_t, meshes, mesh1);
+  auto cd = flecsi_get_handle(ch, hydro, cell_density, double, dense, 0);
+  auto vd = flecsi_get_handle(ch, hydro, vertex_density, double, dense, 0);
+
+  flecsi_execute_task_simple(set_values_task, single, cd, vd).wait();
+  flecsi_execute_task_simple(check_values_task, single, cd, vd).wait();
+} // driver
+
+//----------------------------------------------------------------------------//
+// TEST.
+//----------------------------------------------------------------------------//
+
+TEST(renumbering, testname) {
+
+} // TEST
+
+} // namespace execution
+} // namespace flecsi
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,424 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+
+#include <flecsi/execution/execution.h>
+#include <flecsi/io/simple_definition.h>
+#include <flecsi/coloring/dcrs_utils.h>
+#include <flecsi/coloring/parmetis_colorer.h>
+#include <flecsi/coloring/mpi_communicator.h>
+#include <flecsi/supplemental/coloring/add_colorings.h>
+#include <flecsi/data/mutator_handle.h>
+#include <flecsi/data/sparse_accessor.h>
+#include <flecsi/data/mutator.h>
+#include <flecsi/data/ragged_accessor.h>
+#include <flecsi/data/ragged_mutator.h>
+
+using namespace std;
+using namespace flecsi;
+using namespace topology;
+using namespace execution;
+using namespace coloring;
+
+clog_register_tag(coloring);
+
+class vertex : public mesh_entity__<0, 1>{
+public:
+  template<size_t M>
+  uint64_t precedence() const { return 0; }
+  vertex() = default;
+
+};
+
+class cell : public mesh_entity__<2, 1>{
+public:
+
+  using id_t = flecsi::utils::id_t;
+
+  std::vector<size_t>
+  create_entities(id_t cell_id, size_t dim, domain_connectivity__<2> & c, id_t * e){
+    id_t* v = c.get_entities(cell_id, 0);
+
+    e[0] = v[0];
+    e[1] = v[2];
+
+    e[2] = v[1];
+    e[3] = v[3];
+
+    e[4] = v[0];
+    e[5] = v[1];
+
+    e[6] = v[2];
+    e[7] = v[3];
+
+    return {2, 2, 2, 2};
+  }
+
+}; // class cell
+
+class test_mesh_types_t{
+public:
+  static constexpr size_t num_dimensions = 2;
+
+  static constexpr size_t num_domains = 1;
+
+  using id_t = flecsi::utils::id_t;
+
+  using entity_types = std::tuple<
+    std::tuple<index_space_<0>, domain_<0>, cell>,
+    std::tuple<index_space_<1>, domain_<0>, vertex>>;
+
+  using connectivities =
+    std::tuple<std::tuple<index_space_<3>, domain_<0>, cell, vertex>>;
+
+  using bindings = std::tuple<>;
+
+  template<size_t M, size_t D, typename ST>
+  static mesh_entity_base__<num_domains>*
+  create_entity(mesh_topology_base__<ST>* mesh, size_t num_vertices,
+    id_t const & id){
+    assert(false && "invalid domain");
+    return nullptr;
+  }
+};
+
+struct test_mesh_t : public mesh_topology__<test_mesh_types_t> {};
+
+template<typename DC, size_t PS>
+using client_handle_t = data_client_handle__<DC, PS>;
+
+// The mesh id of a local cell.
+size_t
+cell_id(size_t index)
+{
+  return context_t::instance().index_map(0).at(index);
+} // cell_id
+
+void set_values_task(dense_accessor<double, rw, rw, ro> d,
+  sparse_mutator<double> m, double scale) {
+  auto& context = execution::context_t::instance();
+  auto coloring_info = context.coloring_info(0).at(context.color());
+
+  for(size_t i = 0; i < coloring_info.exclusive + coloring_info.shared; ++i){
+    d(i) = scale * cell_id(i);
+
+    for(size_t j = 0; j < 5; j += 2){
+      m(i, j) = scale * (cell_id(i) * 10 + j);
+    }
+  }
+} // set_values_task
+
+void negate_task(sparse_accessor<double, rw, rw, ro> h) {
+  auto& context = execution::context_t::instance();
+  auto coloring_info = context.coloring_info(0).at(context.color());
+
+  for(size_t i = 0; i < coloring_info.exclusive + coloring_info.shared; ++i){
+    for (auto entry : h.entries(i)) {
+      h(i, entry) = -h(i, entry);
+    }
+  }
+} // negate_task
+
+void check_values_task(dense_accessor<double, ro, ro, ro> d,
+  sparse_accessor<double, ro, ro, ro> h, double scale, double sign) {
+  auto& context = execution::context_t::instance();
+  auto coloring_info = context.coloring_info(0).at(context.color());
+
+  const size_t num_total = coloring_info.exclusive + coloring_info.shared +
+    coloring_info.ghost;
+  ASSERT_EQ(context.index_map(0).size(), num_total);
+
+  // The ghost indices of the dense field are updated before the task.
+  for(size_t i = 0; i < num_total; ++i){
+    ASSERT_EQ(d(i), scale * cell_id(i));
+  }
+
+  for(size_t i = 0; i < num_total; ++i){
+    auto entries = h.entries(i);
+    ASSERT_EQ(entries.size(), 3);
+
+    for (auto entry : entries) {
+      ASSERT_EQ(h(i, entry), sign * (cell_id(i) * 10 + entry));
+    }
+  }
+} // check_values_task
+
+// The number of entries of a cell in the ragged field.
+size_t
+ragged_size(size_t id)
+{
+  return 1 + id % 4;
+} // ragged_size
+
+void set_ragged_task(ragged_mutator<double> m, double scale) {
+  auto& context = execution::context_t::instance();
+  auto coloring_info = context.coloring_info(0).at(context.color());
+
+  for(size_t i = 0; i < coloring_info.exclusive + coloring_info.shared; ++i){
+    m.resize(i, ragged_size(cell_id(i)));
+
+    for(size_t j = 0; j < ragged_size(cell_id(i)); ++j){
+      m(i, j) = scale * (cell_id(i) * 10 + j);
+    }
+  }
+} // set_ragged_task
+
+void check_ragged_task(ragged_accessor<double, ro, ro, ro> r, double scale) {
+  auto& context = execution::context_t::instance();
+  auto coloring_info = context.coloring_info(0).at(context.color());
+
+  const size_t num_total = coloring_info.exclusive + coloring_info.shared +
+    coloring_info.ghost;
+
+  for(size_t i = 0; i < num_total; ++i){
+    ASSERT_EQ(r.entries(i).size(), ragged_size(cell_id(i)));
+
+    for(size_t j = 0; j < ragged_size(cell_id(i)); ++j){
+      ASSERT_EQ(r(i, j), scale * (cell_id(i) * 10 + j));
+    }
+  }
+} // check_ragged_task
+
+// Build the local mesh from the current partition of the cells and the
+// vertices.
+void init_mesh_task(client_handle_t<test_mesh_t, wo> mesh) {
+  auto& context = execution::context_t::instance();
+  flecsi::io::simple_definition_t sd("simple2d-8x8.msh");
+
+  auto & reverse_vertex_map = context.reverse_index_map(1);
+
+  std::vector<vertex *> vertices;
+  for(size_t i = 0; i < context.index_map(1).size(); ++i){
+    vertices.push_back(mesh.make<vertex>());
+  }
+
+  for(size_t i = 0; i < context.index_map(0).size(); ++i){
+    auto v = sd.entities(2, 0, cell_id(i));
+
+    auto c = mesh.make<cell>();
+    mesh.init_cell<0>(c, { vertices[reverse_vertex_map.at(v[0])],
+      vertices[reverse_vertex_map.at(v[1])],
+      vertices[reverse_vertex_map.at(v[2])],
+      vertices[reverse_vertex_map.at(v[3])] });
+  }
+
+  mesh.init<0>();
+} // init_mesh_task
+
+// Check that the vertices of each local cell are those of the mesh
+// definition.
+void check_mesh_task(client_handle_t<test_mesh_t, ro> mesh) {
+  auto& context = execution::context_t::instance();
+  flecsi::io::simple_definition_t sd("simple2d-8x8.msh");
+
+  auto & vertex_map = context.index_map(1);
+
+  size_t count = 0;
+  for(auto c: mesh.entities<2,0>()){
+    auto v = sd.entities(2, 0, cell_id(c->template id<0>()));
+    std::set<size_t> expected(v.begin(), v.end());
+
+    std::set<size_t> vertices;
+    for(auto vertex: mesh.entities<0,0>(c)){
+      vertices.insert(vertex_map.at(vertex->template id<0>()));
+    }
+
+    ASSERT_EQ(vertices, expected);
+    ++count;
+  }
+
+  ASSERT_EQ(count, context.index_map(0).size());
+} // check_mesh_task
+
+flecsi_register_data_client(test_mesh_t, meshes, mesh1);
+
+flecsi_register_task_simple(set_values_task, loc, single);
+flecsi_register_task_simple(negate_task, loc, single);
+flecsi_register_task_simple(check_values_task, loc, single);
+flecsi_register_task_simple(set_ragged_task, loc, single);
+flecsi_register_task_simple(check_ragged_task, loc, single);
+flecsi_register_task_simple(init_mesh_task, loc, single);
+flecsi_register_task_simple(check_mesh_task, loc, single);
+
+flecsi_register_field(test_mesh_t, hydro, density, double, dense, 1, 0);
+flecsi_register_field(test_mesh_t, hydro, pressure, double, sparse, 1, 0);
+flecsi_register_field(test_mesh_t, hydro, volume, double, ragged, 1, 0);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  clog(info) << "In specialization top-level-task init" << std::endl;
+  coloring_map_t map;
+  map.vertices = 1;
+  map.cells = 0;
+  flecsi_execute_mpi_task(add_colorings, flecsi::execution, map);
+
+  auto& context = execution::context_t::instance();
+
+  auto& cc = context.coloring_info(0);
+
+  adjacency_info_t ai;
+  ai.index_space = 3;
+  ai.from_index_space = 0;
+  ai.to_index_space = 1;
+  ai.color_sizes.resize(cc.size());
+
+  for(auto& itr : cc){
+    size_t color = itr.first;
+    const coloring_info_t& ci = itr.second;
+    ai.color_sizes[color] = (ci.exclusive + ci.shared + ci.ghost) * 4;
+  }
+
+  context.add_adjacency(ai);
+
+  execution::context_t::sparse_index_space_info_t isi;
+  isi.max_entries_per_index = 5;
+  isi.reserve_chunk = 64;
+  isi.max_exclusive_entries = 8192;
+  context.set_sparse_index_space_info(0, isi);
+} // specialization_tlt_init
+
+void specialization_spmd_init(int argc, char ** argv) {
+  auto ch = flecsi_get_client_handle(test_mesh_t, meshes, mesh1);
+  flecsi_execute_task_simple(init_mesh_task, single, ch).wait();
+} // specialization_spmd_init
+
+// Update the sizes of the cell to vertex adjacency for the current
+// partition of the cells.
+void update_adjacency() {
+  auto& context = execution::context_t::instance();
+
+  adjacency_info_t ai = context.adjacency_info().at(3);
+
+  for(auto& itr : context.coloring_info(0)){
+    const coloring_info_t& ci = itr.second;
+    ai.color_sizes[itr.first] = (ci.exclusive + ci.shared + ci.ghost) * 4;
+  }
+
+  context.update_adjacency(ai);
+} // update_adjacency
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto& context = execution::context_t::instance();
+
+  {
+  auto ch = flecsi_get_client_handle(test_mesh_t, meshes, mesh1);
+  auto dh = flecsi_get_handle(ch, hydro, density, double, dense, 0);
+  auto mh = flecsi_get_mutator(ch, hydro, pressure, double, sparse, 0, 5);
+
+  flecsi_execute_task_simple(set_values_task, single, dh, mh, 1.0).wait();
+
+  auto rh = flecsi_get_mutator(ch, hydro, volume, double, ragged, 0, 5);
+  flecsi_execute_task_simple(set_ragged_task, single, rh, 1.0).wait();
+
+  flecsi_execute_task_simple(check_mesh_task, single, ch).wait();
+  } // scope
+
+  // Move each block of the naive partition of the cells to the next
+  // rank. The ghosts are the nearest neighbors of the new primary cells.
+  flecsi::io::simple_definition_t sd("simple2d-8x8.msh");
+
+  const size_t colors = context.colors();
+  const size_t color = (context.color() + 1) % colors;
+  const size_t cells = sd.num_entities(2);
+  const size_t quot = cells / colors;
+  const size_t rem = cells % colors;
+  const size_t begin = color * quot + std::min(color, rem);
+  const size_t end = begin + quot + (color < rem ? 1 : 0);
+
+  std::set<size_t> primary;
+  for(size_t c = begin; c < end; ++c) {
+    primary.insert(c);
+  }
+
+  auto ghost = flecsi::utils::set_difference(
+    flecsi::topology::entity_neighbors<2,2,0>(sd, primary), primary);
+
+  context.repartition(0, primary, ghost);
+
+  auto & coloring = context.coloring(0);
+  ASSERT_EQ(coloring.exclusive.size() + coloring.shared.size(),
+    primary.size());
+  ASSERT_EQ(coloring.ghost.size(), ghost.size());
+
+  // Move the vertices in the same way. The ghosts are the other vertices
+  // of the new local cells.
+  const size_t vertices = sd.num_entities(0);
+  const size_t vquot = vertices / colors;
+  const size_t vrem = vertices % colors;
+  const size_t vbegin = color * vquot + std::min(color, vrem);
+  const size_t vend = vbegin + vquot + (color < vrem ? 1 : 0);
+
+  std::set<size_t> vertex_primary;
+  for(size_t v = vbegin; v < vend; ++v) {
+    vertex_primary.insert(v);
+  }
+
+  std::set<size_t> vertex_ghost;
+  for(auto c: flecsi::utils::set_union(primary, ghost)) {
+    for(auto v: sd.entities(2, 0, c)) {
+      if(!vertex_primary.count(v)) {
+        vertex_ghost.insert(v);
+      }
+    }
+  }
+
+  context.repartition(1, vertex_primary, vertex_ghost);
+
+  // The topology is initialized again for the new partition.
+  update_adjacency();
+
+  // The handles are acquired again after the repartition.
+  auto ch = flecsi_get_client_handle(test_mesh_t, meshes, mesh1);
+  auto dh = flecsi_get_handle(ch, hydro, density, double, dense, 0);
+  auto ph = flecsi_get_handle(ch, hydro, pressure, double, sparse, 0);
+
+  // The data is migrated, including the ghost indices.
+  flecsi_execute_task_simple(check_values_task, single, dh, ph, 1.0,
+    1.0).wait();
+
+  auto rh = flecsi_get_handle(ch, hydro, volume, double, ragged, 0);
+  flecsi_execute_task_simple(check_ragged_task, single, rh, 1.0).wait();
+
+  flecsi_execute_task_simple(init_mesh_task, single, ch).wait();
+  flecsi_execute_task_simple(check_mesh_task, single, ch).wait();
+
+  // The ghost updates use the new coloring.
+  auto mh = flecsi_get_mutator(ch, hydro, pressure, double, sparse, 0, 5);
+  flecsi_execute_task_simple(set_values_task, single, dh, mh, 2.0).wait();
+
+  ph = flecsi_get_handle(ch, hydro, pressure, double, sparse, 0);
+  flecsi_execute_task_simple(negate_task, single, ph).wait();
+
+  ph = flecsi_get_handle(ch, hydro, pressure, double, sparse, 0);
+  flecsi_execute_task_simple(check_values_task, single, dh, ph, 2.0,
+    -2.0).wait();
+} // driver
+
+//----------------------------------------------------------------------------//
+// TEST.
+//----------------------------------------------------------------------------//
+
+TEST(repartition, testname) {
+
+} // TEST
+
+} // namespace execution
+} // namespace flecsi
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,228 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+///
+/// \file
+/// \date Initial file creation: Oct 18, 2026
+///
+
+#include <cinchlog.h>
+#include <cinchtest.h>
+
+#include <flecsi/execution/execution.h>
+#include <flecsi/supplemental/coloring/add_colorings.h>
+#include <flecsi/supplemental/mesh/empty_mesh_2d.h>
+#include <flecsi/data/dense_accessor.h>
+
+#define INDEX_ID 0
+#define VERSIONS 1
+
+using namespace flecsi;
+using namespace supplemental;
+
+clog_register_tag(split_task);
+
+using namespace flecsi;
+using namespace topology;
+
+flecsi_register_data_client(empty_mesh_t, meshes, mesh1);
+
+void set_cells_task(
+        dense_accessor<size_t, flecsi::rw, flecsi::rw, flecsi::ro> cell_ID,
+        size_t cycle);
+flecsi_register_task_simple(set_cells_task, loc, single|leaf);
+
+void ghost_sum_task(
+        dense_accessor<size_t, flecsi::ro, flecsi::ro, flecsi::ro> cell_ID,
+        dense_accessor<size_t, flecsi::rw, flecsi::rw, flecsi::ro> sum);
+flecsi_register_task_simple(ghost_sum_task, loc, single|leaf|split);
+
+void check_sum_task(
+        dense_accessor<size_t, flecsi::ro, flecsi::ro, flecsi::ro> sum,
+        size_t cycle);
+flecsi_register_task_simple(check_sum_task, loc, single|leaf);
+
+flecsi_register_field(empty_mesh_t, name_space, cell_ID, size_t, dense,
+    VERSIONS, INDEX_ID);
+flecsi_register_field(empty_mesh_t, name_space, sum, size_t, dense,
+    VERSIONS, INDEX_ID);
+
+// Number of times ghost_sum_task was executed on each partition.
+size_t exclusive_calls = 0;
+size_t shared_calls = 0;
+
+// The number of indices computed by the bodies below.
+size_t computed = 0;
+
+// The body of a split task, which only computes its partition.
+void restricted_body() {
+  auto & context = flecsi::execution::context_t::instance();
+
+  if(context.task_partition() & exclusive) {
+    ++computed;
+  } // if
+} // restricted_body
+
+// The body of a task, which computes all of the indices.
+void unrestricted_body() {
+  ++computed;
+} // unrestricted_body
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  clog(trace) << "In specialization top-level-task init" << std::endl;
+
+  coloring_map_t map;
+  map.vertices = 1;
+  map.cells = 0;
+
+  flecsi_execute_mpi_task(add_colorings, flecsi::execution, map);
+
+} // specialization_tlt_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto ch = flecsi_get_client_handle(empty_mesh_t, meshes, mesh1);
+
+  auto cell_handle = flecsi_get_handle(ch, name_space, cell_ID, size_t, dense,
+      INDEX_ID);
+  auto sum_handle = flecsi_get_handle(ch, name_space, sum, size_t, dense,
+      INDEX_ID);
+
+  const size_t cycles = 3;
+
+  for(size_t cycle=0; cycle<cycles; cycle++) {
+    flecsi_execute_task_simple(set_cells_task, single, cell_handle, cycle);
+
+    flecsi_execute_task_simple(ghost_sum_task, single, cell_handle,
+      sum_handle);
+
+    flecsi_execute_task_simple(check_sum_task, single, sum_handle, cycle);
+  } // for
+
+  // The ghosts of cell_ID are stale in every cycle, so that the task is
+  // always split into an exclusive and a shared part.
+  ASSERT_EQ(exclusive_calls, cycles);
+  ASSERT_EQ(shared_calls, cycles);
+
+  // Without stale ghosts, the task runs once on the owned indices.
+  flecsi_execute_task_simple(ghost_sum_task, single, cell_handle,
+    sum_handle);
+
+  ASSERT_EQ(exclusive_calls, cycles);
+  ASSERT_EQ(shared_calls, cycles);
+
+  // The runtime checks that a split task reads its partition, so that a
+  // task that does not is not silently executed twice on every index.
+  auto & context = context_t::instance();
+
+  context.set_task_partition(exclusive);
+  restricted_body();
+  ASSERT_TRUE(context.task_partition_read());
+
+  context.set_task_partition(exclusive);
+  unrestricted_body();
+  ASSERT_FALSE(context.task_partition_read());
+
+  context.set_task_partition(owned);
+
+} // driver
+
+} // namespace execution
+} // namespace flecsi
+
+void set_cells_task(
+        dense_accessor<size_t, flecsi::rw, flecsi::rw, flecsi::ro> cell_ID,
+        size_t cycle) {
+  flecsi::execution::context_t & context_
+    = flecsi::execution::context_t::instance();
+  auto & index_coloring = context_.coloring(INDEX_ID);
+
+  size_t index = 0;
+  for (auto & exclusive : index_coloring.exclusive) {
+    cell_ID.exclusive(index++) = exclusive.id + cycle;
+  } // for
+
+  index = 0;
+  for (auto & shared : index_coloring.shared) {
+    cell_ID.shared(index++) = shared.id + cycle;
+  } // for
+} // set_cells_task
+
+void ghost_sum_task(
+        dense_accessor<size_t, flecsi::ro, flecsi::ro, flecsi::ro> cell_ID,
+        dense_accessor<size_t, flecsi::rw, flecsi::rw, flecsi::ro> sum) {
+  flecsi::execution::context_t & context_
+    = flecsi::execution::context_t::instance();
+  const auto partition = context_.task_partition();
+
+  // The exclusive indices do not depend on the ghost indices.
+  if(partition & exclusive) {
+    if(partition == exclusive) {
+      ++exclusive_calls;
+    } // if
+
+    for (size_t i = 0; i < cell_ID.exclusive_size(); ++i) {
+      sum.exclusive(i) = cell_ID.exclusive(i);
+    } // for
+  } // if
+
+  // The shared indices sum all of the ghost indices.
+  if(partition & shared) {
+    if(partition == shared) {
+      ++shared_calls;
+    } // if
+
+    size_t ghost_sum = 0;
+    for (size_t i = 0; i < cell_ID.ghost_size(); ++i) {
+      ghost_sum += cell_ID.ghost(i);
+    } // for
+
+    for (size_t i = 0; i < cell_ID.shared_size(); ++i) {
+      sum.shared(i) = cell_ID.shared(i) + ghost_sum;
+    } // for
+  } // if
+} // ghost_sum_task
+
+void check_sum_task(
+        dense_accessor<size_t, flecsi::ro, flecsi::ro, flecsi::ro> sum,
+        size_t cycle) {
+  flecsi::execution::context_t & context_
+    = flecsi::execution::context_t::instance();
+  auto & index_coloring = context_.coloring(INDEX_ID);
+
+  size_t ghost_sum = 0;
+  for (auto & ghost : index_coloring.ghost) {
+    ghost_sum += ghost.id + cycle;
+  } // for
+
+  size_t index = 0;
+  for (auto & exclusive : index_coloring.exclusive) {
+    ASSERT_EQ(sum.exclusive(index++), exclusive.id + cycle);
+  } // for
+
+  index = 0;
+  for (auto & shared : index_coloring.shared) {
+    ASSERT_EQ(sum.shared(index++), shared.id + cycle + ghost_sum);
+  } // for
+} // check_sum_task
+
+TEST(split_task, testname) {
+
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,199 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+///
+/// \file
+/// \date Initial file creation: Oct 18, 2026
+///
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <cinchlog.h>
+#include <cinchtest.h>
+
+#include <flecsi/execution/execution.h>
+#include <flecsi/supplemental/coloring/add_colorings.h>
+#include <flecsi/supplemental/mesh/empty_mesh_2d.h>
+#include <flecsi/data/dense_accessor.h>
+
+#define INDEX_ID 0
+#define VERSIONS 1
+
+using namespace flecsi;
+using namespace supplemental;
+
+clog_register_tag(task_dependencies);
+
+using namespace flecsi;
+using namespace topology;
+
+template<typename T>
+using future_t = flecsi::execution::flecsi_future<T,
+    flecsi::execution::launch_type_t::single>;
+
+flecsi_register_data_client(empty_mesh_t, meshes, mesh1);
+
+// The tasks are executed on the worker threads of each rank, rather than
+// on the thread of the driver.
+const size_t task_threads = 2;
+std::thread::id driver_thread;
+std::atomic<size_t> worker_calls(0);
+
+// Write a value to all of the owned indices. The delay gives readers and
+// writers that do not wait for this task the chance to race with it.
+void fill_task(
+        dense_accessor<double, flecsi::wo, flecsi::wo, flecsi::ro> a,
+        double value) {
+  if(std::this_thread::get_id() != driver_thread) {
+    ++worker_calls;
+  } // if
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  for (size_t i = 0; i < a.exclusive_size(); ++i) {
+    a.exclusive(i) = value;
+  } // for
+
+  for (size_t i = 0; i < a.shared_size(); ++i) {
+    a.shared(i) = value;
+  } // for
+} // fill_task
+
+flecsi_register_task_simple(fill_task, loc, single|leaf);
+
+// Copy the owned indices of a to b, adding one. All of the indices of a,
+// including the ghosts, must hold the given value.
+void copy_task(
+        dense_accessor<double, flecsi::ro, flecsi::ro, flecsi::ro> a,
+        dense_accessor<double, flecsi::wo, flecsi::wo, flecsi::ro> b,
+        double value) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  for (size_t i = 0; i < a.size(); ++i) {
+    ASSERT_EQ(a(i), value);
+  } // for
+
+  for (size_t i = 0; i < a.exclusive_size(); ++i) {
+    b.exclusive(i) = a.exclusive(i) + 1.0;
+  } // for
+
+  for (size_t i = 0; i < a.shared_size(); ++i) {
+    b.shared(i) = a.shared(i) + 1.0;
+  } // for
+} // copy_task
+
+flecsi_register_task_simple(copy_task, loc, single|leaf);
+
+// Return the maximum deviation of the owned and ghost indices from value.
+double deviation_task(
+        dense_accessor<double, flecsi::ro, flecsi::ro, flecsi::ro> a,
+        double value) {
+  double deviation = 0.0;
+
+  for (size_t i = 0; i < a.size(); ++i) {
+    deviation = std::max(deviation, std::abs(a(i) - value));
+  } // for
+
+  return deviation;
+} // deviation_task
+
+flecsi_register_task_simple(deviation_task, loc, single|leaf);
+
+// Tasks that take a future wait for the task that produces it.
+void check_future_task(future_t<double> deviation) {
+  ASSERT_EQ(deviation, 0.0);
+} // check_future_task
+
+flecsi_register_task_simple(check_future_task, loc, single);
+
+flecsi_register_field(empty_mesh_t, name_space, a, double, dense,
+    VERSIONS, INDEX_ID);
+flecsi_register_field(empty_mesh_t, name_space, b, double, dense,
+    VERSIONS, INDEX_ID);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  clog(trace) << "In specialization top-level-task init" << std::endl;
+
+  coloring_map_t map;
+  map.vertices = 1;
+  map.cells = 0;
+
+  flecsi_execute_mpi_task(add_colorings, flecsi::execution, map);
+
+} // specialization_tlt_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto & context = context_t::instance();
+
+  context.start_task_threads(task_threads);
+  driver_thread = std::this_thread::get_id();
+
+  auto ch = flecsi_get_client_handle(empty_mesh_t, meshes, mesh1);
+
+  auto a_handle = flecsi_get_handle(ch, name_space, a, double, dense,
+      INDEX_ID);
+  auto b_handle = flecsi_get_handle(ch, name_space, b, double, dense,
+      INDEX_ID);
+
+  for(size_t cycle=0; cycle<3; cycle++) {
+    const double value = double(cycle);
+
+    // Read after write on a.
+    flecsi_execute_task_simple(fill_task, single, a_handle, value);
+    flecsi_execute_task_simple(copy_task, single, a_handle, b_handle,
+      value);
+
+    // Write after read on a.
+    flecsi_execute_task_simple(fill_task, single, a_handle, value + 10.0);
+
+    auto fb = flecsi_execute_task_simple(deviation_task, single, b_handle,
+      value + 1.0);
+    auto fa = flecsi_execute_task_simple(deviation_task, single, a_handle,
+      value + 10.0);
+
+    flecsi_execute_task_simple(check_future_task, single, fb);
+
+    ASSERT_EQ(fb.get(), 0.0);
+    ASSERT_EQ(fa.get(), 0.0);
+
+    // Write after write on b.
+    flecsi_execute_task_simple(fill_task, single, b_handle, value);
+    flecsi_execute_task_simple(fill_task, single, b_handle, value + 20.0);
+
+    auto fc = flecsi_execute_task_simple(deviation_task, single, b_handle,
+      value + 20.0);
+
+    fc.wait();
+    ASSERT_EQ(fc.get(), 0.0);
+  } // for
+
+  ASSERT_GT(worker_calls.load(), 0);
+
+} // driver
+
+} // namespace execution
+} // namespace flecsi
+
+TEST(task_dependencies, testname) {
+
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,176 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+///
+/// \file
+/// \date Initial file creation: Oct 18, 2026
+///
+
+#include <atomic>
+#include <thread>
+
+#include <cinchlog.h>
+#include <cinchtest.h>
+
+#include <flecsi/execution/execution.h>
+#include <flecsi/supplemental/coloring/add_colorings.h>
+#include <flecsi/supplemental/mesh/empty_mesh_2d.h>
+#include <flecsi/data/dense_accessor.h>
+
+#define INDEX_ID 0
+#define VERSIONS 1
+
+using namespace flecsi;
+using namespace supplemental;
+
+clog_register_tag(task_graph);
+
+using namespace flecsi;
+using namespace topology;
+
+flecsi_register_data_client(empty_mesh_t, meshes, mesh1);
+
+// The replays are executed on the worker threads of each rank, rather
+// than on the thread of the driver.
+const size_t task_threads = 2;
+std::thread::id driver_thread;
+std::atomic<size_t> worker_calls(0);
+
+// Add one to all of the owned indices.
+void increment_task(
+        dense_accessor<size_t, flecsi::rw, flecsi::rw, flecsi::ro> count) {
+  if(std::this_thread::get_id() != driver_thread) {
+    ++worker_calls;
+  } // if
+
+  for (size_t i = 0; i < count.exclusive_size(); ++i) {
+    count.exclusive(i) += 1;
+  } // for
+
+  for (size_t i = 0; i < count.shared_size(); ++i) {
+    count.shared(i) += 1;
+  } // for
+} // increment_task
+
+flecsi_register_task_simple(increment_task, loc, single|leaf);
+
+// Check that all of the indices, including the ghosts, hold the same
+// value.
+void uniform_task(
+        dense_accessor<size_t, flecsi::ro, flecsi::ro, flecsi::ro> field) {
+  for (size_t i = 0; i < field.size(); ++i) {
+    ASSERT_EQ(field(i), field(0));
+  } // for
+} // uniform_task
+
+flecsi_register_task_simple(uniform_task, loc, single|leaf);
+
+// Copy the owned indices of count to copy.
+void copy_task(
+        dense_accessor<size_t, flecsi::ro, flecsi::ro, flecsi::ro> count,
+        dense_accessor<size_t, flecsi::wo, flecsi::wo, flecsi::ro> copy) {
+  for (size_t i = 0; i < copy.exclusive_size(); ++i) {
+    copy.exclusive(i) = count.exclusive(i);
+  } // for
+
+  for (size_t i = 0; i < copy.shared_size(); ++i) {
+    copy.shared(i) = count.shared(i);
+  } // for
+} // copy_task
+
+flecsi_register_task_simple(copy_task, loc, single|leaf);
+
+// Check all of the indices of a field, including the ghosts.
+void check_task(
+        dense_accessor<size_t, flecsi::ro, flecsi::ro, flecsi::ro> field,
+        size_t value) {
+  for (size_t i = 0; i < field.size(); ++i) {
+    ASSERT_EQ(field(i), value);
+  } // for
+} // check_task
+
+flecsi_register_task_simple(check_task, loc, single|leaf);
+
+flecsi_register_field(empty_mesh_t, name_space, count, size_t, dense,
+    VERSIONS, INDEX_ID);
+flecsi_register_field(empty_mesh_t, name_space, copy, size_t, dense,
+    VERSIONS, INDEX_ID);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  clog(trace) << "In specialization top-level-task init" << std::endl;
+
+  coloring_map_t map;
+  map.vertices = 1;
+  map.cells = 0;
+
+  flecsi_execute_mpi_task(add_colorings, flecsi::execution, map);
+
+} // specialization_tlt_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto & context = context_t::instance();
+
+  context.start_task_threads(task_threads);
+  driver_thread = std::this_thread::get_id();
+
+  auto ch = flecsi_get_client_handle(empty_mesh_t, meshes, mesh1);
+
+  auto count_handle = flecsi_get_handle(ch, name_space, count, size_t, dense,
+      INDEX_ID);
+  auto copy_handle = flecsi_get_handle(ch, name_space, copy, size_t, dense,
+      INDEX_ID);
+
+  // Capture one step. The tasks are executed during the capture. The
+  // ghosts of copy are read before copy is written within a step, so
+  // they are only stale in the replays.
+  context.begin_capture();
+
+  flecsi_execute_task_simple(uniform_task, single, copy_handle);
+  flecsi_execute_task_simple(increment_task, single, count_handle);
+  flecsi_execute_task_simple(uniform_task, single, count_handle);
+  flecsi_execute_task_simple(copy_task, single, count_handle, copy_handle);
+
+  auto graph = context.end_capture();
+
+  ASSERT_EQ(graph.size(), 4);
+
+  const size_t steps = 4;
+
+  for(size_t step = 0; step < steps; ++step) {
+    context.replay(graph);
+  } // for
+
+  flecsi_execute_task_simple(check_task, single, count_handle,
+    size_t(steps + 1));
+  flecsi_execute_task_simple(check_task, single, copy_handle,
+    size_t(steps + 1));
+
+  context.wait_on_tasks();
+  ASSERT_GT(worker_calls.load(), 0);
+
+} // driver
+
+} // namespace execution
+} // namespace flecsi
+
+TEST(task_graph, testname) {
+
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,255 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+///
+/// \file
+/// \date Initial file creation: Oct 18, 2026
+///
+
+#include <cinchtest.h>
+
+#include <flecsi/execution/execution.h>
+#include <flecsi/supplemental/coloring/add_colorings.h>
+#include <flecsi/data/dense_accessor.h>
+
+using namespace std;
+using namespace flecsi;
+using namespace topology;
+using namespace execution;
+using namespace coloring;
+
+clog_register_tag(task_graph_mesh);
+
+class vertex : public mesh_entity__<0, 1>{
+public:
+  template<size_t M>
+  uint64_t precedence() const { return 0; }
+  vertex() = default;
+
+};
+
+class cell : public mesh_entity__<2, 1>{
+public:
+
+  using id_t = flecsi::utils::id_t;
+
+  std::vector<size_t>
+  create_entities(id_t cell_id, size_t dim, domain_connectivity__<2> & c, id_t * e){
+    id_t* v = c.get_entities(cell_id, 0);
+
+    e[0] = v[0];
+    e[1] = v[2];
+
+    e[2] = v[1];
+    e[3] = v[3];
+
+    e[4] = v[0];
+    e[5] = v[1];
+
+    e[6] = v[2];
+    e[7] = v[3];
+
+    return {2, 2, 2, 2};
+  }
+
+}; // class cell
+
+class test_mesh_types_t{
+public:
+  static constexpr size_t num_dimensions = 2;
+
+  static constexpr size_t num_domains = 1;
+
+  using id_t = flecsi::utils::id_t;
+
+  using entity_types = std::tuple<
+    std::tuple<index_space_<0>, domain_<0>, cell>,
+    std::tuple<index_space_<1>, domain_<0>, vertex>>;
+
+  using connectivities =
+    std::tuple<std::tuple<index_space_<3>, domain_<0>, cell, vertex>>;
+
+  using bindings = std::tuple<>;
+
+  template<size_t M, size_t D, typename ST>
+  static mesh_entity_base__<num_domains>*
+  create_entity(mesh_topology_base__<ST>* mesh, size_t num_vertices,
+    id_t const & id){
+    assert(false && "invalid entity creation");
+    return nullptr;
+  }
+};
+
+struct test_mesh_t : public mesh_topology__<test_mesh_types_t> {};
+
+template<typename DC, size_t PS>
+using client_handle_t = data_client_handle__<DC, PS>;
+
+// Build the local mesh of the 8x8 test mesh and number the cells.
+void fill_task(client_handle_t<test_mesh_t, wo> mesh,
+  dense_accessor<double, rw, rw, ro> pressure) {
+  auto & context = execution::context_t::instance();
+
+  auto & vertex_map = context.index_map(1);
+  auto & reverse_vertex_map = context.reverse_index_map(1);
+  auto & cell_map = context.index_map(0);
+
+  std::vector<vertex *> vertices;
+  for(size_t i = 0; i < vertex_map.size(); ++i) {
+    vertices.push_back(mesh.make<vertex>());
+  } // for
+
+  const size_t width = 8;
+
+  for(auto & cm: cell_map) {
+    const size_t mid = cm.second;
+
+    const size_t row = mid/width;
+    const size_t column = mid%width;
+
+    const size_t v0 = (column    ) + (row    ) * (width + 1);
+    const size_t v1 = (column + 1) + (row    ) * (width + 1);
+    const size_t v2 = (column + 1) + (row + 1) * (width + 1);
+    const size_t v3 = (column    ) + (row + 1) * (width + 1);
+
+    auto c = mesh.make<cell>();
+    mesh.init_cell<0>(c, { vertices[reverse_vertex_map[v0]],
+      vertices[reverse_vertex_map[v1]], vertices[reverse_vertex_map[v2]],
+      vertices[reverse_vertex_map[v3]] });
+  } // for
+
+  mesh.init<0>();
+
+  size_t count(0);
+  for(auto c: mesh.entities<2,0>()) {
+    pressure(c) = count++;
+  } // for
+} // fill_task
+
+// Add the number of vertices of each owned cell to its pressure, which
+// needs the connectivity of the mesh.
+void accumulate_task(client_handle_t<test_mesh_t, ro> mesh,
+  dense_accessor<double, rw, rw, ro> pressure) {
+  const size_t owned = pressure.exclusive_size() + pressure.shared_size();
+
+  for(auto c: mesh.entities<2,0>()) {
+    if(c->template id<0>() < owned) {
+      pressure(c) += mesh.entities<0,0>(c).size();
+    } // if
+  } // for
+} // accumulate_task
+
+// Check the pressure of the owned cells after the given number of
+// accumulations.
+void check_task(client_handle_t<test_mesh_t, ro> mesh,
+  dense_accessor<double, ro, ro, ro> pressure, size_t steps) {
+  const size_t owned = pressure.exclusive_size() + pressure.shared_size();
+
+  size_t count(0);
+  for(auto c: mesh.entities<2,0>()) {
+    ASSERT_EQ((mesh.entities<0,0>(c).size()), 4);
+
+    if(c->template id<0>() < owned) {
+      ASSERT_EQ(pressure(c), double(count + 4 * steps));
+    } // if
+
+    ++count;
+  } // for
+} // check_task
+
+flecsi_register_data_client(test_mesh_t, meshes, mesh1);
+
+flecsi_register_field(test_mesh_t, hydro, pressure, double, dense, 1, 0);
+
+flecsi_register_task_simple(fill_task, loc, single);
+flecsi_register_task_simple(accumulate_task, loc, single);
+flecsi_register_task_simple(check_task, loc, single);
+
+namespace flecsi {
+namespace execution {
+
+//----------------------------------------------------------------------------//
+// Specialization driver.
+//----------------------------------------------------------------------------//
+
+void specialization_tlt_init(int argc, char ** argv) {
+  coloring_map_t map;
+  map.vertices = 1;
+  map.cells = 0;
+  flecsi_execute_mpi_task(add_colorings, flecsi::execution, map);
+
+  auto& context = execution::context_t::instance();
+
+  auto& cc = context.coloring_info(0);
+
+  adjacency_info_t ai;
+  ai.index_space = 3;
+  ai.from_index_space = 0;
+  ai.to_index_space = 1;
+  ai.color_sizes.resize(cc.size());
+
+  for(auto& itr : cc){
+    size_t color = itr.first;
+    const coloring_info_t& ci = itr.second;
+    ai.color_sizes[color] = (ci.exclusive + ci.shared + ci.ghost) * 4;
+  }
+
+  context.add_adjacency(ai);
+} // specialization_tlt_init
+
+void specialization_spmd_init(int argc, char ** argv) {
+  auto ch = flecsi_get_client_handle(test_mesh_t, meshes, mesh1);
+  auto ph = flecsi_get_handle(ch, hydro, pressure, double, dense, 0);
+
+  auto f = flecsi_execute_task_simple(fill_task, single, ch, ph);
+  f.wait();
+} // specialization_spmd_init
+
+//----------------------------------------------------------------------------//
+// User driver.
+//----------------------------------------------------------------------------//
+
+void driver(int argc, char ** argv) {
+  auto & context = context_t::instance();
+
+  auto ch = flecsi_get_client_handle(test_mesh_t, meshes, mesh1);
+  auto ph = flecsi_get_handle(ch, hydro, pressure, double, dense, 0);
+
+  // The mesh storage is set up by the prolog of each launch, so a replay
+  // has to set it up again.
+  context.begin_capture();
+
+  flecsi_execute_task_simple(accumulate_task, single, ch, ph);
+
+  auto graph = context.end_capture();
+
+  ASSERT_EQ(graph.size(), 1);
+
+  const size_t steps = 4;
+
+  for(size_t step = 0; step < steps; ++step) {
+    context.replay(graph);
+  } // for
+
+  auto f = flecsi_execute_task_simple(check_task, single, ch, ph,
+    size_t(steps + 1));
+  f.wait();
+} // driver
+
+//----------------------------------------------------------------------------//
+// TEST.
+//----------------------------------------------------------------------------//
+
+TEST(task_graph_mesh, testname) {
+
+} // TEST
+
+} // namespace execution
+} // namespace flecsi
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -15,6 +15,12 @@
 
 /*! @file */
 
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include <flecsi/coloring/crs.h>
+#include <flecsi/concurrency/kernel_pool.h>
 #include <flecsi/topology/mesh_definition.h>
 #include <flecsi/utils/logging.h>
 #include <flecsi/utils/set_utils.h>
@@ -23,6 +29,207 @@
 namespace flecsi {
 namespace topology {
 
+///
+/// Return the entities of to_dim that define each entity of from_dim,
+/// e.g., the vertices of each cell, in compressed-row storage.
+///
+/// \param md The mesh definition containing the topological connectivity
+///           information.
+/// \param from_dim The topological dimension of the rows.
+/// \param to_dim The topological dimension of the indices.
+///
+template<size_t D>
+coloring::crs_t
+entity_definitions(
+    const mesh_definition__<D> & md,
+    size_t from_dim,
+    size_t to_dim) {
+  const size_t num_entities = md.num_entities(from_dim);
+
+  coloring::crs_t crs;
+  crs.offsets.reserve(num_entities + 1);
+  crs.offsets.push_back(0);
+
+  for (size_t e(0); e < num_entities; ++e) {
+    const auto & definition = md.entities(from_dim, to_dim, e);
+    crs.indices.insert(
+        crs.indices.end(), definition.begin(), definition.end());
+    crs.offsets.push_back(crs.indices.size());
+  } // for
+
+  return crs;
+} // entity_definitions
+
+///
+/// Return the transpose of a connectivity, e.g., the cells that reference
+/// each vertex from the vertices of each cell. The rows of the transpose
+/// are sorted.
+///
+/// \param crs The connectivity.
+/// \param num_columns The number of entities referenced by crs, i.e., the
+///                    number of rows of the transpose.
+///
+inline coloring::crs_t
+transpose(const coloring::crs_t & crs, size_t num_columns) {
+  coloring::crs_t result;
+  result.offsets.assign(num_columns + 1, 0);
+  result.indices.resize(crs.indices.size());
+
+  for (auto i : crs.indices) {
+    ++result.offsets[i + 1];
+  } // for
+
+  for (size_t i(0); i < num_columns; ++i) {
+    result.offsets[i + 1] += result.offsets[i];
+  } // for
+
+  std::vector<size_t> position(
+      result.offsets.begin(), result.offsets.end() - 1);
+
+  for (size_t r(0); r < crs.size(); ++r) {
+    for (size_t k(crs.offsets[r]); k < crs.offsets[r + 1]; ++k) {
+      result.indices[position[crs.indices[k]]++] = r;
+    } // for
+  } // for
+
+  return result;
+} // transpose
+
+namespace detail {
+
+///
+/// Merge the entities found by each thread into one sorted vector
+/// without duplicates.
+///
+inline std::vector<size_t>
+merge_unique(std::vector<std::vector<size_t>> & parts) {
+  size_t size(0);
+
+  for (auto & p : parts) {
+    size += p.size();
+  } // for
+
+  std::vector<size_t> result;
+  result.reserve(size);
+
+  for (auto & p : parts) {
+    result.insert(result.end(), p.begin(), p.end());
+  } // for
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+
+  return result;
+} // merge_unique
+
+} // namespace detail
+
+///
+/// Return the dependency closure of the given entities from their
+/// connectivity in compressed-row storage: the entities themselves and
+/// those that share more than thru_dim vertices with one of them. This
+/// does not build any per-call maps, so that it can be applied many times
+/// to the same connectivity, e.g., once per ghost layer.
+///
+/// \param entity_vertices The vertices of each entity, see
+///                        entity_definitions.
+/// \param vertex_entities The entities that reference each vertex, see
+///                        transpose.
+/// \param indices The entity indices of the initial set.
+/// \param thru_dim The topological dimension through which the neighbor
+///                 connection exists.
+/// \param pool An optional pool whose threads split the initial set.
+///
+/// \return The closure as a sorted vector.
+///
+inline std::vector<size_t>
+entity_neighbors(
+    const coloring::crs_t & entity_vertices,
+    const coloring::crs_t & vertex_entities,
+    const std::vector<size_t> & indices,
+    size_t thru_dim,
+    kernel_pool * pool = nullptr) {
+  std::vector<std::vector<size_t>> parts(pool ? pool->num_threads() : 1);
+
+  for_each_chunk(
+      pool, indices.size(), [&](size_t begin, size_t end, size_t thread) {
+        auto & part = parts[thread];
+        std::vector<size_t> candidates;
+
+        for (size_t k(begin); k < end; ++k) {
+          const size_t i = indices[k];
+          part.push_back(i);
+
+          // Every entity appears once for each vertex that it shares
+          // with i, so that the length of its run after sorting is the
+          // number of shared vertices.
+          candidates.clear();
+
+          for (size_t v(entity_vertices.offsets[i]);
+               v < entity_vertices.offsets[i + 1]; ++v) {
+            const size_t vertex = entity_vertices.indices[v];
+
+            for (size_t n(vertex_entities.offsets[vertex]);
+                 n < vertex_entities.offsets[vertex + 1]; ++n) {
+              if (vertex_entities.indices[n] != i) {
+                candidates.push_back(vertex_entities.indices[n]);
+              } // if
+            } // for
+          } // for
+
+          std::sort(candidates.begin(), candidates.end());
+
+          for (size_t c(0); c < candidates.size();) {
+            size_t run(c + 1);
+
+            while (run < candidates.size() && candidates[run] == candidates[c])
+              ++run;
+
+            if (run - c > thru_dim) {
+              part.push_back(candidates[c]);
+            } // if
+
+            c = run;
+          } // for
+        } // for
+      });
+
+  return detail::merge_unique(parts);
+} // entity_neighbors
+
+///
+/// Return the union of the entities that define at least one of the
+/// given entities, e.g., the vertices of a set of cells, from their
+/// connectivity in compressed-row storage.
+///
+/// \param definitions The connectivity, see entity_definitions.
+/// \param indices The entity indices.
+/// \param pool An optional pool whose threads split the indices.
+///
+/// \return The closure as a sorted vector.
+///
+inline std::vector<size_t>
+entity_closure(
+    const coloring::crs_t & definitions,
+    const std::vector<size_t> & indices,
+    kernel_pool * pool = nullptr) {
+  std::vector<std::vector<size_t>> parts(pool ? pool->num_threads() : 1);
+
+  for_each_chunk(
+      pool, indices.size(), [&](size_t begin, size_t end, size_t thread) {
+        auto & part = parts[thread];
+
+        for (size_t k(begin); k < end; ++k) {
+          const size_t i = indices[k];
+          part.insert(part.end(),
+              definitions.indices.begin() + definitions.offsets[i],
+              definitions.indices.begin() + definitions.offsets[i + 1]);
+        } // for
+      });
+
+  return detail::merge_unique(parts);
+} // entity_closure
+
 ///
 /// Find the neighbors of the given entity id.
 ///
@@ -96,52 +303,15 @@ std::set<size_t>
 entity_neighbors(const mesh_definition__<D> & md, U && indices) {
   clog_assert(from_dim == to_dim, "from_dim does not equal to to_dim");
 
-  // Closure should include the initial set
-  std::set<size_t> closure(
-      std::forward<U>(indices).begin(), std::forward<U>(indices).end());
-
-  using entityid = size_t;
-  using vertexid = size_t;
-
-  // essentially vertex to cell and cell to cell through vertices
-  // connectivity.
-  std::map<vertexid, std::vector<entityid>> vertex2entities;
-  std::map<entityid, std::vector<entityid>> entity_neighbors;
-
-  // build global entity to entity through # of shared vertices connectivity
-  for (size_t cell(0); cell < md.num_entities(from_dim); ++cell) {
-    std::map<entityid, size_t> cell_counts;
-    for (auto vertex : md.entities(from_dim, 0, cell)) {
-      // build vertex to cell connectivity, O(n_cells * n_polygon_sides)
-      // of insert().
-      vertex2entities[vertex].push_back(cell);
-
-      // Count the number of times this cell shares a common vertex with
-      // some other cell. O(n_cells * n_polygon_sides * vertex to cells degrees)
-      for (auto other : vertex2entities[vertex]) {
-        // for (auto other : md.entities(0, from_dim, vertex)) {
-        if (other != cell)
-          cell_counts[other] += 1;
-      }
-    }
-
-    for (auto count : cell_counts) {
-      if (count.second > thru_dim) {
-        // append cell to cell through "dimension" connectivity, we need to
-        // add both directions
-        entity_neighbors[cell].push_back(count.first);
-        entity_neighbors[count.first].push_back(cell);
-      }
-    }
-  }
-
-  for (auto i : indices) {
-    for (auto n : entity_neighbors[i]) {
-      closure.insert(n);
-    }
-  }
+  auto entity_vertices = entity_definitions(md, from_dim, 0);
+  auto vertex_entities = transpose(entity_vertices, md.num_entities(0));
 
-  return closure;
+  auto closure = entity_neighbors(entity_vertices, vertex_entities,
+      std::vector<size_t>(std::forward<U>(indices).begin(),
+          std::forward<U>(indices).end()),
+      thru_dim);
+
+  return std::set<size_t>(closure.begin(), closure.end());
 } // entity_closure
 
 ///
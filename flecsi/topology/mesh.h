@@ -101,6 +101,27 @@
       flecsi::topology::index_space_<index>,                                   \
       flecsi::topology::domain_<domain>, from_type, to_type>
 
+//----------------------------------------------------------------------------//
+//! @def flecsi_fixed_connectivity
+//!
+//! This macro defines a connectivity type suitable for populating the
+//! \em connectivities parameter for a FleCSI specialization, for which
+//! every from entity has the same number of to entities, e.g., the
+//! vertices of the cells of an all-quadrilateral mesh. The entities of
+//! an entity are then located without reading the connectivity offsets,
+//! and are iterated with a compile-time size.
+//!
+//! @ingroup topology
+//----------------------------------------------------------------------------//
+
+#define flecsi_fixed_connectivity(index, domain, from_type, to_type, arity)    \
+  /* MACRO IMPLEMENTATION */                                                   \
+                                                                               \
+  std::tuple<                                                                  \
+      flecsi::topology::index_space_<index>,                                   \
+      flecsi::topology::domain_<domain>, from_type, to_type,                   \
+      flecsi::topology::arity_<arity>>
+
 //----------------------------------------------------------------------------//
 //! @def flecsi_register_bindings
 //!
@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstring>
@@ -24,10 +25,12 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+#include <flecsi/concurrency/kernel_pool.h>
 #include <flecsi/execution/context.h>
 #include <flecsi/topology/mesh_storage.h>
 #include <flecsi/topology/mesh_types.h>
@@ -326,15 +329,33 @@ public:
   //! and bindings for a given domain.
   //!
   //! @tparam DOM domain
+  //!
+  //! @param pool The threads that compute the adjacencies, e.g.,
+  //!             &execution::kernel_threads(), or null to compute them on
+  //!             the calling thread. The adjacencies do not depend on the
+  //!             number of threads. The edges and faces are always built
+  //!             on the calling thread, since their ids depend on the
+  //!             order in which they are created.
+  //!
+  //! If the mesh policy enables compact_connectivity, the connectivities
+  //! are compacted to 32-bit local ids once they are computed.
   //------------------------------------------------------------------------//
   template<size_t DOM = 0>
-  void init() {
+  void init(kernel_pool * pool = nullptr) {
+    pool_ = pool;
+
     // Compute mesh connectivity
     using TP = typename MESH_TYPE::connectivities;
     compute_connectivity__<DOM, std::tuple_size<TP>::value, TP>::compute(*this);
 
     using BT = typename MESH_TYPE::bindings;
     compute_bindings__<DOM, std::tuple_size<BT>::value, BT>::compute(*this);
+
+    pool_ = nullptr;
+
+    if (compact_t::value) {
+      compact_connectivities_();
+    } // if
   } // init
 
   //--------------------------------------------------------------------------//
@@ -348,8 +369,53 @@ public:
   void init_bindings() {
     using BT = typename MESH_TYPE::bindings;
     compute_bindings__<DOM, std::tuple_size<BT>::value, BT>::compute(*this);
+
+    if (compact_t::value) {
+      compact_connectivities_();
+    } // if
   } // init
 
+  //--------------------------------------------------------------------------//
+  //! Similar to init(), but the adjacencies are computed on their first use,
+  //! i.e., by the first call to get_connectivity or entities that needs
+  //! them, instead of all at once. The edges and faces and the bindings are
+  //! still built here, so that the entities do not depend on the order in
+  //! which the adjacencies are used. The deferred adjacencies are computed
+  //! under a lock, so that they can be used from several threads.
+  //!
+  //! @tparam DOM domain
+  //--------------------------------------------------------------------------//
+  template<size_t DOM = 0>
+  void init_lazy() {
+    using TP = typename MESH_TYPE::connectivities;
+    defer_connectivity__<DOM, std::tuple_size<TP>::value, TP>::defer(*this);
+
+    using BT = typename MESH_TYPE::bindings;
+    compute_bindings__<DOM, std::tuple_size<BT>::value, BT>::compute(*this);
+
+    if (compact_t::value) {
+      compact_connectivities_();
+    } // if
+  } // init_lazy
+
+  //--------------------------------------------------------------------------//
+  //! Free a connectivity that was deferred by init_lazy() and is no longer
+  //! needed. It is computed again on its next use. The connectivity must not
+  //! be used by another thread while it is freed.
+  //!
+  //! @param domain domain
+  //! @param from_dim from topological dimension
+  //! @param to_dim to topological dimension
+  //--------------------------------------------------------------------------//
+  void free_connectivity(size_t domain, size_t from_dim, size_t to_dim) {
+    auto & d = deferred_[domain][from_dim][to_dim];
+    assert(d.compute && "only deferred connectivities can be freed");
+
+    std::lock_guard<std::mutex> lock(deferred_mutex_);
+    get_connectivity_(domain, domain, from_dim, to_dim).clear();
+    d.ready.store(false, std::memory_order_release);
+  } // free_connectivity
+
   //--------------------------------------------------------------------------//
   //! Return the number of entities contained in specified topological dimension
   //! and domain.
@@ -385,6 +451,11 @@ public:
       size_t to_domain,
       size_t from_dim,
       size_t to_dim) const override {
+    if (from_domain == to_domain) {
+      const_cast<mesh_topology__ *>(this)->compute_deferred_(
+          from_domain, from_dim, to_dim);
+    } // if
+
     return get_connectivity_(from_domain, to_domain, from_dim, to_dim);
   } // get_connectivity
 
@@ -397,6 +468,10 @@ public:
       size_t to_domain,
       size_t from_dim,
       size_t to_dim) override {
+    if (from_domain == to_domain) {
+      compute_deferred_(from_domain, from_dim, to_dim);
+    } // if
+
     return get_connectivity_(from_domain, to_domain, from_dim, to_dim);
   } // get_connectivity
 
@@ -408,6 +483,8 @@ public:
       size_t domain,
       size_t from_dim,
       size_t to_dim) const override {
+    const_cast<mesh_topology__ *>(this)->compute_deferred_(
+        domain, from_dim, to_dim);
     return get_connectivity_(domain, domain, from_dim, to_dim);
   } // get_connectivity
 
@@ -417,6 +494,7 @@ public:
   //--------------------------------------------------------------------------//
   connectivity_t &
   get_connectivity(size_t domain, size_t from_dim, size_t to_dim) override {
+    compute_deferred_(domain, from_dim, to_dim);
     return get_connectivity_(domain, domain, from_dim, to_dim);
   } // get_connectivity
 
@@ -570,11 +648,8 @@ public:
         get_connectivity(FROM_DOM, TO_DOM, ENT_TYPE::dimension, DIM);
     assert(!c.empty() && "empty connectivity");
 
-    using etype = entity_type<DIM, TO_DOM>;
-    using dtype = domain_entity__<TO_DOM, etype>;
-
-    return c.get_index_space().slice<dtype>(
-        c.range(e->template id<FROM_DOM>()));
+    return entities_<DIM, TO_DOM>(c, e->template id<FROM_DOM>(), compact_t(),
+        arity_t<FROM_DOM, TO_DOM, ENT_TYPE::dimension, DIM>());
   } // entities
 
   //--------------------------------------------------------------------------//
@@ -598,11 +673,8 @@ public:
         get_connectivity(FROM_DOM, TO_DOM, ENT_TYPE::dimension, DIM);
     assert(!c.empty() && "empty connectivity");
 
-    using etype = entity_type<DIM, TO_DOM>;
-    using dtype = domain_entity__<TO_DOM, etype>;
-
-    return c.get_index_space().slice<dtype>(
-        c.range(e->template id<FROM_DOM>()));
+    return entities_<DIM, TO_DOM>(c, e->template id<FROM_DOM>(), compact_t(),
+        arity_t<FROM_DOM, TO_DOM, ENT_TYPE::dimension, DIM>());
   } // entities
 
   //--------------------------------------------------------------------------//
@@ -745,7 +817,8 @@ public:
     const connectivity_t & c =
         get_connectivity(FROM_DOM, TO_DOM, ENT_TYPE::dimension, DIM);
     assert(!c.empty() && "empty connectivity");
-    return c.get_index_space().ids(c.range(e->template id<FROM_DOM>()));
+    return entity_ids_<DIM, TO_DOM>(c, e->template id<FROM_DOM>(), compact_t(),
+        arity_t<FROM_DOM, TO_DOM, ENT_TYPE::dimension, DIM>());
   } // entities
 
   //--------------------------------------------------------------------------//
@@ -1049,6 +1122,10 @@ public:
             pos += sizeof(num_offsets);
             std::memcpy(offsets_buf, buf + pos, num_offsets * sizeof(offset_t));
             pos += num_offsets * sizeof(offset_t);
+
+            if (c.compacted()) {
+              c.compact();
+            } // if
           }
         }
       }
@@ -1145,6 +1222,197 @@ private:
   template<size_t, size_t, class>
   friend struct compute_connectivity__;
 
+  template<size_t, size_t, class>
+  friend struct defer_connectivity__;
+
+  // The threads that compute the adjacencies during init.
+  kernel_pool * pool_ = nullptr;
+
+  // A connectivity that is computed on its first use, see init_lazy().
+  struct deferred_connectivity_ {
+    void (mesh_topology__::*compute)() = nullptr;
+    std::atomic<bool> ready{false};
+  }; // struct deferred_connectivity_
+
+  deferred_connectivity_ deferred_[MESH_TYPE::num_domains]
+                                  [MESH_TYPE::num_dimensions + 1]
+                                  [MESH_TYPE::num_dimensions + 1];
+
+  // Serializes the computation of the deferred connectivities.
+  std::mutex deferred_mutex_;
+
+  // Build the entities of a connectivity and defer its adjacencies.
+  template<size_t DOM, size_t FROM_DIM, size_t TO_DIM, size_t ARITY>
+  void defer_connectivity_() {
+    build_entities_<DOM, FROM_DIM, TO_DIM>();
+
+    // The connectivities that define entities are built with them.
+    if (!get_connectivity_(DOM, FROM_DIM, TO_DIM).empty()) {
+      return;
+    } // if
+
+    deferred_[DOM][FROM_DIM][TO_DIM].compute =
+        &mesh_topology__::compute_deferred_connectivity_<
+            DOM, FROM_DIM, TO_DIM, ARITY>;
+  } // defer_connectivity_
+
+  template<size_t DOM, size_t FROM_DIM, size_t TO_DIM, size_t ARITY>
+  void compute_deferred_connectivity_() {
+    compute_connectivity<DOM, FROM_DIM, TO_DIM>();
+
+    assert(get_connectivity_(DOM, FROM_DIM, TO_DIM).has_arity(ARITY) &&
+           "connectivity does not have its declared arity");
+
+    if (compact_t::value) {
+      compact_connectivities_();
+    } // if
+  } // compute_deferred_connectivity_
+
+  // Compute a deferred connectivity if it is used for the first time.
+  void compute_deferred_(size_t domain, size_t from_dim, size_t to_dim) {
+    auto & d = deferred_[domain][from_dim][to_dim];
+
+    if (!d.compute || d.ready.load(std::memory_order_acquire)) {
+      return;
+    } // if
+
+    std::lock_guard<std::mutex> lock(deferred_mutex_);
+
+    if (!d.ready.load(std::memory_order_relaxed)) {
+      (this->*d.compute)();
+      d.ready.store(true, std::memory_order_release);
+    } // if
+  } // compute_deferred_
+
+  using compact_t = std::integral_constant<
+      bool,
+      get_compact_connectivity__<MESH_TYPE>::value>;
+
+  template<size_t FROM_DOM, size_t TO_DOM, size_t FROM_DIM, size_t TO_DIM>
+  using arity_t = arity_<get_connectivity_arity__<
+      MESH_TYPE, FROM_DOM, TO_DOM, FROM_DIM, TO_DIM>::value>;
+
+  // The entities of an entity, for the computation of the connectivities.
+  // Unlike entities(), the connectivity is not computed if it is deferred,
+  // since compute_deferred_ holds its lock while the connectivities are
+  // computed. compute_connectivity computes the connectivities that are
+  // read before reading them.
+  template<size_t DIM, size_t FROM_DOM, size_t TO_DOM = FROM_DOM,
+      class ENT_TYPE>
+  auto computed_entities_(const ENT_TYPE * e) const {
+    const connectivity_t & c =
+        get_connectivity_(FROM_DOM, TO_DOM, ENT_TYPE::dimension, DIM);
+    assert(!c.empty() && "empty connectivity");
+
+    return entities_<DIM, TO_DOM>(c, e->template id<FROM_DOM>(), compact_t(),
+        arity_t<FROM_DOM, TO_DOM, ENT_TYPE::dimension, DIM>());
+  } // computed_entities_
+
+  // The entity ids of an entity, see computed_entities_.
+  template<size_t DIM, size_t FROM_DOM, size_t TO_DOM = FROM_DOM,
+      class ENT_TYPE>
+  auto computed_entity_ids_(const ENT_TYPE * e) const {
+    const connectivity_t & c =
+        get_connectivity_(FROM_DOM, TO_DOM, ENT_TYPE::dimension, DIM);
+    assert(!c.empty() && "empty connectivity");
+
+    return entity_ids_<DIM, TO_DOM>(c, e->template id<FROM_DOM>(),
+        compact_t(), arity_t<FROM_DOM, TO_DOM, ENT_TYPE::dimension, DIM>());
+  } // computed_entity_ids_
+
+  template<size_t DIM, size_t TO_DOM, class COMPACT>
+  auto entities_(
+      const connectivity_t & c, size_t from_id, COMPACT, arity_<0>) const {
+    return entities_<DIM, TO_DOM>(c, from_id, COMPACT());
+  } // entities_
+
+  // The entities of a connectivity with a fixed arity.
+  template<size_t DIM, size_t TO_DOM, class COMPACT, size_t ARITY>
+  auto entities_(
+      const connectivity_t & c, size_t from_id, COMPACT, arity_<ARITY>) const {
+    using etype = entity_type<DIM, TO_DOM>;
+
+    connectivity_entity_map__<TO_DOM, etype> map;
+    map.entities =
+        static_cast<etype *>(c.get_index_space().storage()->buffer());
+
+    return c.template fixed_range<ARITY>(from_id, map);
+  } // entities_
+
+  template<size_t DIM, size_t TO_DOM, class COMPACT>
+  auto entity_ids_(
+      const connectivity_t & c, size_t from_id, COMPACT, arity_<0>) const {
+    return entity_ids_<DIM, TO_DOM>(c, from_id, COMPACT());
+  } // entity_ids_
+
+  // The entity ids of a connectivity with a fixed arity.
+  template<size_t DIM, size_t TO_DOM, class COMPACT, size_t ARITY>
+  auto entity_ids_(
+      const connectivity_t & c, size_t from_id, COMPACT, arity_<ARITY>) const {
+    connectivity_id_map_ map;
+    map.ids = base_t::ms_->index_spaces[TO_DOM][DIM].id_array();
+
+    return c.template fixed_range<ARITY>(from_id, map);
+  } // entity_ids_
+
+  template<size_t DIM, size_t TO_DOM>
+  auto entities_(const connectivity_t & c, size_t from_id, std::false_type)
+      const {
+    using etype = entity_type<DIM, TO_DOM>;
+    using dtype = domain_entity__<TO_DOM, etype>;
+
+    return c.get_index_space().slice<dtype>(c.range(from_id));
+  } // entities_
+
+  template<size_t DIM, size_t TO_DOM>
+  auto entities_(const connectivity_t & c, size_t from_id, std::true_type)
+      const {
+    using etype = entity_type<DIM, TO_DOM>;
+
+    connectivity_entity_map__<TO_DOM, etype> map;
+    map.entities =
+        static_cast<etype *>(c.get_index_space().storage()->buffer());
+
+    return c.compact_range(from_id, map);
+  } // entities_
+
+  template<size_t DIM, size_t TO_DOM>
+  auto entity_ids_(const connectivity_t & c, size_t from_id, std::false_type)
+      const {
+    return c.get_index_space().ids(c.range(from_id));
+  } // entity_ids_
+
+  template<size_t DIM, size_t TO_DOM>
+  auto entity_ids_(const connectivity_t & c, size_t from_id, std::true_type)
+      const {
+    connectivity_id_map_ map;
+    map.ids = base_t::ms_->index_spaces[TO_DOM][DIM].id_array();
+
+    return c.compact_range(from_id, map);
+  } // entity_ids_
+
+  // Compact the computed connectivities of all of the domains.
+  void compact_connectivities_() {
+    for (size_t from_domain = 0; from_domain < MESH_TYPE::num_domains;
+         ++from_domain) {
+      for (size_t to_domain = 0; to_domain < MESH_TYPE::num_domains;
+           ++to_domain) {
+        for (size_t from_dim = 0; from_dim <= MESH_TYPE::num_dimensions;
+             ++from_dim) {
+          for (size_t to_dim = 0; to_dim <= MESH_TYPE::num_dimensions;
+               ++to_dim) {
+            auto & c =
+                get_connectivity_(from_domain, to_domain, from_dim, to_dim);
+
+            if (!c.empty() && !c.compacted()) {
+              c.compact();
+            } // if
+          } // for
+        } // for
+      } // for
+    } // for
+  } // compact_connectivities_
+
   template<size_t, size_t, class>
   friend struct compute_bindings__;
 
@@ -1259,7 +1527,9 @@ private:
     // created multiple times, i.e., that they are unique.  The
     // emplace method of the map is used to only define a new entity
     // if it does not already exist in the map.
-    id_vector_map_t entity_vertices_map;
+    id_key_map__<get_max_entity_vertices__<MESH_TYPE>::value>
+        entity_vertices_map;
+    entity_vertices_map.reserve(_num_cells);
 
     // This buffer should be large enough to hold all entities
     // vertices that potentially need to be created
@@ -1341,16 +1611,10 @@ private:
         size_t m = sv[i];
 
         // Get the vertices that define this entity by getting
-        // a pointer to the vector-of-vector data and then constructing
-        // a vector of ids for only this entity.
+        // a pointer to the vector-of-vector data. The map sorts a copy
+        // of them, so that the same entity is found whatever the order
+        // in which a cell lists its vertices.
         id_t * a = &entity_vertices[pos];
-        id_vector_t ev(a, a + m);
-
-        // Sort the ids for the current entity so that they are
-        // monotonically increasing. This ensures that entities are
-        // created uniquely (using emplace_back below) because the ids
-        // will always occur in the same order for the same entity.
-        std::sort(ev.begin(), ev.end());
 
         //
         // The following set of steps use the vertices that define
@@ -1397,13 +1661,13 @@ private:
 
         id_t id = id_t::make<DimensionToBuild, Domain>(entity_id, color);
 
-        // Emplace the sorted vertices into the entity map
+        // Emplace the vertices into the entity map
         auto itr = entity_vertices_map.emplace(
-            std::move(ev), id_t::make<DimensionToBuild, Domain>(
-                               entity_id, cell_id.partition()));
+            a, m, id_t::make<DimensionToBuild, Domain>(
+                      entity_id, cell_id.partition()));
 
         // Add this id to the cell to entity connections
-        conns.push_back(itr.first->second);
+        conns.push_back(itr.first);
 
         // If the insertion took place
         if (itr.second) {
@@ -1465,29 +1729,54 @@ private:
     } // if
 
     // get the list of "to" entities
-    const auto & to_entities = entities<TO_DIM, TO_DOM>();
+    const auto to_entities = entities<TO_DIM, TO_DOM>();
+    const size_t num_from = num_entities_(FROM_DIM, FROM_DOM);
 
-    index_vector_t pos(num_entities_(FROM_DIM, FROM_DOM), 0);
+    // The connectivities of each slot are counted and then stored by
+    // several threads, so that they are stored in any order, and they are
+    // sorted at the end.
+    std::vector<std::atomic<std::uint32_t>> counts(num_from);
 
     // Count how many connectivities go into each slot
-    for (auto to_entity : to_entities) {
-      for (id_t from_id : entity_ids<FROM_DIM, TO_DOM, FROM_DOM>(to_entity)) {
-        ++pos[from_id.entity()];
-      }
-    }
+    for_each_chunk(pool_, to_entities.size(),
+        [&](size_t begin, size_t end, size_t) {
+          for (size_t i = begin; i < end; ++i) {
+            auto to_entity = to_entities[i];
+
+            for (id_t from_id :
+                computed_entity_ids_<FROM_DIM, TO_DOM, FROM_DOM>(
+                    to_entity.entity())) {
+              counts[from_id.entity()].fetch_add(
+                  1, std::memory_order_relaxed);
+            } // for
+          } // for
+        });
 
-    out_conn.resize(pos);
+    index_vector_t pos(num_from);
+
+    for (size_t i = 0; i < num_from; ++i) {
+      pos[i] = counts[i].load(std::memory_order_relaxed);
+      counts[i].store(0, std::memory_order_relaxed);
+    } // for
 
-    std::fill(pos.begin(), pos.end(), 0);
+    out_conn.resize(pos);
 
     // now do the actual transpose
-    for (auto to_entity : to_entities) {
-      for (auto from_id : entity_ids<FROM_DIM, TO_DOM, FROM_DOM>(to_entity)) {
-        auto from_lid = from_id.entity();
-        out_conn.set(
-            from_lid, to_entity->template global_id<TO_DOM>(), pos[from_lid]++);
-      }
-    }
+    for_each_chunk(pool_, to_entities.size(),
+        [&](size_t begin, size_t end, size_t) {
+          for (size_t i = begin; i < end; ++i) {
+            auto to_entity = to_entities[i];
+            const id_t to_id = to_entity->template global_id<TO_DOM>();
+
+            for (id_t from_id :
+                computed_entity_ids_<FROM_DIM, TO_DOM, FROM_DOM>(
+                    to_entity.entity())) {
+              auto from_lid = from_id.entity();
+              out_conn.set(from_lid, to_id,
+                  counts[from_lid].fetch_add(1, std::memory_order_relaxed));
+            } // for
+          } // for
+        });
 
     // now we need to sort the connecvtivity arrays:
     // .. we have to make sure the order of connectivity information apears in
@@ -1504,24 +1793,30 @@ private:
     const auto & to__cis_to_gis = context_.index_map(to_index_space);
 
     // do the final sort of the connectivity arrays
-    for (auto from_id : entity_ids<FROM_DIM, FROM_DOM>()) {
-      // get the connectivity array
-      size_t count;
-      auto conn = out_conn.get_entities(from_id.entity(), count);
-      // pack it into a list of id and global id pairs
-      std::vector<std::pair<size_t, id_t>> gids(count);
-      std::transform(conn, conn + count, gids.begin(), [&](auto id) {
-        return std::make_pair(to__cis_to_gis.at(id.entity()), id);
-      });
-      // sort via global id
-      std::sort(gids.begin(), gids.end(), [](auto a, auto b) {
-        return a.first < b.first;
-      });
-      // upack the results
-      std::transform(gids.begin(), gids.end(), conn, [](auto id_pair) {
-        return id_pair.second;
-      });
-    }
+    for_each_chunk(pool_, num_from, [&](size_t begin, size_t end, size_t) {
+      // the id and global id pairs of a connectivity array, reused by the
+      // arrays of the chunk
+      std::vector<std::pair<size_t, id_t>> gids;
+
+      for (size_t from_lid = begin; from_lid < end; ++from_lid) {
+        // get the connectivity array
+        size_t count;
+        auto conn = out_conn.get_entities(from_lid, count);
+        // pack it into a list of id and global id pairs
+        gids.resize(count);
+        std::transform(conn, conn + count, gids.begin(), [&](auto id) {
+          return std::make_pair(to__cis_to_gis.at(id.entity()), id);
+        });
+        // sort via global id
+        std::sort(gids.begin(), gids.end(), [](auto a, auto b) {
+          return a.first < b.first;
+        });
+        // upack the results
+        std::transform(gids.begin(), gids.end(), conn, [](auto id_pair) {
+          return id_pair.second;
+        });
+      } // for
+    });
   } // transpose
 
   //--------------------------------------------------------------------------//
@@ -1556,15 +1851,6 @@ private:
     auto num_from_ent = num_entities_(FROM_DIM, FROM_DOM);
     auto num_to_ent = num_entities_(TO_DIM, FROM_DOM);
 
-    // Temporary storage for connection id's
-    connection_vector_t conns(num_from_ent);
-
-    // Keep track of which to id's we have visited
-    using visited_vec = std::vector<bool>;
-    visited_vec visited(num_to_ent);
-
-    size_t max_size = 1;
-
     // Read connectivities
     connectivity_t & c = get_connectivity_(FROM_DOM, FROM_DIM, DIM);
     assert(!c.empty());
@@ -1572,80 +1858,127 @@ private:
     connectivity_t & c2 = get_connectivity_(TO_DOM, TO_DIM, DIM);
     assert(!c2.empty());
 
-    // Iterate through entities in "from" topological dimension
-    for (auto from_entity : entities<FROM_DIM, FROM_DOM>()) {
+    const auto from_entities = entities<FROM_DIM, FROM_DOM>();
 
-      id_t from_id = from_entity->template global_id<FROM_DOM>();
-      id_vector_t & ents = conns[from_id.entity()];
-      ents.reserve(max_size);
+    // The connections are found by chunks of from entities, each on one
+    // thread, and stored in the buffers of the chunk together with the
+    // from entities, in order. They are then copied to the connectivity,
+    // so that it does not depend on the number of threads.
+    struct chunk_t {
+      std::vector<size_t> from;
+      id_vector_t to;
+    }; // struct chunk_t
 
-      size_t count;
-      id_t * ep = c.get_entities(from_id.entity(), count);
+    std::vector<chunk_t> chunks(pool_ ? pool_->num_threads() : 1);
+    index_vector_t counts(num_from_ent);
 
-      // Create a copy of to vertices so they can be sorted
-      id_vector_t from_verts(ep, ep + count);
-      // sort so we have a unique key for from vertices
-      std::sort(from_verts.begin(), from_verts.end());
+    for_each_chunk(pool_, from_entities.size(),
+        [&](size_t begin, size_t end, size_t thread) {
+          auto & chunk = chunks[thread];
+          auto & ents = chunk.to;
 
-      // initially set all to id's to unvisited
-      for (auto from_ent2 : entities<DIM, FROM_DOM>(from_entity)) {
-        for (id_t to_id : entity_ids<TO_DIM, TO_DOM>(from_ent2)) {
-          visited[to_id.entity()] = false;
-        }
-      }
+          // Keep track of which to id's we have visited
+          using visited_vec = std::vector<bool>;
+          visited_vec visited(num_to_ent);
 
-      // Loop through each from entity again
-      for (auto from_ent2 : entities<DIM, FROM_DOM>(from_entity)) {
-        for (id_t to_id : entity_ids<TO_DIM, TO_DOM>(from_ent2)) {
+          id_vector_t from_verts;
+          id_vector_t to_verts;
 
-          // If we have already visited, skip
-          if (visited[to_id.entity()]) {
-            continue;
-          } // if
+          // Iterate through entities in "from" topological dimension
+          for (size_t i = begin; i < end; ++i) {
+            auto from_entity = from_entities[i];
 
-          visited[to_id.entity()] = true;
+            id_t from_id = from_entity->template global_id<FROM_DOM>();
+            const size_t start = ents.size();
 
-          // If the topological dimensions are the same, always add to id
-          if (FROM_DIM == TO_DIM) {
-            if (from_id != to_id) {
-              ents.push_back(to_id);
-            } // if
-          } else {
             size_t count;
-            id_t * ep = c2.get_entities(to_id.entity(), count);
+            id_t * ep = c.get_entities(from_id.entity(), count);
 
             // Create a copy of to vertices so they can be sorted
-            id_vector_t to_verts(ep, ep + count);
-            // Sort to verts so we can do an inclusion check
-            std::sort(to_verts.begin(), to_verts.end());
-
-            // If from vertices contains the to vertices add to id
-            // to this connection set
-            if (DIM < TO_DIM) {
-              if (std::includes(
-                      from_verts.begin(), from_verts.end(), to_verts.begin(),
-                      to_verts.end()))
-                ents.emplace_back(to_id);
+            from_verts.assign(ep, ep + count);
+            // sort so we have a unique key for from vertices
+            std::sort(from_verts.begin(), from_verts.end());
+
+            // initially set all to id's to unvisited
+            for (auto from_ent2 :
+                computed_entities_<DIM, FROM_DOM>(from_entity.entity())) {
+              for (id_t to_id :
+                  computed_entity_ids_<TO_DIM, TO_DOM>(from_ent2.entity())) {
+                visited[to_id.entity()] = false;
+              }
             }
-            // If we are going through a higher level, then set
-            // intersection is sufficient. i.e. one set does not need to
-            // be a subset of the other
-            else {
-              if (utils::intersects(
-                      from_verts.begin(), from_verts.end(), to_verts.begin(),
-                      to_verts.end()))
-                ents.emplace_back(to_id);
-            } // if
-
-          } // if
-        } // for
-      } // for
-
-      max_size = std::max(ents.size(), max_size);
-    } // for
 
-    // Finally create the connection from the temporary conns
-    out_conn.init(conns);
+            // Loop through each from entity again
+            for (auto from_ent2 :
+                computed_entities_<DIM, FROM_DOM>(from_entity.entity())) {
+              for (id_t to_id :
+                  computed_entity_ids_<TO_DIM, TO_DOM>(from_ent2.entity())) {
+
+                // If we have already visited, skip
+                if (visited[to_id.entity()]) {
+                  continue;
+                } // if
+
+                visited[to_id.entity()] = true;
+
+                // If the topological dimensions are the same, always add to
+                // id
+                if (FROM_DIM == TO_DIM) {
+                  if (from_id != to_id) {
+                    ents.push_back(to_id);
+                  } // if
+                } else {
+                  size_t count;
+                  id_t * ep = c2.get_entities(to_id.entity(), count);
+
+                  // Create a copy of to vertices so they can be sorted
+                  to_verts.assign(ep, ep + count);
+                  // Sort to verts so we can do an inclusion check
+                  std::sort(to_verts.begin(), to_verts.end());
+
+                  // If from vertices contains the to vertices add to id
+                  // to this connection set
+                  if (DIM < TO_DIM) {
+                    if (std::includes(
+                            from_verts.begin(), from_verts.end(),
+                            to_verts.begin(), to_verts.end()))
+                      ents.emplace_back(to_id);
+                  }
+                  // If we are going through a higher level, then set
+                  // intersection is sufficient. i.e. one set does not need
+                  // to be a subset of the other
+                  else {
+                    if (utils::intersects(
+                            from_verts.begin(), from_verts.end(),
+                            to_verts.begin(), to_verts.end()))
+                      ents.emplace_back(to_id);
+                  } // if
+
+                } // if
+              } // for
+            } // for
+
+            chunk.from.push_back(from_id.entity());
+            counts[from_id.entity()] = ents.size() - start;
+          } // for
+        });
+
+    // Finally create the connection from the buffers of the chunks
+    out_conn.resize(counts);
+
+    for_each_chunk(pool_, chunks.size(),
+        [&](size_t begin, size_t end, size_t) {
+          for (size_t i = begin; i < end; ++i) {
+            auto to = chunks[i].to.begin();
+
+            for (auto from_lid : chunks[i].from) {
+              size_t count;
+              id_t * ids = out_conn.get_entities(from_lid, count);
+              std::copy(to, to + count, ids);
+              to += count;
+            } // for
+          } // for
+        });
   } // intersect
 
   //--------------------------------------------------------------------------//
@@ -1668,6 +2001,42 @@ private:
       return;
     } // if
 
+    build_entities_<DOM, FROM_DIM, TO_DIM>();
+
+    if (num_entities_(FROM_DIM, DOM) == 0 && num_entities_(TO_DIM, DOM) == 0) {
+      return;
+    } // if
+
+    // Depending on the corresponding topological dimensions, call transpose
+    // or intersect as need
+    if (FROM_DIM < TO_DIM) {
+      compute_connectivity<DOM, TO_DIM, FROM_DIM>();
+      transpose<DOM, DOM, FROM_DIM, TO_DIM>();
+    } else {
+      if (FROM_DIM == 0 && TO_DIM == 0) {
+        // compute vertex to vertex connectivities through shared cells.
+        compute_connectivity<DOM, FROM_DIM, MESH_TYPE::num_dimensions>();
+        compute_connectivity<DOM, MESH_TYPE::num_dimensions, TO_DIM>();
+        intersect<DOM, DOM, FROM_DIM, TO_DIM, MESH_TYPE::num_dimensions>();
+      } else {
+        // computer connectivities through shared vertices.
+        compute_connectivity<DOM, FROM_DIM, 0>();
+        compute_connectivity<DOM, 0, TO_DIM>();
+        intersect<DOM, DOM, FROM_DIM, TO_DIM, 0>();
+      }
+    } // if
+  } // compute_connectivity
+
+  //--------------------------------------------------------------------------//
+  //! Build the entities of topological dimensions FROM_DIM and TO_DIM, e.g.,
+  //! edges or faces, if they do not exist yet.
+  //!
+  //! @tparam DOM domain
+  //! @tparam FROM_DIM from topological dimension
+  //! @tparam TO_DIM to topological dimension
+  //--------------------------------------------------------------------------//
+  template<size_t DOM, size_t FROM_DIM, size_t TO_DIM>
+  void build_entities_() {
     // if we don't have cell -> vertex connectivities, then
     // try building cell -> vertex connectivity through the
     // faces (3d) or edges(2d)
@@ -1704,30 +2073,7 @@ private:
       else
         build_connectivity<DOM, TO_DIM, TO_DIM + 1>();
     } // if
-
-    if (num_entities_(FROM_DIM, DOM) == 0 && num_entities_(TO_DIM, DOM) == 0) {
-      return;
-    } // if
-
-    // Depending on the corresponding topological dimensions, call transpose
-    // or intersect as need
-    if (FROM_DIM < TO_DIM) {
-      compute_connectivity<DOM, TO_DIM, FROM_DIM>();
-      transpose<DOM, DOM, FROM_DIM, TO_DIM>();
-    } else {
-      if (FROM_DIM == 0 && TO_DIM == 0) {
-        // compute vertex to vertex connectivities through shared cells.
-        compute_connectivity<DOM, FROM_DIM, MESH_TYPE::num_dimensions>();
-        compute_connectivity<DOM, MESH_TYPE::num_dimensions, TO_DIM>();
-        intersect<DOM, DOM, FROM_DIM, TO_DIM, MESH_TYPE::num_dimensions>();
-      } else {
-        // computer connectivities through shared vertices.
-        compute_connectivity<DOM, FROM_DIM, 0>();
-        compute_connectivity<DOM, 0, TO_DIM>();
-        intersect<DOM, DOM, FROM_DIM, TO_DIM, 0>();
-      }
-    } // if
-  } // compute_connectivity
+  } // build_entities_
 
   //--------------------------------------------------------------------------//
   //! if the to-dimension is larger than the from-dimension, build the bindings
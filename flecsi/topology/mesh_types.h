@@ -19,7 +19,9 @@
 #include <cassert>
 #include <cstdint>
 #include <iostream>
+#include <limits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <flecsi/data/data_client.h>
@@ -239,6 +241,134 @@ private:
   ENTITY_TYPE * entity_;
 };
 
+/*----------------------------------------------------------------------------*
+ * class connectivity_range__
+ *----------------------------------------------------------------------------*/
+
+//-----------------------------------------------------------------//
+//! \class connectivity_range__ mesh_types.h
+//! \brief connectivity_range__ iterates the to entities of one from
+//! entity of a connectivity. The values are produced by MAP from the
+//! 32-bit local ids of a compacted connectivity, or from the full ids
+//! if the connectivity has not been compacted.
+//!
+//! \tparam MAP The function object that maps a local id or a full id
+//!             to a value.
+//! \tparam ARITY The number of to entities if it is fixed at compile
+//!               time, so that loops over the range can be unrolled,
+//!               or 0.
+//-----------------------------------------------------------------//
+
+template<class MAP, size_t ARITY = 0>
+class connectivity_range__ {
+public:
+  using id_t = utils::id_t;
+  using value_type = decltype(std::declval<const MAP &>()(std::uint32_t(0)));
+
+  class iterator {
+  public:
+    iterator(const connectivity_range__ & range, size_t index)
+        : local_ids_(range.local_ids_), ids_(range.ids_), map_(range.map_),
+          index_(index) {}
+
+    value_type operator*() const {
+      return local_ids_ ? map_(local_ids_[index_]) : map_(ids_[index_]);
+    }
+
+    iterator & operator++() {
+      ++index_;
+      return *this;
+    }
+
+    bool operator==(const iterator & itr) const {
+      return index_ == itr.index_;
+    }
+
+    bool operator!=(const iterator & itr) const {
+      return index_ != itr.index_;
+    }
+
+  private:
+    const std::uint32_t * local_ids_;
+    const id_t * ids_;
+    MAP map_;
+    size_t index_;
+  }; // class iterator
+
+  connectivity_range__(
+      const std::uint32_t * local_ids,
+      const id_t * ids,
+      size_t size,
+      MAP map)
+      : local_ids_(local_ids), ids_(ids), size_(size), map_(map) {}
+
+  iterator begin() const {
+    return iterator(*this, 0);
+  }
+
+  iterator end() const {
+    return iterator(*this, size());
+  }
+
+  value_type operator[](size_t i) const {
+    return local_ids_ ? map_(local_ids_[i]) : map_(ids_[i]);
+  }
+
+  size_t size() const {
+    return ARITY ? ARITY : size_;
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+private:
+  const std::uint32_t * local_ids_;
+  const id_t * ids_;
+  size_t size_;
+  MAP map_;
+}; // class connectivity_range__
+
+//-----------------------------------------------------------------//
+//! Map the ids of a connectivity to the entities of its to index
+//! space.
+//-----------------------------------------------------------------//
+
+template<size_t DOM, class ENTITY_TYPE>
+struct connectivity_entity_map__ {
+  using id_t = utils::id_t;
+
+  domain_entity__<DOM, ENTITY_TYPE> operator()(std::uint32_t id) const {
+    return domain_entity__<DOM, ENTITY_TYPE>(entities + id);
+  }
+
+  domain_entity__<DOM, ENTITY_TYPE> operator()(const id_t & id) const {
+    return domain_entity__<DOM, ENTITY_TYPE>(
+        entities + id.index_space_index());
+  }
+
+  ENTITY_TYPE * entities;
+}; // struct connectivity_entity_map__
+
+//-----------------------------------------------------------------//
+//! Map the ids of a connectivity to their full ids, which are rebuilt
+//! from the ids of the to index space for the local ids.
+//-----------------------------------------------------------------//
+
+struct connectivity_id_map_ {
+  using id_t = utils::id_t;
+
+  id_t operator()(std::uint32_t id) const {
+    return ids[id];
+  }
+
+  id_t operator()(const id_t & id) const {
+    return id;
+  }
+
+  const id_t * ids;
+}; // struct connectivity_id_map_
+
 /*----------------------------------------------------------------------------*
  * class connectivity_t
  *----------------------------------------------------------------------------*/
@@ -279,8 +409,87 @@ public:
   void clear() {
     index_space_.clear();
     offsets_.clear();
+    std::vector<std::uint32_t>().swap(local_ids_);
   } // clear
 
+  //-----------------------------------------------------------------//
+  //! Store the to ids as 32-bit local ids, i.e., as the offsets of the
+  //! to entities in their index space, so that traversals read 4 bytes
+  //! per entity instead of a full id. The local ids are kept up to date
+  //! by push, set, reverse_entities and reorder_entities, and are
+  //! discarded by clear.
+  //-----------------------------------------------------------------//
+  void compact() {
+    local_ids_.resize(index_space_.size());
+    compact_(0, local_ids_.size());
+  } // compact
+
+  //-----------------------------------------------------------------//
+  //! True if the connectivity has been compacted.
+  //-----------------------------------------------------------------//
+  bool compacted() const {
+    return !local_ids_.empty();
+  } // compacted
+
+  //-----------------------------------------------------------------//
+  //! Get the local ids of a compacted connectivity, or null.
+  //-----------------------------------------------------------------//
+  const std::uint32_t * local_id_array() const {
+    return compacted() ? local_ids_.data() : nullptr;
+  } // local_id_array
+
+  //-----------------------------------------------------------------//
+  //! Get the range of the to entities of the specified from index,
+  //! whose values are produced by map from the local ids if the
+  //! connectivity has been compacted, and from the full ids otherwise.
+  //-----------------------------------------------------------------//
+  template<class MAP>
+  connectivity_range__<MAP> compact_range(size_t index, MAP map) const {
+    assert(index < offsets_.size());
+    offset_t o = offsets_[index];
+    const std::uint32_t * local_ids = local_id_array();
+    return connectivity_range__<MAP>(
+        local_ids ? local_ids + o.start() : nullptr,
+        index_space_.id_array() + o.start(), o.count(), map);
+  } // compact_range
+
+  //-----------------------------------------------------------------//
+  //! Get the range of the to entities of the specified from index of a
+  //! connectivity whose from entities all have ARITY to entities. The
+  //! range is located from the index alone, without reading the
+  //! offsets.
+  //-----------------------------------------------------------------//
+  template<size_t ARITY, class MAP>
+  connectivity_range__<MAP, ARITY>
+  fixed_range(size_t index, MAP map) const {
+    const size_t start = index * ARITY;
+    assert(start + ARITY <= index_space_.size());
+    const std::uint32_t * local_ids = local_id_array();
+    return connectivity_range__<MAP, ARITY>(
+        local_ids ? local_ids + start : nullptr,
+        index_space_.id_array() + start, ARITY, map);
+  } // fixed_range
+
+  //-----------------------------------------------------------------//
+  //! True if every from entity has arity to entities, which start at
+  //! its index times arity as fixed_range expects, or if arity is 0.
+  //-----------------------------------------------------------------//
+  bool has_arity(size_t arity) const {
+    if (arity == 0) {
+      return true;
+    } // if
+
+    for (size_t i = 0; i < offsets_.size(); ++i) {
+      offset_t o = offsets_[i];
+
+      if (o.count() != arity || o.start() != i * arity) {
+        return false;
+      } // if
+    } // for
+
+    return true;
+  } // has_arity
+
   //-----------------------------------------------------------------//
   //! Initialize the connectivity information from a given connectivity
   //! vector.
@@ -337,6 +546,11 @@ public:
   //-----------------------------------------------------------------//
   void push(id_t id) {
     index_space_.push_(id);
+
+    if (compacted()) {
+      local_ids_.push_back(0);
+      compact_(local_ids_.size() - 1, local_ids_.size());
+    } // if
   } // push
 
   //-----------------------------------------------------------------//
@@ -411,6 +625,10 @@ public:
     std::reverse(
         index_space_.index_begin_() + o.start(),
         index_space_.index_begin_() + o.end());
+
+    if (compacted()) {
+      compact_(o.start(), o.end());
+    } // if
   }
 
   //-----------------------------------------------------------------//
@@ -423,6 +641,10 @@ public:
     assert(order.size() == o.count());
     utils::reorder(
         order.begin(), order.end(), index_space_.id_array() + o.start());
+
+    if (compacted()) {
+      compact_(o.start(), o.end());
+    } // if
   }
 
   //-----------------------------------------------------------------//
@@ -436,7 +658,12 @@ public:
   //! Set a single connection.
   //-----------------------------------------------------------------//
   void set(size_t from_local_id, id_t to_id, size_t pos) {
-    index_space_(offsets_[from_local_id].start() + pos) = to_id;
+    const size_t i = offsets_[from_local_id].start() + pos;
+    index_space_(i) = to_id;
+
+    if (compacted()) {
+      compact_(i, i + 1);
+    } // if
   }
 
   //-----------------------------------------------------------------//
@@ -526,6 +753,20 @@ public:
       index_space_;
 
   offset_storage_t offsets_;
+
+private:
+  void compact_(size_t begin, size_t end) {
+    const id_t * ids = index_space_.id_array();
+
+    for (size_t i = begin; i < end; ++i) {
+      assert(
+          ids[i].entity() <= std::numeric_limits<std::uint32_t>::max() &&
+          "local id out of range");
+      local_ids_[i] = static_cast<std::uint32_t>(ids[i].entity());
+    } // for
+  } // compact_
+
+  std::vector<std::uint32_t> local_ids_;
 }; // class connectivity_t
 
 //-----------------------------------------------------------------//
@@ -15,6 +15,8 @@
 
 /*! @file */
 
+#include <cassert>
+#include <tuple>
 #include <vector>
 
 #include <flecsi/utils/common.h>
@@ -355,6 +357,82 @@ find_all_index_spaces_in_domain__() {
  * Connectivity utilities.
  *----------------------------------------------------------------------------*/
 
+//-----------------------------------------------------------------//
+//! \struct connectivity_arity__ mesh_utils.h
+//! \brief connectivity_arity__ is the number of to entities of every
+//! from entity of a connectivities tuple entry that is declared with
+//! flecsi_fixed_connectivity, and 0 for the other entries.
+//-----------------------------------------------------------------//
+template<class T, bool FIXED = (std::tuple_size<T>::value > 4)>
+struct connectivity_arity__ {
+  static constexpr size_t value = std::tuple_element<4, T>::type::value;
+};
+
+template<class T>
+struct connectivity_arity__<T, false> {
+  static constexpr size_t value = 0;
+};
+
+template<size_t INDEX, typename TUPLE, size_t DOM, size_t FROM_DIM,
+    size_t TO_DIM>
+struct find_connectivity_arity__ {
+  //--------------------------------------------------------------------------//
+  //! Find the arity of the connectivity from FROM_DIM to TO_DIM of domain
+  //! DOM in the connectivities tuple.
+  //!
+  //! @tparam INDEX The current index in tuple.
+  //! @tparam TUPLE The tuple type.
+  //--------------------------------------------------------------------------//
+
+  static constexpr size_t find() {
+    // grab current types
+    using TUPLE_ELEMENT = typename std::tuple_element<INDEX - 1, TUPLE>::type;
+    using DOMAIN_TYPE = typename std::tuple_element<1, TUPLE_ELEMENT>::type;
+    using FROM_TYPE = typename std::tuple_element<2, TUPLE_ELEMENT>::type;
+    using TO_TYPE = typename std::tuple_element<3, TUPLE_ELEMENT>::type;
+
+    // Check match for domain and dimensions and return if matched,
+    // recurse otherwise.
+    return (DOM == DOMAIN_TYPE::value && FROM_DIM == FROM_TYPE::dimension &&
+            TO_DIM == TO_TYPE::dimension)
+               ? connectivity_arity__<TUPLE_ELEMENT>::value
+               : find_connectivity_arity__<
+                     INDEX - 1, TUPLE, DOM, FROM_DIM, TO_DIM>::find();
+  } // find
+
+}; // find_connectivity_arity__
+
+//----------------------------------------------------------------------------//
+//! End recursion condition.
+//----------------------------------------------------------------------------//
+
+template<typename TUPLE, size_t DOM, size_t FROM_DIM, size_t TO_DIM>
+struct find_connectivity_arity__<0, TUPLE, DOM, FROM_DIM, TO_DIM> {
+
+  //--------------------------------------------------------------------------//
+  //! The connectivities that are not declared, e.g., the bindings, do not
+  //! have a fixed arity.
+  //--------------------------------------------------------------------------//
+
+  static constexpr size_t find() {
+    return 0;
+  } // find
+
+}; // struct find_connectivity_arity__
+
+//! The number of to entities of every from entity of a connectivity of
+//! a mesh that is declared with flecsi_fixed_connectivity, or 0.
+template<typename MESH_TYPE, size_t FROM_DOM, size_t TO_DOM, size_t FROM_DIM,
+    size_t TO_DIM>
+struct get_connectivity_arity__ {
+  using connectivities = typename MESH_TYPE::connectivities;
+
+  static constexpr size_t value = FROM_DOM == TO_DOM
+      ? find_connectivity_arity__<std::tuple_size<connectivities>::value,
+            connectivities, FROM_DOM, FROM_DIM, TO_DIM>::find()
+      : 0;
+};
+
 //-----------------------------------------------------------------//
 //! \struct compute_connectivity__ mesh_utils.h
 //! \brief compute_connectivity__ provides static recursion to process
@@ -381,6 +459,12 @@ struct compute_connectivity__ {
     if (D1::value == FIND_DOM) {
       mesh.template compute_connectivity<
           FIND_DOM, T1::dimension, T2::dimension>();
+
+      assert(
+          mesh.get_connectivity(FIND_DOM, FIND_DOM, T1::dimension,
+                  T2::dimension)
+              .has_arity(connectivity_arity__<T>::value) &&
+          "connectivity does not have its declared arity");
     }
 
     return compute_connectivity__<FIND_DOM, I - 1, TS>::compute(mesh);
@@ -408,6 +492,59 @@ struct compute_connectivity__<FIND_DOM, 0, TS> {
 
 }; // struct compute_connectivity__
 
+//-----------------------------------------------------------------//
+//! \struct defer_connectivity__ mesh_utils.h
+//! \brief defer_connectivity__ provides static recursion to defer the
+//! connectivity computation of mesh entity types to their first use.
+//-----------------------------------------------------------------//
+template<size_t FIND_DOM, size_t I, class TS>
+struct defer_connectivity__ {
+  //-----------------------------------------------------------------//
+  //! Defer mesh connectivity for the given domain and tuple element.
+  //!
+  //!  @tparam FIND_DOM The domain to match.
+  //!  @tparam I The current tuple index.
+  //!  @tparam TS The tuple typel
+  //-----------------------------------------------------------------//
+  template<class DOM>
+  static int defer(DOM & mesh) {
+    static constexpr size_t size = std::tuple_size<TS>::value;
+
+    using T = typename std::tuple_element<size - I, TS>::type;
+    using D1 = typename std::tuple_element<1, T>::type;
+    using T1 = typename std::tuple_element<2, T>::type;
+    using T2 = typename std::tuple_element<3, T>::type;
+
+    if (D1::value == FIND_DOM) {
+      mesh.template defer_connectivity_<FIND_DOM, T1::dimension,
+          T2::dimension, connectivity_arity__<T>::value>();
+    }
+
+    return defer_connectivity__<FIND_DOM, I - 1, TS>::defer(mesh);
+  } // defer
+
+}; // struct defer_connectivity__
+
+//-----------------------------------------------------------------//
+//! \struct defer_connectivity__ mesh_utils.h
+//!  \brief defer_connectivity__ provides a specialization for
+//!  the root recursion.
+//-----------------------------------------------------------------//
+template<size_t FIND_DOM, class TS>
+struct defer_connectivity__<FIND_DOM, 0, TS> {
+  //-----------------------------------------------------------------//
+  //! Terminate recursion.
+  //!
+  //!  @tparam FIND_DOM The domain to match.
+  //!  @tparam TS The tuple typel
+  //-----------------------------------------------------------------//
+  template<class DOM>
+  static int defer(DOM &) {
+    return 0;
+  } // defer
+
+}; // struct defer_connectivity__
+
 /*----------------------------------------------------------------------------*
  * Binding utilities.
  *----------------------------------------------------------------------------*/
@@ -506,5 +643,55 @@ struct num_index_subspaces__ {
   static constexpr size_t value = std::tuple_size<type>::value;
 };
 
+FLECSI_MEMBER_CHECKER(max_entity_vertices);
+
+template<typename MESH_TYPE, bool HAS_MAX_ENTITY_VERTICES>
+struct max_entity_vertices__ {
+  static constexpr size_t value = MESH_TYPE::max_entity_vertices;
+};
+
+template<typename MESH_TYPE>
+struct max_entity_vertices__<MESH_TYPE, false> {
+  static constexpr size_t value = 4;
+};
+
+//! The maximum number of vertices of the entities that are created by
+//! the cells of a mesh, which sizes the keys of the map that is used to
+//! create them uniquely. A mesh policy may define it with a static
+//! member max_entity_vertices; otherwise it is 4, e.g., for the edges
+//! and the quadrilateral faces. The entities with more vertices are
+//! still created, but more slowly.
+template<typename MESH_TYPE>
+struct get_max_entity_vertices__ {
+  static constexpr size_t value = max_entity_vertices__<
+      MESH_TYPE,
+      has_member_max_entity_vertices<MESH_TYPE>::value>::value;
+};
+
+FLECSI_MEMBER_CHECKER(compact_connectivity);
+
+template<typename MESH_TYPE, bool HAS_COMPACT_CONNECTIVITY>
+struct compact_connectivity__ {
+  static constexpr bool value = MESH_TYPE::compact_connectivity;
+};
+
+template<typename MESH_TYPE>
+struct compact_connectivity__<MESH_TYPE, false> {
+  static constexpr bool value = false;
+};
+
+//! True if the connectivities of a mesh are compacted to 32-bit local
+//! ids once they are computed, so that the traversals of the entities
+//! of an entity read 4 bytes per entity instead of a full id. The full
+//! ids are kept alongside, so the memory of the connectivities grows by
+//! 4 bytes per connection. A mesh policy may enable it with a static
+//! member compact_connectivity.
+template<typename MESH_TYPE>
+struct get_compact_connectivity__ {
+  static constexpr bool value = compact_connectivity__<
+      MESH_TYPE,
+      has_member_compact_connectivity<MESH_TYPE>::value>::value;
+};
+
 } // namespace topology
 } // namespace flecsi
@@ -183,6 +183,72 @@ TEST(closure, vertex_closure) {
 
 } // TEST
 
+// This test checks that the transpose of the cell to vertex connectivity
+// gives the cells that reference each vertex in a 4x4 mesh.
+TEST(closure, csr_referencers) {
+
+  flecsi::topology::test_definition_t td;
+
+  auto cell_vertices = flecsi::topology::entity_definitions(td, 2, 0);
+  auto vertex_cells =
+    flecsi::topology::transpose(cell_vertices, td.num_entities(0));
+
+  CINCH_ASSERT(EQ, td.num_entities(2), cell_vertices.size());
+  CINCH_ASSERT(EQ, td.num_entities(0), vertex_cells.size());
+
+  for (size_t v(0); v < td.num_entities(0); ++v) {
+    std::set<size_t> referencers(
+      vertex_cells.indices.begin() + vertex_cells.offsets[v],
+      vertex_cells.indices.begin() + vertex_cells.offsets[v + 1]);
+    CINCH_ASSERT(EQ, (flecsi::topology::entity_referencers<2, 0>(td, v)),
+      referencers);
+  } // for
+
+} // TEST
+
+// This test checks that the closures computed from the compressed-row
+// connectivity match those of the mesh definition, with and without
+// threads.
+TEST(closure, csr_closure) {
+
+  flecsi::topology::test_definition_t td;
+  flecsi::kernel_pool pool(4);
+
+  auto cell_vertices = flecsi::topology::entity_definitions(td, 2, 0);
+  auto vertex_cells =
+    flecsi::topology::transpose(cell_vertices, td.num_entities(0));
+
+  using vector_t = std::vector<size_t>;
+
+  for (size_t id(0); id < td.num_entities(2); ++id) {
+    auto thru_vertices = flecsi::topology::entity_neighbors<2, 2, 0>(td, id);
+    thru_vertices.insert(id);
+    auto thru_edges = flecsi::topology::entity_neighbors<2, 2, 1>(td, id);
+    thru_edges.insert(id);
+
+    CINCH_ASSERT(EQ, vector_t(thru_vertices.begin(), thru_vertices.end()),
+      flecsi::topology::entity_neighbors(
+        cell_vertices, vertex_cells, {id}, 0));
+    CINCH_ASSERT(EQ, vector_t(thru_edges.begin(), thru_edges.end()),
+      flecsi::topology::entity_neighbors(
+        cell_vertices, vertex_cells, {id}, 1));
+  } // for
+
+  vector_t primary = {0, 1, 4, 5, 15};
+
+  for (auto p : {(flecsi::kernel_pool *)nullptr, &pool}) {
+    CINCH_ASSERT(EQ, vector_t({0, 1, 2, 4, 5, 6, 8, 9, 10, 11, 14, 15}),
+      flecsi::topology::entity_neighbors(
+        cell_vertices, vertex_cells, primary, 0, p));
+    CINCH_ASSERT(EQ, vector_t({0, 1, 2, 4, 5, 6, 8, 9, 11, 14, 15}),
+      flecsi::topology::entity_neighbors(
+        cell_vertices, vertex_cells, primary, 1, p));
+    CINCH_ASSERT(EQ, vector_t({0, 1, 2, 5, 6, 7, 10, 11, 12, 18, 19, 23, 24}),
+      flecsi::topology::entity_closure(cell_vertices, primary, p));
+  } // for
+
+} // TEST
+
 /*----------------------------------------------------------------------------*
  * Cinch test Macros
  *
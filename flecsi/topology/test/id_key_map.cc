@@ -0,0 +1,104 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+
+#include <flecsi/topology/types.h>
+
+using flecsi::topology::id_key_map__;
+using flecsi::topology::id_vector_t;
+using entity_id_t = flecsi::utils::id_t;
+
+// The ids of a set of vertices.
+id_vector_t
+vertices(std::initializer_list<size_t> entities) {
+  id_vector_t ids;
+
+  for (auto e : entities) {
+    ids.push_back(entity_id_t::make<0, 0>(e));
+  } // for
+
+  return ids;
+} // vertices
+
+TEST(id_key_map, unique) {
+  id_key_map__<4> map;
+
+  auto face = vertices({3, 1, 7, 5});
+  auto a = map.emplace(face.data(), face.size(), entity_id_t::make<2, 0>(0));
+  ASSERT_TRUE(a.second);
+  ASSERT_EQ(a.first.entity(), 0);
+
+  // The same vertices in another order are the same entity.
+  auto reversed = vertices({5, 7, 1, 3});
+  auto b = map.emplace(
+      reversed.data(), reversed.size(), entity_id_t::make<2, 0>(1));
+  ASSERT_FALSE(b.second);
+  ASSERT_EQ(b.first.entity(), 0);
+
+  // A subset of the vertices is another entity.
+  auto edge = vertices({1, 3});
+  auto c = map.emplace(edge.data(), edge.size(), entity_id_t::make<2, 0>(1));
+  ASSERT_TRUE(c.second);
+  ASSERT_EQ(c.first.entity(), 1);
+
+  // The keys that do not fit inline are stored separately.
+  auto polygon = vertices({9, 2, 4, 6, 8});
+  auto d = map.emplace(
+      polygon.data(), polygon.size(), entity_id_t::make<2, 0>(2));
+  ASSERT_TRUE(d.second);
+  std::reverse(polygon.begin(), polygon.end());
+  auto e = map.emplace(
+      polygon.data(), polygon.size(), entity_id_t::make<2, 0>(3));
+  ASSERT_FALSE(e.second);
+  ASSERT_EQ(e.first.entity(), 2);
+
+  ASSERT_EQ(map.size(), 3);
+} // TEST
+
+TEST(id_key_map, grid) {
+  id_key_map__<2> map;
+  map.reserve(10);
+
+  // The edges of a grid of n x n quadrilaterals, inserted once per cell
+  // that references them, so that the table is grown several times.
+  const size_t n = 64;
+  size_t count(0);
+
+  for (size_t j(0); j < n; ++j) {
+    for (size_t i(0); i < n; ++i) {
+      const size_t v = j * (n + 1) + i;
+      const size_t corners[] = {v, v + 1, v + n + 2, v + n + 1};
+
+      for (size_t k(0); k < 4; ++k) {
+        auto edge = vertices({corners[k], corners[(k + 1) % 4]});
+        auto r = map.emplace(edge.data(), 2, entity_id_t::make<1, 0>(count));
+
+        if (r.second) {
+          ++count;
+        } // if
+      } // for
+    } // for
+  } // for
+
+  ASSERT_EQ(count, 2 * n * (n + 1));
+  ASSERT_EQ(map.size(), count);
+
+  // Every edge is found with its id.
+  for (size_t j(0); j <= n; ++j) {
+    for (size_t i(0); i < n; ++i) {
+      const size_t v = j * (n + 1) + i;
+      auto edge = vertices({v + 1, v});
+      auto r = map.emplace(edge.data(), 2, entity_id_t::make<1, 0>(count));
+      ASSERT_FALSE(r.second);
+      ASSERT_LT(r.first.entity(), count);
+    } // for
+  } // for
+} // TEST
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -0,0 +1,444 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2014 Los Alamos National Security, LLC
+ * All rights reserved.
+ *~-------------------------------------------------------------------------~~*/
+
+#include <cinchtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <flecsi/concurrency/kernel_pool.h>
+#include <flecsi/execution/execution.h>
+#include <flecsi/supplemental/mesh/test_mesh_2d.h>
+
+using namespace flecsi;
+using namespace flecsi::topology;
+
+using flecsi::supplemental::cell_t;
+using flecsi::supplemental::edge_t;
+using flecsi::supplemental::vertex_t;
+
+// The test mesh has N x N cells.
+const size_t N = 16;
+const size_t num_vertices = (N + 1) * (N + 1);
+const size_t num_edges = 2 * N * (N + 1);
+const size_t num_cells = N * N;
+
+// All of the adjacencies between vertices, edges and cells, which are
+// optionally compacted to 32-bit local ids. The vertices and edges of
+// the cells and the vertices of the edges optionally have a fixed arity.
+template<bool COMPACT, bool FIXED = false>
+struct policy__ {
+  static constexpr bool compact_connectivity = COMPACT;
+
+  flecsi_register_number_dimensions(2);
+  flecsi_register_number_domains(1);
+
+  flecsi_register_entity_types(
+    flecsi_entity_type(0, 0, vertex_t),
+    flecsi_entity_type(1, 0, edge_t),
+    flecsi_entity_type(2, 0, cell_t));
+
+  flecsi_register_connectivities(
+    flecsi_fixed_connectivity(3, 0, cell_t, vertex_t, FIXED ? 4 : 0),
+    flecsi_connectivity(4, 0, vertex_t, cell_t),
+    flecsi_connectivity(5, 0, cell_t, cell_t),
+    flecsi_connectivity(6, 0, vertex_t, vertex_t),
+    flecsi_fixed_connectivity(7, 0, cell_t, edge_t, FIXED ? 4 : 0),
+    flecsi_fixed_connectivity(8, 0, edge_t, vertex_t, FIXED ? 2 : 0),
+    flecsi_connectivity(9, 0, vertex_t, edge_t),
+    flecsi_connectivity(10, 0, edge_t, cell_t),
+    flecsi_connectivity(11, 0, edge_t, edge_t));
+
+  flecsi_register_bindings();
+
+  template<size_t M, size_t D, typename ST>
+  static mesh_entity_base__<num_domains> *
+  create_entity(mesh_topology_base__<ST> * mesh, size_t num_vertices,
+    utils::id_t const & id) {
+    return mesh->template make<edge_t>(id);
+  } // create_entity
+}; // struct policy__
+
+using mesh_t = mesh_topology__<policy__<false>>;
+using compact_mesh_t = mesh_topology__<policy__<true>>;
+using fixed_mesh_t = mesh_topology__<policy__<false, true>>;
+using compact_fixed_mesh_t = mesh_topology__<policy__<true, true>>;
+
+// The vertices of the cells, the cells of the vertices and the cells of
+// the cells, which are computed through the cells of the vertices.
+struct lazy_policy_t {
+  flecsi_register_number_dimensions(2);
+  flecsi_register_number_domains(1);
+
+  flecsi_register_entity_types(
+    flecsi_entity_type(0, 0, vertex_t),
+    flecsi_entity_type(1, 0, edge_t),
+    flecsi_entity_type(2, 0, cell_t));
+
+  flecsi_register_connectivities(
+    flecsi_connectivity(3, 0, cell_t, vertex_t),
+    flecsi_connectivity(4, 0, vertex_t, cell_t),
+    flecsi_connectivity(5, 0, cell_t, cell_t));
+
+  flecsi_register_bindings();
+
+  template<size_t M, size_t D, typename ST>
+  static mesh_entity_base__<num_domains> *
+  create_entity(mesh_topology_base__<ST> * mesh, size_t num_vertices,
+    utils::id_t const & id) {
+    return mesh->template make<edge_t>(id);
+  } // create_entity
+}; // struct lazy_policy_t
+
+using lazy_mesh_t = mesh_topology__<lazy_policy_t>;
+
+// A mesh of N x N cells with its own storage. The cells are created,
+// but the adjacencies are not computed.
+template<typename MESH>
+struct test_mesh__ {
+  typename MESH::storage_t storage;
+  std::vector<std::vector<char>> buffers;
+  std::unique_ptr<MESH> mesh;
+
+  test_mesh__() {
+    const size_t capacities[] = {num_vertices, num_edges, num_cells};
+    const size_t sizes[] = {sizeof(vertex_t), sizeof(edge_t), sizeof(cell_t)};
+
+    // Every connectivity fits into the offsets and ids of the edges with
+    // up to 16 neighbors.
+    const size_t num_offsets = 8 * num_edges;
+    const size_t num_ids = 16 * num_edges;
+
+    for (size_t d = 0; d < 3; ++d) {
+      storage.init_entities(0, d,
+        buffer<mesh_entity_base_>(capacities[d] * sizes[d]),
+        buffer<utils::id_t>(capacities[d] * sizeof(utils::id_t)), 0,
+        capacities[d], 0, 0, 0, false);
+    } // for
+
+    for (size_t from = 0; from < 3; ++from) {
+      for (size_t to = 0; to < 3; ++to) {
+        storage.init_connectivity(0, 0, from, to,
+          buffer<utils::offset_t>(num_offsets * sizeof(utils::offset_t)),
+          num_offsets, buffer<utils::id_t>(num_ids * sizeof(utils::id_t)),
+          num_ids, false);
+      } // for
+    } // for
+
+    mesh.reset(new MESH(&storage));
+
+    std::vector<vertex_t *> vertices;
+
+    for (size_t j = 0; j <= N; ++j) {
+      for (size_t i = 0; i <= N; ++i) {
+        vertices.push_back(mesh->template make<vertex_t>(
+          supplemental::point_t{{double(i), double(j)}}));
+      } // for
+    } // for
+
+    for (size_t j = 0; j < N; ++j) {
+      for (size_t i = 0; i < N; ++i) {
+        const size_t v = j * (N + 1) + i;
+        auto c = mesh->template make<cell_t>();
+        mesh->template init_cell<0>(c, {vertices[v], vertices[v + 1],
+          vertices[v + N + 1], vertices[v + N + 2]});
+      } // for
+    } // for
+  } // test_mesh__
+
+  template<typename T>
+  T * buffer(size_t bytes) {
+    buffers.emplace_back(bytes);
+    return reinterpret_cast<T *>(buffers.back().data());
+  } // buffer
+}; // struct test_mesh__
+
+// The entity ids of each row of a connectivity.
+template<typename MESH>
+std::vector<std::vector<size_t>>
+connectivity_ids(MESH & mesh, size_t from_dim, size_t to_dim) {
+  auto & c = mesh.get_connectivity(0, 0, from_dim, to_dim);
+  std::vector<std::vector<size_t>> rows;
+
+  for (size_t i = 0; i < c.from_size(); ++i) {
+    size_t count;
+    auto ids = c.get_entities(i, count);
+
+    std::vector<size_t> row;
+
+    for (size_t k = 0; k < count; ++k) {
+      row.push_back(ids[k].entity());
+    } // for
+
+    rows.push_back(row);
+  } // for
+
+  return rows;
+} // connectivity_ids
+
+// The ids of the entities adjacent to each entity of dimension FROM, as
+// returned by entities().
+template<size_t FROM, size_t TO, typename MESH>
+std::vector<std::vector<size_t>>
+adjacent_entities(MESH & mesh) {
+  std::vector<std::vector<size_t>> rows;
+
+  for (auto e: mesh.template entities<FROM, 0>()) {
+    std::vector<size_t> row;
+
+    for (auto a: mesh.template entities<TO, 0>(e.entity())) {
+      row.push_back(a->template id<0>());
+    } // for
+
+    rows.push_back(row);
+  } // for
+
+  return rows;
+} // adjacent_entities
+
+// The ids of the entities adjacent to each entity of dimension FROM, as
+// returned by entity_ids().
+template<size_t FROM, size_t TO, typename MESH>
+std::vector<std::vector<size_t>>
+adjacent_ids(MESH & mesh) {
+  std::vector<std::vector<size_t>> rows;
+
+  for (auto e: mesh.template entities<FROM, 0>()) {
+    std::vector<size_t> row;
+
+    for (auto id: mesh.template entity_ids<TO, 0>(e.entity())) {
+      row.push_back(id.entity());
+    } // for
+
+    rows.push_back(row);
+  } // for
+
+  return rows;
+} // adjacent_ids
+
+// Check that two meshes give the same entities and entity ids.
+template<size_t FROM, size_t TO, typename MESH_A, typename MESH_B>
+void
+check_same(MESH_A & a, MESH_B & b) {
+  ASSERT_EQ((adjacent_entities<FROM, TO>(a)), (adjacent_entities<FROM, TO>(b)))
+    << FROM << " -> " << TO;
+  ASSERT_EQ((adjacent_ids<FROM, TO>(a)), (adjacent_ids<FROM, TO>(b)))
+    << FROM << " -> " << TO;
+} // check_same
+
+// Check that a compacted connectivity gives the same entities as the
+// full ids.
+template<size_t FROM, size_t TO>
+void
+check_compact(mesh_t & mesh, compact_mesh_t & compact) {
+  ASSERT_FALSE(mesh.get_connectivity(0, 0, FROM, TO).compacted());
+  ASSERT_TRUE(compact.get_connectivity(0, 0, FROM, TO).compacted());
+
+  check_same<FROM, TO>(compact, mesh);
+} // check_compact
+
+// Check that the local ids of a compacted connectivity match its full ids.
+void
+check_local_ids(const connectivity_t & c) {
+  const utils::id_t * ids = c.get_index_space().id_array();
+  const std::uint32_t * local_ids = c.local_id_array();
+
+  ASSERT_NE(local_ids, nullptr);
+
+  for (size_t i = 0; i < c.to_size(); ++i) {
+    ASSERT_EQ(local_ids[i], ids[i].entity()) << "index " << i;
+  } // for
+} // check_local_ids
+
+// The entities are numbered in creation order in the index maps.
+void
+add_index_maps() {
+  auto & context = execution::context_t::instance();
+  const size_t sizes[] = {num_vertices, num_edges, num_cells};
+
+  for (size_t d = 0; d < 3; ++d) {
+    std::vector<size_t> index_map(sizes[d]);
+
+    for (size_t i = 0; i < sizes[d]; ++i) {
+      index_map[i] = i;
+    } // for
+
+    context.add_index_map(d, index_map);
+  } // for
+} // add_index_maps
+
+TEST(mesh_connectivity, thread_pool) {
+  add_index_maps();
+
+  test_mesh__<mesh_t> serial;
+  serial.mesh->init<0>();
+
+  ASSERT_EQ(serial.mesh->num_entities(1), num_edges);
+
+  // The connectivities do not depend on the number of threads.
+  for (size_t threads: {2, 3, 4}) {
+    kernel_pool pool(threads);
+
+    test_mesh__<mesh_t> pooled;
+    pooled.mesh->init<0>(&pool);
+
+    for (size_t from = 0; from < 3; ++from) {
+      for (size_t to = 0; to < 3; ++to) {
+        ASSERT_EQ(connectivity_ids(*pooled.mesh, from, to),
+          connectivity_ids(*serial.mesh, from, to))
+          << threads << " threads, " << from << " -> " << to;
+      } // for
+    } // for
+  } // for
+} // TEST
+
+TEST(mesh_connectivity, compact) {
+  add_index_maps();
+
+  test_mesh__<mesh_t> full;
+  full.mesh->init<0>();
+
+  test_mesh__<compact_mesh_t> compact;
+  compact.mesh->init<0>();
+
+  check_compact<0, 0>(*full.mesh, *compact.mesh);
+  check_compact<0, 1>(*full.mesh, *compact.mesh);
+  check_compact<0, 2>(*full.mesh, *compact.mesh);
+  check_compact<1, 0>(*full.mesh, *compact.mesh);
+  check_compact<1, 1>(*full.mesh, *compact.mesh);
+  check_compact<1, 2>(*full.mesh, *compact.mesh);
+  check_compact<2, 0>(*full.mesh, *compact.mesh);
+  check_compact<2, 1>(*full.mesh, *compact.mesh);
+  check_compact<2, 2>(*full.mesh, *compact.mesh);
+} // TEST
+
+TEST(mesh_connectivity, compact_updates) {
+  add_index_maps();
+
+  test_mesh__<compact_mesh_t> compact;
+  auto & mesh = *compact.mesh;
+  mesh.init<0>();
+
+  std::vector<cell_t *> cells;
+
+  for (auto e: mesh.entities<2, 0>()) {
+    cells.push_back(e.entity());
+  } // for
+
+  auto & c = mesh.get_connectivity(0, 0, 2, 0);
+  const utils::id_t * ids = c.get_index_space().id_array();
+
+  check_local_ids(c);
+
+  // Each update of the full ids updates the local ids.
+  c.set(0, ids[c.to_size() - 1], 1);
+  check_local_ids(c);
+  ASSERT_EQ(mesh.entity_ids<0>(cells[0])[1].entity(),
+    ids[c.to_size() - 1].entity());
+
+  c.reverse_entities(1);
+  check_local_ids(c);
+
+  mesh.reverse_entities<0, 0>(cells[2]);
+  check_local_ids(c);
+
+  c.reorder_entities(3, std::vector<size_t>{2, 0, 3, 1});
+  check_local_ids(c);
+
+  const size_t from_size = c.from_size();
+  c.push(ids[0]);
+  c.push(ids[1]);
+  c.end_from();
+
+  ASSERT_EQ(c.from_size(), from_size + 1);
+  check_local_ids(c);
+
+  // The cells see the updated connectivity.
+  auto rows = connectivity_ids(mesh, 2, 0);
+  rows.pop_back();
+
+  ASSERT_EQ((adjacent_ids<2, 0>(mesh)), rows);
+} // TEST
+
+TEST(mesh_connectivity, fixed_arity) {
+  add_index_maps();
+
+  test_mesh__<mesh_t> offsets;
+  offsets.mesh->init<0>();
+
+  test_mesh__<fixed_mesh_t> fixed;
+  fixed.mesh->init<0>();
+
+  test_mesh__<compact_fixed_mesh_t> compact_fixed;
+  compact_fixed.mesh->init<0>();
+
+  // The fixed arity connectivities are laid out as fixed_range expects.
+  ASSERT_TRUE(fixed.mesh->get_connectivity(0, 0, 2, 0).has_arity(4));
+  ASSERT_TRUE(fixed.mesh->get_connectivity(0, 0, 2, 1).has_arity(4));
+  ASSERT_TRUE(fixed.mesh->get_connectivity(0, 0, 1, 0).has_arity(2));
+
+  // The ranges located from the index alone match those of the offsets.
+  check_same<2, 0>(*fixed.mesh, *offsets.mesh);
+  check_same<2, 1>(*fixed.mesh, *offsets.mesh);
+  check_same<1, 0>(*fixed.mesh, *offsets.mesh);
+
+  check_same<2, 0>(*compact_fixed.mesh, *offsets.mesh);
+  check_same<2, 1>(*compact_fixed.mesh, *offsets.mesh);
+  check_same<1, 0>(*compact_fixed.mesh, *offsets.mesh);
+
+  // The other connectivities still use the offsets.
+  check_same<0, 2>(*fixed.mesh, *offsets.mesh);
+  check_same<1, 1>(*fixed.mesh, *offsets.mesh);
+} // TEST
+
+TEST(mesh_connectivity, lazy) {
+  add_index_maps();
+
+  test_mesh__<lazy_mesh_t> eager;
+  eager.mesh->init<0>();
+
+  test_mesh__<lazy_mesh_t> lazy;
+  lazy.mesh->init_lazy<0>();
+
+  // The cells of the cells are computed first, which computes the cells
+  // of the vertices, which are deferred too, on the way.
+  ASSERT_EQ((adjacent_entities<2, 2>(*lazy.mesh)),
+    (adjacent_entities<2, 2>(*eager.mesh)));
+  ASSERT_EQ((adjacent_ids<0, 2>(*lazy.mesh)),
+    (adjacent_ids<0, 2>(*eager.mesh)));
+  ASSERT_EQ((adjacent_ids<2, 0>(*lazy.mesh)),
+    (adjacent_ids<2, 0>(*eager.mesh)));
+
+  // The freed connectivities are computed again on their next use.
+  lazy.mesh->free_connectivity(0, 0, 2);
+  lazy.mesh->free_connectivity(0, 2, 2);
+
+  for (size_t from = 0; from < 3; from += 2) {
+    for (size_t to = 0; to < 3; to += 2) {
+      if (from == 0 && to == 0) {
+        continue;
+      } // if
+
+      ASSERT_EQ(connectivity_ids(*lazy.mesh, from, to),
+        connectivity_ids(*eager.mesh, from, to))
+        << from << " -> " << to;
+    } // for
+  } // for
+} // TEST
+
+namespace flecsi {
+namespace execution {
+
+// The tests run after the runtime driver.
+void driver(int argc, char ** argv) {}
+
+} // namespace execution
+} // namespace flecsi
+
+/*~------------------------------------------------------------------------~--*
+ * Formatting options for vim.
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~------------------------------------------------------------------------~--*/
@@ -15,9 +15,14 @@
 
 /*! @file */
 
+#include <algorithm>
+#include <cstddef>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <flecsi/utils/common.h>
+#include <flecsi/utils/hash.h>
 #include <flecsi/utils/id.h>
 
 namespace flecsi {
@@ -47,6 +52,9 @@ using index_space_ = typeify<size_t, IS>;
 template<size_t ISS>
 using index_subspace_ = typeify<size_t, ISS>;
 
+template<size_t ARITY>
+using arity_ = typeify<size_t, ARITY>;
+
 /*----------------------------------------------------------------------------*
  * Simple types
  *----------------------------------------------------------------------------*/
@@ -54,12 +62,18 @@ using index_subspace_ = typeify<size_t, ISS>;
 using id_vector_t = std::vector<utils::id_t>;
 using connection_vector_t = std::vector<id_vector_t>;
 
+// the part of an id that is compared by its equality operator
+inline size_t
+id_hash_key(const utils::id_t & id) {
+  return static_cast<size_t>(id.local_id()) & utils::id_t::FLAGS_UNMASK;
+} // id_hash_key
+
 // hash use for mapping in building topology connectivity
 struct id_vector_hash_t {
   size_t operator()(const id_vector_t & v) const {
-    size_t h = 0;
+    size_t h = v.size();
     for (utils::id_t id : v) {
-      h |= static_cast<size_t>(id.local_id());
+      h = utils::hash::mix(h ^ id_hash_key(id));
     } // for
 
     return h;
@@ -71,6 +85,140 @@ struct id_vector_hash_t {
 using id_vector_map_t =
     std::unordered_map<id_vector_t, utils::id_t, id_vector_hash_t>;
 
+/*!
+  A map from the vertices of an entity to its id, used to create each
+  entity only once when building the topology connectivities. The keys
+  of up to N vertices are stored inline in an open-addressing table with
+  linear probing, so that an insertion does not allocate memory, besides
+  the growth of the table. The longer keys are stored in an
+  id_vector_map_t.
+
+  @tparam N The maximum number of vertices of the inline keys.
+ */
+
+template<size_t N>
+class id_key_map__ {
+public:
+  using id_t = utils::id_t;
+
+  /*!
+    Insert the id of an entity, unless an entity with the same vertices
+    was already inserted.
+
+    @param vertices The vertices of the entity, in any order.
+    @param count    The number of vertices.
+    @param id       The id of the entity.
+
+    @return The id of the entity with these vertices, and true if it
+            was inserted.
+   */
+
+  std::pair<id_t, bool>
+  emplace(const id_t * vertices, size_t count, const id_t & id) {
+    if (count == 0 || count > N) {
+      id_vector_t key(vertices, vertices + count);
+      std::sort(key.begin(), key.end());
+
+      auto itr = overflow_.emplace(std::move(key), id);
+      return {itr.first->second, itr.second};
+    } // if
+
+    if (2 * (size_ + 1) > slots_.size()) {
+      rehash(std::max<size_t>(2 * slots_.size(), 16));
+    } // if
+
+    slot_t entry;
+    std::copy(vertices, vertices + count, entry.key);
+    std::sort(entry.key, entry.key + count);
+    entry.count = count;
+
+    const size_t mask = slots_.size() - 1;
+
+    for (size_t s = hash(entry) & mask;; s = (s + 1) & mask) {
+      slot_t & slot = slots_[s];
+
+      if (slot.count == 0) {
+        entry.value = id;
+        slot = entry;
+        ++size_;
+        return {id, true};
+      } // if
+
+      if (slot.count == count &&
+          std::equal(entry.key, entry.key + count, slot.key)) {
+        return {slot.value, false};
+      } // if
+    } // for
+  } // emplace
+
+  /*!
+    Reserve the space for a number of inline keys, so that the table is
+    not grown while they are inserted.
+   */
+
+  void reserve(size_t count) {
+    size_t capacity(16);
+
+    while (capacity < 2 * count) {
+      capacity *= 2;
+    } // while
+
+    if (capacity > slots_.size()) {
+      rehash(capacity);
+    } // if
+  } // reserve
+
+  /*!
+    Return the number of entities.
+   */
+
+  size_t size() const {
+    return size_ + overflow_.size();
+  } // size
+
+private:
+  // A slot of the table, which is empty if its count is zero.
+  struct slot_t {
+    id_t key[N];
+    id_t value;
+    size_t count = 0;
+  }; // struct slot_t
+
+  static size_t hash(const slot_t & slot) {
+    size_t h = slot.count;
+
+    for (size_t i(0); i < slot.count; ++i) {
+      h = utils::hash::mix(h ^ id_hash_key(slot.key[i]));
+    } // for
+
+    return h;
+  } // hash
+
+  // The capacity must be a power of two.
+  void rehash(size_t capacity) {
+    std::vector<slot_t> slots(capacity);
+    const size_t mask = capacity - 1;
+
+    for (auto & slot : slots_) {
+      if (slot.count) {
+        size_t s = hash(slot) & mask;
+
+        while (slots[s].count) {
+          s = (s + 1) & mask;
+        } // while
+
+        slots[s] = slot;
+      } // if
+    } // for
+
+    slots_.swap(slots);
+  } // rehash
+
+  std::vector<slot_t> slots_;
+  size_t size_ = 0;
+  id_vector_map_t overflow_;
+}; // class id_key_map__
+
 // the second topology vector holds the offsets into to from dimension
 using index_vector_t = std::vector<size_t>;
 
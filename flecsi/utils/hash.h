@@ -362,6 +362,26 @@ intermediate_hash(size_t dimension, size_t domain) {
   return (dimension << 32) ^ domain;
 } // intermediate_hash
 
+////////////////////////////////////////////////////////////////////////////////
+// General hash interface.
+////////////////////////////////////////////////////////////////////////////////
+
+//----------------------------------------------------------------------------//
+//! Spread the bits of a key, so that keys that differ in a few bits
+//! have unrelated hashes. This is the finalizer of splitmix64.
+//!
+//! @param key The key.
+//!
+//! @ingroup utils
+//----------------------------------------------------------------------------//
+
+inline constexpr size_t
+mix(size_t key) {
+  key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull;
+  key = (key ^ (key >> 27)) * 0x94d049bb133111ebull;
+  return key ^ (key >> 31);
+} // mix
+
 } // namespace hash
 
 //----------------------------------------------------------------------------//
@@ -0,0 +1,260 @@
+/*
+    @@@@@@@@  @@           @@@@@@   @@@@@@@@ @@
+   /@@/////  /@@          @@////@@ @@////// /@@
+   /@@       /@@  @@@@@  @@    // /@@       /@@
+   /@@@@@@@  /@@ @@///@@/@@       /@@@@@@@@@/@@
+   /@@////   /@@/@@@@@@@/@@       ////////@@/@@
+   /@@       /@@/@@//// //@@    @@       /@@/@@
+   /@@       @@@//@@@@@@ //@@@@@@  @@@@@@@@ /@@
+   //       ///  //////   //////  ////////  //
+
+   Copyright (c) 2016, Los Alamos National Security, LLC
+   All rights reserved.
+                                                                              */
+#pragma once
+
+/*! @file */
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace flecsi {
+namespace utils {
+
+//!
+//! \brief Map from the dense range of keys [0, n) to values, e.g., from
+//!        local to global ids.
+//!
+//! The entries are stored contiguously and are indexed by key. The
+//! interface follows std::map<size_t, size_t>, so that the entries are
+//! iterated in key order as key/value pairs. The keys of the entries
+//! must not be modified through the iterators.
+//!
+class dense_index_map_t
+{
+public:
+
+  using key_type = size_t;
+  using mapped_type = size_t;
+  using value_type = std::pair<size_t, size_t>;
+  using size_type = size_t;
+  using storage_t = std::vector<value_type>;
+  using iterator = storage_t::iterator;
+  using const_iterator = storage_t::const_iterator;
+
+  dense_index_map_t() = default;
+
+  //!
+  //! \brief Construct from a map whose keys are the range [0, n).
+  //!
+  dense_index_map_t(const std::map<size_t, size_t> & map) {
+    entries_.reserve(map.size());
+
+    for (auto & entry : map) {
+      if (entry.first != entries_.size()) {
+        throw std::invalid_argument("dense_index_map_t: keys are not dense");
+      }
+
+      entries_.emplace_back(entry);
+    }
+  }
+
+  //!
+  //! \brief Construct from the values of the keys [0, values.size()).
+  //!
+  dense_index_map_t(const std::vector<size_t> & values) {
+    entries_.reserve(values.size());
+
+    for (size_t i(0); i < values.size(); ++i) {
+      entries_.emplace_back(i, values[i]);
+    }
+  }
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
+
+  size_type size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+
+  void clear() { entries_.clear(); }
+  void reserve(size_type n) { entries_.reserve(n); }
+
+  //!
+  //! \brief Return the value of a key. Keys beyond the end are added
+  //!        with the value zero, along with the keys in between.
+  //!
+  mapped_type & operator[](key_type key) {
+    while (entries_.size() <= key) {
+      entries_.emplace_back(entries_.size(), 0);
+    }
+
+    return entries_[key].second;
+  }
+
+  mapped_type & at(key_type key) {
+    if (key >= entries_.size()) {
+      throw std::out_of_range("dense_index_map_t::at");
+    }
+
+    return entries_[key].second;
+  }
+
+  const mapped_type & at(key_type key) const {
+    if (key >= entries_.size()) {
+      throw std::out_of_range("dense_index_map_t::at");
+    }
+
+    return entries_[key].second;
+  }
+
+  iterator find(key_type key) {
+    return key < entries_.size() ? begin() + key : end();
+  }
+
+  const_iterator find(key_type key) const {
+    return key < entries_.size() ? begin() + key : end();
+  }
+
+  size_type count(key_type key) const {
+    return key < entries_.size() ? 1 : 0;
+  }
+
+  operator std::map<size_t, size_t>() const {
+    return std::map<size_t, size_t>(entries_.begin(), entries_.end());
+  }
+
+private:
+
+  storage_t entries_;
+
+}; // class dense_index_map_t
+
+//!
+//! \brief Map from sparse keys to values, e.g., from global to local ids.
+//!
+//! The entries are stored contiguously in key order and are looked up by
+//! binary search. The interface follows std::map<size_t, size_t>. The
+//! keys of the entries must not be modified through the iterators.
+//! Inserting keys in increasing order is amortized constant time.
+//!
+class sorted_index_map_t
+{
+public:
+
+  using key_type = size_t;
+  using mapped_type = size_t;
+  using value_type = std::pair<size_t, size_t>;
+  using size_type = size_t;
+  using storage_t = std::vector<value_type>;
+  using iterator = storage_t::iterator;
+  using const_iterator = storage_t::const_iterator;
+
+  sorted_index_map_t() = default;
+
+  sorted_index_map_t(const std::map<size_t, size_t> & map)
+    : entries_(map.begin(), map.end()) {}
+
+  //!
+  //! \brief Construct from unordered entries with unique keys.
+  //!
+  sorted_index_map_t(storage_t && entries) : entries_(std::move(entries)) {
+    std::sort(entries_.begin(), entries_.end(), compare_);
+  }
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
+
+  size_type size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+
+  void clear() { entries_.clear(); }
+  void reserve(size_type n) { entries_.reserve(n); }
+
+  std::pair<iterator, bool> insert(const value_type & value) {
+    if (entries_.empty() || entries_.back().first < value.first) {
+      entries_.push_back(value);
+      return {end() - 1, true};
+    }
+
+    auto it = lower_bound_(value.first);
+
+    if (it != entries_.end() && it->first == value.first) {
+      return {it, false};
+    }
+
+    return {entries_.insert(it, value), true};
+  }
+
+  mapped_type & operator[](key_type key) {
+    return insert({key, 0}).first->second;
+  }
+
+  mapped_type & at(key_type key) {
+    auto it = find(key);
+
+    if (it == end()) {
+      throw std::out_of_range("sorted_index_map_t::at");
+    }
+
+    return it->second;
+  }
+
+  const mapped_type & at(key_type key) const {
+    auto it = find(key);
+
+    if (it == end()) {
+      throw std::out_of_range("sorted_index_map_t::at");
+    }
+
+    return it->second;
+  }
+
+  iterator find(key_type key) {
+    auto it = lower_bound_(key);
+    return it != entries_.end() && it->first == key ? it : end();
+  }
+
+  const_iterator find(key_type key) const {
+    auto it = std::lower_bound(entries_.begin(), entries_.end(),
+      value_type(key, 0), compare_);
+    return it != entries_.end() && it->first == key ? it : end();
+  }
+
+  size_type count(key_type key) const {
+    return find(key) != end() ? 1 : 0;
+  }
+
+  operator std::map<size_t, size_t>() const {
+    return std::map<size_t, size_t>(entries_.begin(), entries_.end());
+  }
+
+private:
+
+  static bool compare_(const value_type & a, const value_type & b) {
+    return a.first < b.first;
+  }
+
+  iterator lower_bound_(key_type key) {
+    return std::lower_bound(entries_.begin(), entries_.end(),
+      value_type(key, 0), compare_);
+  }
+
+  storage_t entries_;
+
+}; // class sorted_index_map_t
+
+} // namespace utils
+} // namespace flecsi
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/
@@ -0,0 +1,104 @@
+/*~-------------------------------------------------------------------------~~*
+ * Copyright (c) 2017 Los Alamos National Security, LLC
+ * All rights reserved
+ *~-------------------------------------------------------------------------~~*/
+
+// includes: flecsi
+#include <flecsi/utils/index_map.h>
+
+// includes: other
+#include <cinchtest.h>
+
+using flecsi::utils::dense_index_map_t;
+using flecsi::utils::sorted_index_map_t;
+
+using map_t = std::map<size_t, size_t>;
+
+// =============================================================================
+// Test flecsi::utils::dense_index_map_t
+// =============================================================================
+
+// TEST
+TEST(index_map, dense) {
+  map_t reference = {{0, 40}, {1, 10}, {2, 30}};
+
+  dense_index_map_t a(reference);
+  dense_index_map_t b(std::vector<size_t>{40, 10, 30});
+
+  EXPECT_EQ(a.size(), 3);
+  EXPECT_EQ(map_t(a), reference);
+  EXPECT_EQ(map_t(b), reference);
+
+  EXPECT_EQ(a[1], 10);
+  EXPECT_EQ(a.at(2), 30);
+  EXPECT_THROW(a.at(3), std::out_of_range);
+  EXPECT_EQ(a.find(0)->second, 40);
+  EXPECT_TRUE(a.find(3) == a.end());
+  EXPECT_EQ(a.count(2), 1);
+  EXPECT_EQ(a.count(3), 0);
+
+  // Iteration is in key order.
+  size_t key = 0;
+  for (auto & entry : a) {
+    EXPECT_EQ(entry.first, key++);
+    EXPECT_EQ(entry.second, reference[entry.first]);
+  }
+
+  // New keys are appended.
+  a[4] = 50;
+  EXPECT_EQ(a.size(), 5);
+  EXPECT_EQ(a.at(3), 0);
+  EXPECT_EQ(a.at(4), 50);
+
+  map_t sparse = {{0, 1}, {2, 3}};
+  EXPECT_THROW(dense_index_map_t{sparse}, std::invalid_argument);
+} // TEST
+
+// =============================================================================
+// Test flecsi::utils::sorted_index_map_t
+// =============================================================================
+
+// TEST
+TEST(index_map, sorted) {
+  map_t reference = {{10, 1}, {30, 2}, {40, 0}};
+
+  sorted_index_map_t a(reference);
+  sorted_index_map_t b(sorted_index_map_t::storage_t{{40, 0}, {10, 1},
+    {30, 2}});
+
+  EXPECT_EQ(map_t(a), reference);
+  EXPECT_EQ(map_t(b), reference);
+
+  EXPECT_EQ(b.at(40), 0);
+  EXPECT_EQ(b[10], 1);
+  EXPECT_THROW(b.at(20), std::out_of_range);
+  EXPECT_TRUE(b.find(20) == b.end());
+  EXPECT_EQ(b.find(30)->second, 2);
+  EXPECT_EQ(b.count(30), 1);
+  EXPECT_EQ(b.count(31), 0);
+
+  // Keys are inserted in order.
+  b[20] = 3;
+  b[50] = 4;
+  b[5] = 5;
+  reference[20] = 3;
+  reference[50] = 4;
+  reference[5] = 5;
+
+  EXPECT_EQ(b.size(), 6);
+  EXPECT_EQ(map_t(b), reference);
+  EXPECT_FALSE(b.insert({20, 7}).second);
+  EXPECT_EQ(b.at(20), 3);
+
+  auto ref = reference.begin();
+  for (auto & entry : b) {
+    EXPECT_EQ(entry.first, ref->first);
+    EXPECT_EQ(entry.second, ref->second);
+    ++ref;
+  }
+} // TEST
+
+/*~-------------------------------------------------------------------------~-*
+ * Formatting options
+ * vim: set tabstop=2 shiftwidth=2 expandtab :
+ *~-------------------------------------------------------------------------~-*/